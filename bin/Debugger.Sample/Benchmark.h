@@ -0,0 +1,310 @@
+#pragma once
+
+#include "DebugProtocolHandler.h"
+#include "ErrorHelpers.h"
+
+#include <ChakraCore.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+//
+// Measures what debugging costs a running script. Each workload in the
+// script's `benchmarks` object is timed in a fresh runtime for every
+// configuration, and the results are reported relative to running without a
+// protocol handler.
+//
+class Benchmark
+{
+public:
+    enum class Configuration
+    {
+        NoHandler,
+        Handler,
+        ClientIdle,
+        ClientBreakpoints,
+        Count
+    };
+
+private:
+    static const size_t c_ConfigurationCount = static_cast<size_t>(Configuration::Count);
+    static const int c_WarmupCalls = 20;
+
+    struct Result
+    {
+        double loadMilliseconds;
+        std::vector<std::wstring> names;
+        std::vector<double> callsPerSecond;
+    };
+
+    const std::wstring& m_script;
+    std::wstring m_scriptPath;
+    std::chrono::milliseconds m_duration;
+    std::vector<int> m_coldLines;
+    std::atomic<size_t> m_resolvedBreakpoints{ 0 };
+
+    static const wchar_t* GetName(Configuration configuration)
+    {
+        switch (configuration)
+        {
+        case Configuration::NoHandler:
+            return L"no handler";
+        case Configuration::Handler:
+            return L"handler";
+        case Configuration::ClientIdle:
+            return L"client idle";
+        case Configuration::ClientBreakpoints:
+            return L"breakpoints";
+        default:
+            return L"";
+        }
+    }
+
+    static void CHAKRA_CALLBACK SendResponse(const char* response, void* callbackState)
+    {
+        auto benchmark = static_cast<Benchmark*>(callbackState);
+
+        // Responses are otherwise ignored, but counting resolved breakpoints
+        // shows the last configuration really had them set.
+        if (strstr(response, "\"Debugger.breakpointResolved\"") != nullptr)
+        {
+            ++benchmark->m_resolvedBreakpoints;
+        }
+    }
+
+    JsErrorCode Attach(DebugProtocolHandler& protocolHandler, Configuration configuration)
+    {
+        IfFailRet(protocolHandler.Connect(false, &Benchmark::SendResponse, this));
+        IfFailRet(protocolHandler.SendCommand("{\"id\":1,\"method\":\"Runtime.enable\"}"));
+        IfFailRet(protocolHandler.SendCommand("{\"id\":2,\"method\":\"Debugger.enable\"}"));
+
+        if (configuration == Configuration::ClientBreakpoints)
+        {
+            int id = 3;
+
+            // Only the benchmark script runs in this runtime, so any URL matches.
+            for (int line : m_coldLines)
+            {
+                std::string command = "{\"id\":" + std::to_string(id++) +
+                    ",\"method\":\"Debugger.setBreakpointByUrl\",\"params\":{\"lineNumber\":" + std::to_string(line) +
+                    ",\"urlRegex\":\".*\"}}";
+
+                IfFailRet(protocolHandler.SendCommand(command.c_str()));
+            }
+        }
+
+        // Handle the commands now, so they are in place before the script loads.
+        return protocolHandler.ProcessCommandQueue();
+    }
+
+    JsErrorCode TimeWorkload(JsValueRef function, JsValueRef thisArg, double* callsPerSecond)
+    {
+        JsValueRef result = JS_INVALID_REFERENCE;
+
+        // Let the JIT settle before anything is timed.
+        for (int index = 0; index < c_WarmupCalls; ++index)
+        {
+            IfFailRet(JsCallFunction(function, &thisArg, 1, &result));
+        }
+
+        uint64_t calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration elapsed;
+
+        do
+        {
+            IfFailRet(JsCallFunction(function, &thisArg, 1, &result));
+            ++calls;
+
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < m_duration);
+
+        *callsPerSecond = calls / std::chrono::duration<double>(elapsed).count();
+        return JsNoError;
+    }
+
+    JsErrorCode RunInRuntime(JsRuntimeHandle runtime, Configuration configuration, Result& result)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        IfFailRet(JsCreateContext(runtime, &context));
+        IfFailRet(JsSetCurrentContext(context));
+
+        std::unique_ptr<DebugProtocolHandler> protocolHandler;
+        if (configuration != Configuration::NoHandler)
+        {
+            protocolHandler = std::make_unique<DebugProtocolHandler>(runtime);
+        }
+
+        if (configuration == Configuration::ClientIdle || configuration == Configuration::ClientBreakpoints)
+        {
+            IfFailRet(Attach(*protocolHandler, configuration));
+        }
+
+        // Loading is timed too, since that is where source events are handled.
+        JsValueRef scriptResult = JS_INVALID_REFERENCE;
+        auto loadStart = std::chrono::steady_clock::now();
+        IfFailRet(JsRunScript(m_script.c_str(), 0, m_scriptPath.c_str(), &scriptResult));
+        result.loadMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+        JsValueRef globalObject = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetGlobalObject(&globalObject));
+
+        JsPropertyIdRef benchmarksName = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetPropertyIdFromName(L"benchmarks", &benchmarksName));
+
+        JsValueRef benchmarks = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetProperty(globalObject, benchmarksName, &benchmarks));
+
+        JsValueRef names = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetOwnPropertyNames(benchmarks, &names));
+
+        JsPropertyIdRef lengthName = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetPropertyIdFromName(L"length", &lengthName));
+
+        JsValueRef lengthValue = JS_INVALID_REFERENCE;
+        int length = 0;
+        IfFailRet(JsGetProperty(names, lengthName, &lengthValue));
+        IfFailRet(JsNumberToInt(lengthValue, &length));
+
+        for (int index = 0; index < length; ++index)
+        {
+            JsValueRef indexValue = JS_INVALID_REFERENCE;
+            IfFailRet(JsIntToNumber(index, &indexValue));
+
+            JsValueRef name = JS_INVALID_REFERENCE;
+            IfFailRet(JsGetIndexedProperty(names, indexValue, &name));
+
+            const wchar_t* nameString = nullptr;
+            size_t nameLength = 0;
+            IfFailRet(JsStringToPointer(name, &nameString, &nameLength));
+
+            JsValueRef function = JS_INVALID_REFERENCE;
+            IfFailRet(JsGetIndexedProperty(benchmarks, name, &function));
+
+            double callsPerSecond = 0;
+            IfFailRet(TimeWorkload(function, benchmarks, &callsPerSecond));
+
+            result.names.emplace_back(nameString, nameLength);
+            result.callsPerSecond.push_back(callsPerSecond);
+        }
+
+        if (protocolHandler && configuration != Configuration::Handler)
+        {
+            IfFailRet(protocolHandler->Disconnect());
+        }
+
+        if (protocolHandler)
+        {
+            IfFailRet(protocolHandler->Destroy());
+        }
+
+        return JsNoError;
+    }
+
+    JsErrorCode RunConfiguration(Configuration configuration, Result& result)
+    {
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        IfFailRet(JsCreateRuntime(JsRuntimeAttributeDispatchSetExceptionsToDebugger, nullptr, &runtime));
+
+        JsErrorCode errorCode = RunInRuntime(runtime, configuration, result);
+
+        JsSetCurrentContext(JS_INVALID_REFERENCE);
+        JsDisposeRuntime(runtime);
+
+        return errorCode;
+    }
+
+    static void PrintCell(double value, double baseline, bool isBaseline)
+    {
+        if (isBaseline || baseline == 0)
+        {
+            wprintf(L" %20.1f", value);
+        }
+        else
+        {
+            wprintf(L" %11.1f (%+5.1f%%)", value, (value - baseline) / baseline * 100.0);
+        }
+    }
+
+public:
+    // Breakpoints go on every line of the script marked with a `// cold`
+    // comment, which the workloads must never run.
+    Benchmark(const std::wstring& script, std::wstring const& scriptPath, std::chrono::milliseconds duration)
+        : m_script(script)
+        , m_scriptPath(scriptPath)
+        , m_duration(duration)
+    {
+        int line = 0;
+        size_t lineStart = 0;
+
+        while (lineStart < m_script.length())
+        {
+            size_t lineEnd = m_script.find(L'\n', lineStart);
+            if (lineEnd == std::wstring::npos)
+            {
+                lineEnd = m_script.length();
+            }
+
+            size_t marker = m_script.find(L"// cold", lineStart);
+            if (marker != std::wstring::npos && marker < lineEnd)
+            {
+                m_coldLines.push_back(line);
+            }
+
+            lineStart = lineEnd + 1;
+            ++line;
+        }
+    }
+
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    JsErrorCode Run()
+    {
+        std::array<Result, c_ConfigurationCount> results;
+
+        for (size_t index = 0; index < c_ConfigurationCount; ++index)
+        {
+            IfFailRet(RunConfiguration(static_cast<Configuration>(index), results[index]));
+        }
+
+        if (m_resolvedBreakpoints != m_coldLines.size())
+        {
+            fwprintf(stderr, L"chakrahost: warning: %zu of %zu cold breakpoints resolved.\n",
+                m_resolvedBreakpoints.load(), m_coldLines.size());
+        }
+
+        // Load time is in milliseconds and workloads in calls per second.
+        // Changes are relative to running without a handler.
+        wprintf(L"%-12s", L"");
+        for (size_t index = 0; index < c_ConfigurationCount; ++index)
+        {
+            wprintf(L" %20s", GetName(static_cast<Configuration>(index)));
+        }
+
+        wprintf(L"\n%-12s", L"load (ms)");
+        for (size_t index = 0; index < c_ConfigurationCount; ++index)
+        {
+            PrintCell(results[index].loadMilliseconds, results[0].loadMilliseconds, index == 0);
+        }
+
+        wprintf(L"\n");
+
+        for (size_t workload = 0; workload < results[0].names.size(); ++workload)
+        {
+            wprintf(L"%-12s", results[0].names[workload].c_str());
+            for (size_t index = 0; index < c_ConfigurationCount; ++index)
+            {
+                PrintCell(results[index].callsPerSecond[workload], results[0].callsPerSecond[workload], index == 0);
+            }
+
+            wprintf(L"\n");
+        }
+
+        return JsNoError;
+    }
+};
@@ -60,6 +60,11 @@ public:
         return result;
     }
 
+    JsErrorCode SendCommand(const char* command)
+    {
+        return JsDebugProtocolHandlerSendCommand(m_protocolHandler, command);
+    }
+
     JsDebugProtocolHandler GetHandle()
     {
         return m_protocolHandler;
@@ -81,4 +86,37 @@ public:
     {
         return JsDebugProtocolHandlerSetCommandQueueCallback(m_protocolHandler, callback, callbackState);
     }
+
+    JsErrorCode AsyncTaskScheduled(JsValueRef task)
+    {
+        return JsDebugProtocolHandlerAsyncTaskScheduled(m_protocolHandler, task);
+    }
+
+    JsErrorCode AsyncTaskStarted(JsValueRef task)
+    {
+        return JsDebugProtocolHandlerAsyncTaskStarted(m_protocolHandler, task);
+    }
+
+    JsErrorCode AsyncTaskFinished(JsValueRef task)
+    {
+        return JsDebugProtocolHandlerAsyncTaskFinished(m_protocolHandler, task);
+    }
+
+    JsErrorCode GetStatistics(JsDebugProtocolHandlerStatistics* statistics)
+    {
+        return JsDebugProtocolHandlerGetStatistics(m_protocolHandler, statistics);
+    }
+
+    JsErrorCode SetMemoryBudget(unsigned long long maxBytes)
+    {
+        return JsDebugProtocolHandlerSetMemoryBudget(m_protocolHandler, maxBytes);
+    }
+
+    JsErrorCode SetRuntimeMemoryCallbacks(
+        JsMemoryAllocationCallback allocationCallback,
+        JsBeforeCollectCallback beforeCollectCallback,
+        void* callbackState)
+    {
+        return JsDebugProtocolHandlerSetRuntimeMemoryCallbacks(m_protocolHandler, allocationCallback, beforeCollectCallback, callbackState);
+    }
 };
@@ -55,6 +55,13 @@ public:
         return result;
     }
 
+    JsErrorCode SetBusyThreshold(uint32_t milliseconds)
+    {
+        JsErrorCode result = JsDebugServiceSetBusyThreshold(m_service, milliseconds);
+
+        return result;
+    }
+
     JsErrorCode Listen(uint16_t port)
     {
         JsErrorCode result = JsDebugServiceListen(m_service, port);
@@ -12,6 +12,13 @@ public:
     bool breakOnNextLine;
     bool enableDebugging;
     int port;
+    bool timeTravelRecord;
+    size_t timeTravelSnapInterval;
+    size_t timeTravelSnapHistory;
+    bool benchmark;
+    size_t benchmarkTime;
+    std::wstring cacheDirectory;
+    bool showStartupTime;
     bool help;
 
     std::vector<std::wstring> scriptArgs;
@@ -20,6 +27,12 @@ public:
         : breakOnNextLine(false)
         , enableDebugging(false)
         , port(9229)
+        , timeTravelRecord(false)
+        , timeTravelSnapInterval(2000)
+        , timeTravelSnapHistory(2)
+        , benchmark(false)
+        , benchmarkTime(2000)
+        , showStartupTime(false)
         , help(false)
     {
     }
@@ -53,6 +66,50 @@ public:
                         this->port = std::stoi(std::wstring(argv[index]));
                     }
                 }
+                else if (!arg.compare(L"--tt-record"))
+                {
+                    this->timeTravelRecord = true;
+                }
+                else if (!arg.compare(L"--tt-snap-interval"))
+                {
+                    ++index;
+                    if (argc > index)
+                    {
+                        this->timeTravelSnapInterval = std::stoul(std::wstring(argv[index]));
+                    }
+                }
+                else if (!arg.compare(L"--tt-snap-history"))
+                {
+                    ++index;
+                    if (argc > index)
+                    {
+                        this->timeTravelSnapHistory = std::stoul(std::wstring(argv[index]));
+                    }
+                }
+                else if (!arg.compare(L"--cache"))
+                {
+                    ++index;
+                    if (argc > index)
+                    {
+                        this->cacheDirectory = argv[index];
+                    }
+                }
+                else if (!arg.compare(L"--startup-time"))
+                {
+                    this->showStartupTime = true;
+                }
+                else if (!arg.compare(L"--benchmark"))
+                {
+                    this->benchmark = true;
+                }
+                else if (!arg.compare(L"--benchmark-time"))
+                {
+                    ++index;
+                    if (argc > index)
+                    {
+                        this->benchmarkTime = std::stoul(std::wstring(argv[index]));
+                    }
+                }
                 else
                 {
                     // Handle everything else including `-?` and `--help`
@@ -68,7 +125,14 @@ public:
             }
         }
 
-        if (this->port <= 0 || this->port > 65535 || this->scriptArgs.empty())
+        // The benchmark has a script of its own to fall back on.
+        if (this->benchmark && this->scriptArgs.empty())
+        {
+            this->scriptArgs.emplace_back(L"benchmark.js");
+        }
+
+        if (this->port <= 0 || this->port > 65535 || this->scriptArgs.empty() ||
+            this->timeTravelSnapInterval == 0 || this->timeTravelSnapHistory == 0 || this->benchmarkTime == 0)
         {
             this->help = true;
         }
@@ -84,16 +148,23 @@ public:
             L"      --inspect          Enable debugging\n"
             L"      --inspect-brk      Enable debugging and break\n"
             L"  -p, --port <number>    Specify the port number\n"
+            L"      --tt-record        Record for time travel debugging\n"
+            L"      --tt-snap-interval <ms>\n"
+            L"                         Time between snapshots while recording (default 2000)\n"
+            L"      --tt-snap-history <count>\n"
+            L"                         Snapshots kept in memory while recording (default 2)\n"
+            L"      --cache <dir>      Keep script bytecode in the directory and reuse it\n"
+            L"                         (ignored with --tt-record)\n"
+            L"      --startup-time     Report how long the script took to run\n"
+            L"      --benchmark        Time the script's workloads with and without debugging\n"
+            L"                         (default script benchmark.js)\n"
+            L"      --benchmark-time <ms>\n"
+            L"                         Time spent on each workload per configuration (default 2000)\n"
             L"  -?  --help             Show this help info\n"
             L"\n");
     }
 };
 
-//
-// Source context counter.
-//
-unsigned currentSourceContext = 0;
-
 //
 // Helper to load a script from disk.
 //
@@ -122,7 +193,7 @@ std::wstring LoadScript(const wchar_t* filename)
     return std::wstring(begin(contents), end(contents));
 }
 
-JsErrorCode RunScript(const wchar_t* filename, JsValueRef* result)
+JsErrorCode RunScript(ScriptLoader& scriptLoader, const wchar_t* filename, JsValueRef* result)
 {
     wchar_t fullPath[MAX_PATH];
     DWORD pathLength = GetFullPathName(filename, MAX_PATH, fullPath, nullptr);
@@ -131,15 +202,8 @@ JsErrorCode RunScript(const wchar_t* filename, JsValueRef* result)
         return JsErrorInvalidArgument;
     }
 
-    // Load the script from the disk.
-    std::wstring script = LoadScript(fullPath);
-    if (script.empty())
-    {
-        return JsErrorInvalidArgument;
-    }
-
-    // Run the script.
-    IfFailRet(JsRunScript(script.c_str(), currentSourceContext++, fullPath, result));
+    // Map the script from the disk and run it.
+    IfFailRet(scriptLoader.Run(fullPath, result));
 
     return JsNoError;
 }
@@ -217,8 +281,9 @@ JsValueRef CALLBACK HostRunScript(
     bool /*isConstructCall*/, 
     JsValueRef* arguments, 
     unsigned short argumentCount, 
-    void* /*callbackState*/)
+    void* callbackState)
 {
+    auto scriptLoader = static_cast<ScriptLoader*>(callbackState);
     JsValueRef result = JS_INVALID_REFERENCE;
 
     if (argumentCount < 2)
@@ -232,7 +297,7 @@ JsValueRef CALLBACK HostRunScript(
     size_t length = 0;
 
     IfFailThrowJsError(JsStringToPointer(arguments[1], &filename, &length), L"invalid filename argument");
-    IfFailThrowJsError(RunScript(filename, &result), L"failed to run script");
+    IfFailThrowJsError(RunScript(*scriptLoader, filename, &result), L"failed to run script");
 
     return result;
 }
@@ -263,10 +328,17 @@ JsErrorCode DefineHostCallback(
 //
 // Creates a host execution context and sets up the host object in it.
 //
-JsErrorCode CreateHostContext(JsRuntimeHandle runtime, std::vector<std::wstring>& scriptArgs, JsContextRef* context)
+JsErrorCode CreateHostContext(JsRuntimeHandle runtime, bool timeTravelRecord, std::vector<std::wstring>& scriptArgs, ScriptLoader* scriptLoader, JsContextRef* context)
 {
     // Create the context.
-    IfFailRet(JsCreateContext(runtime, context));
+    if (timeTravelRecord)
+    {
+        IfFailRet(JsTTDCreateContext(runtime, true, context));
+    }
+    else
+    {
+        IfFailRet(JsCreateContext(runtime, context));
+    }
 
     // Now set the execution context as being the current one on this thread.
     IfFailRet(JsSetCurrentContext(*context));
@@ -288,7 +360,7 @@ JsErrorCode CreateHostContext(JsRuntimeHandle runtime, std::vector<std::wstring>
 
     // Now create the host callbacks that we're going to expose to the script.
     IfFailRet(DefineHostCallback(hostObject, L"echo", HostEcho, nullptr));
-    IfFailRet(DefineHostCallback(hostObject, L"runScript", HostRunScript, nullptr));
+    IfFailRet(DefineHostCallback(hostObject, L"runScript", HostRunScript, scriptLoader));
     IfFailRet(DefineHostCallback(hostObject, L"throw", HostThrow, nullptr));
 
     // Create an array for arguments.
@@ -350,6 +422,29 @@ JsErrorCode PrintScriptException()
     return JsNoError;
 }
 
+//
+// Runs the --benchmark workloads from a script, reporting what each level of
+// debugging costs.
+//
+JsErrorCode RunBenchmark(const wchar_t* filename, size_t milliseconds)
+{
+    wchar_t fullPath[MAX_PATH];
+    DWORD pathLength = GetFullPathName(filename, MAX_PATH, fullPath, nullptr);
+    if (pathLength > MAX_PATH || pathLength == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    std::wstring script = LoadScript(fullPath);
+    if (script.empty())
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    Benchmark benchmark(script, fullPath, std::chrono::milliseconds(milliseconds));
+    return benchmark.Run();
+}
+
 JsErrorCode EnableDebugging(
     JsRuntimeHandle runtime,
     std::string const& runtimeName,
@@ -398,6 +493,21 @@ int _cdecl wmain(int argc, wchar_t* argv[])
 
     try
     {
+        if (arguments.benchmark)
+        {
+            IfFailError(RunBenchmark(arguments.scriptArgs[0].c_str(), arguments.benchmarkTime), L"failed to run benchmark");
+            return EXIT_SUCCESS;
+        }
+
+        // Declared before the runtime so mapped sources outlive it.
+        ScriptLoader scriptLoader;
+
+        // Recording has to see every script parsed, so it never uses the cache.
+        if (!arguments.timeTravelRecord)
+        {
+            scriptLoader.SetCacheDirectory(arguments.cacheDirectory);
+        }
+
         JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
         JsContextRef context = JS_INVALID_REFERENCE;
         std::unique_ptr<DebugProtocolHandler> debugProtocolHandler;
@@ -405,9 +515,30 @@ int _cdecl wmain(int argc, wchar_t* argv[])
         std::string runtimeName("runtime1");
 
         // Create the runtime. We're only going to use one runtime for this host.
-        IfFailError(
-            JsCreateRuntime(JsRuntimeAttributeDispatchSetExceptionsToDebugger, nullptr, &runtime),
-            L"failed to create runtime.");
+        if (arguments.timeTravelRecord)
+        {
+            // A shorter snapshot interval makes stepping back quicker at the
+            // cost of recording speed, and the history bounds both how far back
+            // the log reaches and how much memory it holds.
+            IfFailError(
+                JsTTDCreateRecordRuntime(
+                    JsRuntimeAttributeDispatchSetExceptionsToDebugger,
+                    arguments.enableDebugging,
+                    arguments.timeTravelSnapInterval,
+                    arguments.timeTravelSnapHistory,
+                    &TimeTravelLog::OpenStream,
+                    &TimeTravelLog::WriteBytes,
+                    &TimeTravelLog::FlushAndCloseStream,
+                    nullptr,
+                    &runtime),
+                L"failed to create record runtime.");
+        }
+        else
+        {
+            IfFailError(
+                JsCreateRuntime(JsRuntimeAttributeDispatchSetExceptionsToDebugger, nullptr, &runtime),
+                L"failed to create runtime.");
+        }
 
         if (arguments.enableDebugging)
         {
@@ -418,11 +549,20 @@ int _cdecl wmain(int argc, wchar_t* argv[])
 
         // Similarly, create a single execution context. Note that we're putting it on the stack here,
         // so it will stay alive through the entire run.
-        IfFailError(CreateHostContext(runtime, arguments.scriptArgs, &context), L"failed to create execution context.");
+        IfFailError(CreateHostContext(runtime, arguments.timeTravelRecord, arguments.scriptArgs, &scriptLoader, &context), L"failed to create execution context.");
 
         // Now set the execution context as being the current one on this thread.
         IfFailError(JsSetCurrentContext(context), L"failed to set current context.");
 
+        if (arguments.timeTravelRecord)
+        {
+            IfFailError(JsTTDStart(), L"failed to start recording.");
+        }
+
+        // Promise continuations run after the script, in the order scheduled.
+        PromiseTaskQueue promiseTasks;
+        IfFailError(promiseTasks.Register(debugProtocolHandler.get()), L"failed to set promise continuation callback.");
+
         if (debugProtocolHandler && arguments.breakOnNextLine)
         {
             std::cout << "Waiting for debugger to connect..." << std::endl;
@@ -432,7 +572,23 @@ int _cdecl wmain(int argc, wchar_t* argv[])
 
         // Run the script.
         JsValueRef result = JS_INVALID_REFERENCE;
-        JsErrorCode errorCode = RunScript(arguments.scriptArgs[0].c_str(), &result);
+        auto startTime = std::chrono::steady_clock::now();
+        JsErrorCode errorCode = RunScript(scriptLoader, arguments.scriptArgs[0].c_str(), &result);
+
+        if (arguments.showStartupTime)
+        {
+            // A cache miss is the cold start and a hit the warm one.
+            const wchar_t* cacheResults[] = { L"no bytecode cache", L"bytecode cache miss", L"bytecode cache hit" };
+
+            fwprintf(stderr, L"chakrahost: script ran in %.2f ms (%s).\n",
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count(),
+                cacheResults[static_cast<int>(scriptLoader.GetLastCacheResult())]);
+        }
+
+        if (errorCode == JsNoError)
+        {
+            errorCode = promiseTasks.Drain();
+        }
 
         if (errorCode == JsErrorScriptException)
         {
@@ -452,6 +608,11 @@ int _cdecl wmain(int argc, wchar_t* argv[])
         returnValue = (int)doubleResult;
         std::cout << returnValue << std::endl;
 
+        if (arguments.timeTravelRecord)
+        {
+            IfFailError(JsTTDStop(), L"failed to stop recording.");
+        }
+
         // Clean up the current execution context.
         IfFailError(JsSetCurrentContext(JS_INVALID_REFERENCE), L"failed to cleanup current context.");
         context = JS_INVALID_REFERENCE;
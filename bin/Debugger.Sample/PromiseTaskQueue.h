@@ -0,0 +1,79 @@
+#pragma once
+
+#include "DebugProtocolHandler.h"
+
+#include <ChakraCore.h>
+#include <deque>
+
+//
+// Queue of promise continuations, run once the script returns. Each task is
+// reported to the protocol handler so a debugger can show the stack that
+// scheduled it.
+//
+class PromiseTaskQueue
+{
+private:
+    std::deque<JsValueRef> m_tasks;
+    DebugProtocolHandler* m_protocolHandler;
+
+    static void CHAKRA_CALLBACK ContinuationCallback(JsValueRef task, void* callbackState)
+    {
+        auto queue = static_cast<PromiseTaskQueue*>(callbackState);
+
+        // Keep the task alive until it has run.
+        JsAddRef(task, nullptr);
+        queue->m_tasks.push_back(task);
+
+        if (queue->m_protocolHandler != nullptr)
+        {
+            queue->m_protocolHandler->AsyncTaskScheduled(task);
+        }
+    }
+
+public:
+    PromiseTaskQueue()
+        : m_protocolHandler(nullptr)
+    {
+    }
+
+    PromiseTaskQueue(const PromiseTaskQueue&) = delete;
+    PromiseTaskQueue& operator=(const PromiseTaskQueue&) = delete;
+
+    // Must be called with the context current.
+    JsErrorCode Register(DebugProtocolHandler* protocolHandler)
+    {
+        m_protocolHandler = protocolHandler;
+        return JsSetPromiseContinuationCallback(&PromiseTaskQueue::ContinuationCallback, this);
+    }
+
+    // Runs tasks, including any they schedule, until the queue is empty or one
+    // throws. Tasks left behind are reclaimed with the runtime.
+    JsErrorCode Drain()
+    {
+        JsValueRef globalObject = JS_INVALID_REFERENCE;
+        JsErrorCode result = JsGetGlobalObject(&globalObject);
+
+        while (result == JsNoError && !m_tasks.empty())
+        {
+            JsValueRef task = m_tasks.front();
+            m_tasks.pop_front();
+
+            if (m_protocolHandler != nullptr)
+            {
+                m_protocolHandler->AsyncTaskStarted(task);
+            }
+
+            JsValueRef taskResult = JS_INVALID_REFERENCE;
+            result = JsCallFunction(task, &globalObject, 1, &taskResult);
+
+            if (m_protocolHandler != nullptr)
+            {
+                m_protocolHandler->AsyncTaskFinished(task);
+            }
+
+            JsRelease(task, nullptr);
+        }
+
+        return result;
+    }
+};
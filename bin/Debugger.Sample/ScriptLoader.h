@@ -0,0 +1,248 @@
+#pragma once
+
+#include "ErrorHelpers.h"
+
+#include <Windows.h>
+#include <ChakraCore.h>
+#include <cstdint>
+#include <cwchar>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//
+// Loads and runs scripts from disk. Sources are mapped rather than read and
+// handed to the engine as external UTF-8, so nothing is copied or widened.
+// With a cache directory, the bytecode for each source is also kept on disk,
+// named for a hash of its contents, and later runs load it instead of parsing.
+//
+class ScriptLoader
+{
+public:
+    enum class CacheResult
+    {
+        Disabled,
+        Miss,
+        Hit
+    };
+
+private:
+    class MappedFile
+    {
+    private:
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+        void* m_data{ nullptr };
+        unsigned int m_size{ 0 };
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            if (m_data != nullptr)
+            {
+                UnmapViewOfFile(m_data);
+            }
+
+            if (m_mapping != nullptr)
+            {
+                CloseHandle(m_mapping);
+            }
+
+            if (m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+            }
+        }
+
+        bool Open(const wchar_t* path)
+        {
+            m_file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            // Empty files can't be mapped, and array buffers are limited to 32-bit lengths.
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0 || size.QuadPart > UINT_MAX)
+            {
+                return false;
+            }
+
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping == nullptr)
+            {
+                return false;
+            }
+
+            m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+            if (m_data == nullptr)
+            {
+                return false;
+            }
+
+            m_size = static_cast<unsigned int>(size.QuadPart);
+            return true;
+        }
+
+        // The view is read-only, which is fine as long as the buffer is only
+        // given to the engine as a script and never exposed to script code.
+        JsErrorCode CreateBuffer(JsValueRef* buffer) const
+        {
+            return JsCreateExternalArrayBuffer(m_data, m_size, nullptr, nullptr, buffer);
+        }
+
+        uint64_t Hash() const
+        {
+            // FNV-1a. A changed engine is caught by JsRunSerialized rejecting
+            // the bytecode, so only the source goes into the key.
+            uint64_t hash = 14695981039346656037ull;
+            const BYTE* bytes = static_cast<const BYTE*>(m_data);
+
+            for (unsigned int index = 0; index < m_size; ++index)
+            {
+                hash ^= bytes[index];
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+    };
+
+    std::wstring m_cacheDirectory;
+    CacheResult m_lastCacheResult{ CacheResult::Disabled };
+
+    // Sources are fetched again whenever the engine or the debugger needs the
+    // text of a script loaded from bytecode, so they are kept until the
+    // loader is destroyed, which must be after the runtime is disposed.
+    std::vector<std::unique_ptr<MappedFile>> m_files;
+
+    static bool CHAKRA_CALLBACK LoadSource(JsSourceContext sourceContext, JsValueRef* value, JsParseScriptAttributes* parseAttributes)
+    {
+        auto source = reinterpret_cast<const MappedFile*>(sourceContext);
+
+        *parseAttributes = JsParseScriptAttributeNone;
+        return source->CreateBuffer(value) == JsNoError;
+    }
+
+    std::wstring GetCachePath(const MappedFile& source) const
+    {
+        wchar_t name[32];
+        swprintf_s(name, L"%016llx.bc", static_cast<unsigned long long>(source.Hash()));
+
+        return m_cacheDirectory + L"\\" + name;
+    }
+
+    static void WriteCache(std::wstring const& cachePath, JsValueRef bytecode)
+    {
+        BYTE* data = nullptr;
+        unsigned int size = 0;
+        if (JsGetArrayBufferStorage(bytecode, &data, &size) != JsNoError)
+        {
+            return;
+        }
+
+        // Written aside and moved into place, so a run that stops part way
+        // never leaves a truncated entry behind.
+        std::wstring tempPath = cachePath + L".tmp";
+
+        {
+            std::ofstream file(tempPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+            file.write(reinterpret_cast<const char*>(data), size);
+
+            if (!file.good())
+            {
+                return;
+            }
+        }
+
+        MoveFileExW(tempPath.c_str(), cachePath.c_str(), MOVEFILE_REPLACE_EXISTING);
+    }
+
+public:
+    ScriptLoader() = default;
+    ScriptLoader(const ScriptLoader&) = delete;
+    ScriptLoader& operator=(const ScriptLoader&) = delete;
+
+    void SetCacheDirectory(std::wstring const& cacheDirectory)
+    {
+        m_cacheDirectory = cacheDirectory;
+
+        if (!m_cacheDirectory.empty())
+        {
+            // Failure shows up later as a cache that is never written.
+            CreateDirectoryW(m_cacheDirectory.c_str(), nullptr);
+        }
+    }
+
+    CacheResult GetLastCacheResult() const
+    {
+        return m_lastCacheResult;
+    }
+
+    JsErrorCode Run(const wchar_t* fullPath, JsValueRef* result)
+    {
+        auto source = std::make_unique<MappedFile>();
+        if (!source->Open(fullPath))
+        {
+            fwprintf(stderr, L"chakrahost: unable to open file: %s.\n", fullPath);
+            return JsErrorInvalidArgument;
+        }
+
+        const MappedFile& sourceFile = *source;
+        m_files.push_back(std::move(source));
+
+        JsSourceContext sourceContext = reinterpret_cast<JsSourceContext>(&sourceFile);
+
+        JsValueRef sourceUrl = JS_INVALID_REFERENCE;
+        IfFailRet(JsPointerToString(fullPath, wcslen(fullPath), &sourceUrl));
+
+        JsValueRef sourceBuffer = JS_INVALID_REFERENCE;
+        IfFailRet(sourceFile.CreateBuffer(&sourceBuffer));
+
+        if (m_cacheDirectory.empty())
+        {
+            m_lastCacheResult = CacheResult::Disabled;
+            return JsRun(sourceBuffer, sourceContext, sourceUrl, JsParseScriptAttributeNone, result);
+        }
+
+        std::wstring cachePath = GetCachePath(sourceFile);
+
+        {
+            auto bytecode = std::make_unique<MappedFile>();
+
+            if (bytecode->Open(cachePath.c_str()))
+            {
+                JsValueRef bytecodeBuffer = JS_INVALID_REFERENCE;
+                IfFailRet(bytecode->CreateBuffer(&bytecodeBuffer));
+
+                JsErrorCode errorCode = JsRunSerialized(bytecodeBuffer, &ScriptLoader::LoadSource, sourceContext, sourceUrl, result);
+
+                // Bytecode from a different engine is rejected before any of
+                // it is used, so the mapping can go and the entry be rebuilt.
+                if (errorCode != JsErrorBadSerializedScript)
+                {
+                    m_files.push_back(std::move(bytecode));
+                    m_lastCacheResult = CacheResult::Hit;
+                    return errorCode;
+                }
+            }
+        }
+
+        m_lastCacheResult = CacheResult::Miss;
+
+        // Parse once to serialize, then run the bytecode just made rather than
+        // parsing the source a second time.
+        JsValueRef bytecodeBuffer = JS_INVALID_REFERENCE;
+        IfFailRet(JsSerialize(sourceBuffer, &bytecodeBuffer, JsParseScriptAttributeNone));
+
+        WriteCache(cachePath, bytecodeBuffer);
+
+        return JsRunSerialized(bytecodeBuffer, &ScriptLoader::LoadSource, sourceContext, sourceUrl, result);
+    }
+};
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <ChakraCore.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//
+// Stream callbacks for a time travel record runtime. The engine writes the log
+// when the debugger asks for it, so the bytes are copied and written to disk on
+// a background thread instead of holding up the engine thread. A write that
+// fails fails the ones after it, and is reported when the stream is closed.
+//
+class TimeTravelLog
+{
+private:
+    struct Stream
+    {
+        std::string path;
+        std::ofstream file;
+
+        // Set by the writer thread, read by the engine thread.
+        std::atomic<bool> hasFailed{ false };
+    };
+
+    struct Write
+    {
+        Stream* stream;
+        std::vector<char> bytes;
+        bool close;
+    };
+
+    std::thread m_writerThread;
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_drained;
+    std::deque<Write> m_writes;
+    size_t m_queuedBytes{ 0 };
+    bool m_isStopping{ false };
+
+    // Past this much unwritten log, the engine waits for the disk.
+    static const size_t c_MaxQueuedBytes = 64 * 1024 * 1024;
+
+    TimeTravelLog()
+    {
+        m_writerThread = std::thread(&TimeTravelLog::WriterThreadProc, this);
+    }
+
+    static TimeTravelLog& Instance()
+    {
+        // The callbacks carry no state, so there is one writer per process.
+        static TimeTravelLog instance;
+        return instance;
+    }
+
+    void Enqueue(Write&& write)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_drained.wait(lock, [this]() { return m_queuedBytes < c_MaxQueuedBytes; });
+
+            m_queuedBytes += write.bytes.size();
+            m_writes.push_back(std::move(write));
+        }
+
+        m_wake.notify_one();
+    }
+
+    static void Close(Stream* stream)
+    {
+        if (!stream->hasFailed)
+        {
+            stream->file.flush();
+            stream->file.close();
+            stream->hasFailed = stream->file.fail();
+        }
+
+        if (stream->hasFailed)
+        {
+            fwprintf(stderr, L"chakrahost: unable to write time travel log: %hs.\n", stream->path.c_str());
+        }
+
+        delete stream;
+    }
+
+    void WriterThreadProc()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        for (;;)
+        {
+            m_wake.wait(lock, [this]() { return m_isStopping || !m_writes.empty(); });
+
+            if (m_writes.empty())
+            {
+                return;
+            }
+
+            Write write = std::move(m_writes.front());
+            m_writes.pop_front();
+
+            lock.unlock();
+
+            if (write.close)
+            {
+                Close(write.stream);
+            }
+            else if (!write.stream->hasFailed)
+            {
+                write.stream->file.write(write.bytes.data(), write.bytes.size());
+                write.stream->hasFailed = !write.stream->file.good();
+            }
+
+            lock.lock();
+
+            m_queuedBytes -= write.bytes.size();
+            m_drained.notify_all();
+        }
+    }
+
+public:
+    TimeTravelLog(const TimeTravelLog&) = delete;
+    TimeTravelLog& operator=(const TimeTravelLog&) = delete;
+
+    ~TimeTravelLog()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_isStopping = true;
+        }
+
+        // Pending writes are finished before the thread exits.
+        m_wake.notify_one();
+        m_writerThread.join();
+    }
+
+    static JsTTDStreamHandle CHAKRA_CALLBACK OpenStream(
+        size_t uriLength,
+        const char* uri,
+        size_t asciiNameLength,
+        const char* asciiResourceName,
+        bool read,
+        bool write)
+    {
+        // Recording only ever writes.
+        if (read || !write)
+        {
+            return nullptr;
+        }
+
+        std::string path(uri, uriLength);
+        if (!path.empty() && path.back() != '\\' && path.back() != '/')
+        {
+            path += '\\';
+        }
+
+        path.append(asciiResourceName, asciiNameLength);
+
+        // Start the writer before the first stream can reach it.
+        Instance();
+
+        auto stream = new Stream();
+        stream->path = path;
+        stream->file.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+        if (!stream->file.good())
+        {
+            delete stream;
+            return nullptr;
+        }
+
+        return stream;
+    }
+
+    static bool CHAKRA_CALLBACK WriteBytes(JsTTDStreamHandle handle, const byte* data, size_t size, size_t* bytesWritten)
+    {
+        auto stream = static_cast<Stream*>(handle);
+        const char* bytes = reinterpret_cast<const char*>(data);
+
+        // The write itself happens later, so only a failure already seen can
+        // be reported to the engine here.
+        if (stream->hasFailed)
+        {
+            *bytesWritten = 0;
+            return false;
+        }
+
+        Instance().Enqueue(Write { stream, std::vector<char>(bytes, bytes + size), false });
+        *bytesWritten = size;
+        return true;
+    }
+
+    static void CHAKRA_CALLBACK FlushAndCloseStream(JsTTDStreamHandle handle, bool /*read*/, bool /*write*/)
+    {
+        Instance().Enqueue(Write { static_cast<Stream*>(handle), std::vector<char>(), true });
+    }
+};
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// Workloads for the sample's --benchmark mode. The host calls each function in
+// `benchmarks` repeatedly and reports calls per second, so each should take
+// around a millisecond.
+//
+
+var benchmarks = {
+  objects: function () {
+    const points = [];
+    for (let i = 0; i < 2000; i++) {
+      points.push({ x: i, y: i * 2, z: { w: i % 7 } });
+    }
+
+    let sum = 0;
+    for (const point of points) {
+      sum += point.x + point.y + point.z.w;
+    }
+
+    return sum;
+  },
+
+  strings: function () {
+    let text = "";
+    for (let i = 0; i < 1000; i++) {
+      text += String.fromCharCode(97 + (i % 26));
+    }
+
+    return text.split("").reverse().join("").toUpperCase().indexOf("ZYX");
+  },
+
+  closures: function () {
+    const counters = [];
+    for (let i = 0; i < 1000; i++) {
+      let count = i;
+      counters.push(() => ++count);
+    }
+
+    return counters.reduce((total, next) => total + next(), 0);
+  },
+
+  json: function () {
+    const value = { name: "benchmark", items: [] };
+    for (let i = 0; i < 200; i++) {
+      value.items.push({ id: i, tags: ["a", "b", "c"], active: i % 2 === 0 });
+    }
+
+    return JSON.parse(JSON.stringify(value)).items.length;
+  },
+
+  regexp: function () {
+    const pattern = /(\d+)-(\w+)/g;
+    let input = "";
+    for (let i = 0; i < 200; i++) {
+      input += i + "-item" + i + " ";
+    }
+
+    let matches = 0;
+    while (pattern.exec(input) !== null) {
+      matches++;
+    }
+
+    return matches;
+  },
+
+  calls: function () {
+    function fib(n) {
+      return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    }
+
+    return fib(18);
+  },
+};
+
+//
+// Never called. With breakpoints set on the marked lines, the engine runs the
+// workloads with breakpoints installed that are never hit.
+//
+function coldPath(value) {
+  let result = value * 2; // cold
+  result += benchmarks.calls(); // cold
+  return result; // cold
+}
@@ -5,13 +5,18 @@
 
 #include "targetver.h"
 
+#include "Benchmark.h"
 #include "DebugProtocolHandler.h"
 #include "DebugService.h"
 #include "ErrorHelpers.h"
+#include "PromiseTaskQueue.h"
+#include "ScriptLoader.h"
+#include "TimeTravelLog.h"
 
 #include <stdio.h>
 #include <tchar.h>
 
+#include <chrono>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
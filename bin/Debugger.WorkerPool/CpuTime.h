@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+
+//
+// CPU time, kernel plus user, in 100ns units.
+//
+namespace CpuTime
+{
+    inline uint64_t FromFileTimes(const FILETIME& kernelTime, const FILETIME& userTime)
+    {
+        ULARGE_INTEGER kernel;
+        kernel.LowPart = kernelTime.dwLowDateTime;
+        kernel.HighPart = kernelTime.dwHighDateTime;
+
+        ULARGE_INTEGER user;
+        user.LowPart = userTime.dwLowDateTime;
+        user.HighPart = userTime.dwHighDateTime;
+
+        return kernel.QuadPart + user.QuadPart;
+    }
+
+    inline uint64_t OfThread(HANDLE thread)
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(thread, &creationTime, &exitTime, &kernelTime, &userTime))
+        {
+            return 0;
+        }
+
+        return FromFileTimes(kernelTime, userTime);
+    }
+
+    inline uint64_t OfProcess()
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        {
+            return 0;
+        }
+
+        return FromFileTimes(kernelTime, userTime);
+    }
+}
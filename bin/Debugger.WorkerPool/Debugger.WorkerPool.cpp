@@ -0,0 +1,394 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+//
+// Class to store information about command-line arguments to the host.
+//
+class CommandLineArguments
+{
+public:
+    int port;
+    std::vector<size_t> workerCounts;
+    int warmupSeconds;
+    int measureSeconds;
+    size_t registrations;
+    std::wstring script;
+    bool help;
+
+    CommandLineArguments()
+        : port(9229)
+        , workerCounts({ 1, 2, 4, 8, 16, 32, 64, 128, 256 })
+        , warmupSeconds(1)
+        , measureSeconds(5)
+        , registrations(0)
+        , script(L"workload.js")
+        , help(false)
+    {
+    }
+
+    void ParseCommandLine(int argc, wchar_t* argv[])
+    {
+        for (int index = 1; index < argc; ++index)
+        {
+            std::wstring arg(argv[index]);
+
+            if (!arg.compare(L"--port") || !arg.compare(L"-p"))
+            {
+                ++index;
+                if (argc > index)
+                {
+                    // This will return zero if no number was found.
+                    this->port = std::stoi(std::wstring(argv[index]));
+                }
+            }
+            else if (!arg.compare(L"--workers"))
+            {
+                ++index;
+                if (argc > index)
+                {
+                    // A comma separated list, run in order.
+                    this->workerCounts.clear();
+
+                    std::wstring counts(argv[index]);
+                    size_t start = 0;
+
+                    while (start < counts.length())
+                    {
+                        size_t end = counts.find(L',', start);
+                        if (end == std::wstring::npos)
+                        {
+                            end = counts.length();
+                        }
+
+                        this->workerCounts.push_back(std::stoul(counts.substr(start, end - start)));
+                        start = end + 1;
+                    }
+                }
+            }
+            else if (!arg.compare(L"--warmup"))
+            {
+                ++index;
+                if (argc > index)
+                {
+                    this->warmupSeconds = std::stoi(std::wstring(argv[index]));
+                }
+            }
+            else if (!arg.compare(L"--seconds"))
+            {
+                ++index;
+                if (argc > index)
+                {
+                    this->measureSeconds = std::stoi(std::wstring(argv[index]));
+                }
+            }
+            else if (!arg.compare(L"--registrations"))
+            {
+                ++index;
+                if (argc > index)
+                {
+                    this->registrations = std::stoul(std::wstring(argv[index]));
+                }
+            }
+            else if ((arg.length() > 0) && (arg[0] == L'-'))
+            {
+                // Handle everything else including `-?` and `--help`
+                this->help = true;
+            }
+            else
+            {
+                this->script = arg;
+            }
+        }
+
+        if (this->port <= 0 || this->port + static_cast<int>(this->workerCounts.size()) > 65536 || this->workerCounts.empty() ||
+            std::find(this->workerCounts.begin(), this->workerCounts.end(), 0) != this->workerCounts.end() ||
+            this->warmupSeconds < 0 || this->measureSeconds <= 0)
+        {
+            this->help = true;
+        }
+    }
+
+    void ShowHelp()
+    {
+        fwprintf(stderr,
+            L"\n"
+            L"Usage: ChakraCore.Debugger.WorkerPool.exe [options] [workload-script]\n"
+            L"\n"
+            L"Runs the workload on N threads, each with its own runtime and protocol handler on\n"
+            L"one debug service, with a scripted client attached to every one, and reports how\n"
+            L"throughput, command latency and service CPU change with N.\n"
+            L"\n"
+            L"Options: \n"
+            L"  -p, --port <number>    Specify the first port number, one per worker count\n"
+            L"      --workers <list>   Worker counts to run, comma separated (default 1,2,4,...,256)\n"
+            L"      --warmup <seconds> Time to run before measuring (default 1)\n"
+            L"      --seconds <seconds>\n"
+            L"                         Time to measure each worker count (default 5)\n"
+            L"      --registrations <count>\n"
+            L"                         Instead of the workload, have each worker count register\n"
+            L"                         and then unregister <count> handlers between them, and\n"
+            L"                         report how many of each the service handles per second\n"
+            L"  -?  --help             Show this help info\n"
+            L"\n");
+    }
+};
+
+//
+// Helper to load a script from disk.
+//
+std::wstring LoadScript(const wchar_t* filename)
+{
+    std::ifstream ifs(filename, std::ifstream::in | std::ifstream::binary);
+
+    if (!ifs.good())
+    {
+        fwprintf(stderr, L"chakrahost: unable to open file: %s.\n", filename);
+        return std::wstring();
+    }
+
+    std::vector<char> rawBytes(
+        (std::istreambuf_iterator<char>(ifs)),
+        std::istreambuf_iterator<char>());
+
+    std::vector<wchar_t> contents(rawBytes.size());
+
+    int length = MultiByteToWideChar(CP_UTF8, 0, rawBytes.data(), static_cast<int>(rawBytes.size()), contents.data(), static_cast<int>(contents.size()));
+    if (length == 0)
+    {
+        fwprintf(stderr, L"chakrahost: fatal error.\n");
+        return std::wstring();
+    }
+
+    return std::wstring(contents.data(), length);
+}
+
+//
+// Counters read at the start and end of the measured interval.
+//
+struct Snapshot
+{
+    std::chrono::steady_clock::time_point time;
+    uint64_t iterations;
+    uint64_t processCpuTime;
+    uint64_t ownedCpuTime;
+};
+
+Snapshot TakeSnapshot(std::vector<std::unique_ptr<Worker>>& workers, ScriptedClients& clients)
+{
+    Snapshot snapshot { std::chrono::steady_clock::now(), 0, CpuTime::OfProcess(), 0 };
+
+    for (auto& worker : workers)
+    {
+        snapshot.iterations += worker->Iterations();
+        snapshot.ownedCpuTime += worker->ThreadCpuTime();
+    }
+
+    snapshot.ownedCpuTime += clients.ThreadCpuTime();
+    snapshot.ownedCpuTime += CpuTime::OfThread(GetCurrentThread());
+
+    return snapshot;
+}
+
+double Percentile(std::vector<uint32_t>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+
+    size_t index = static_cast<size_t>((values.size() - 1) * fraction);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+
+    return values[index];
+}
+
+JsErrorCode RunWorkerCount(const CommandLineArguments& arguments, const std::wstring& script, size_t workerCount, int port)
+{
+    DebugService service;
+    IfFailRet(service.Listen(static_cast<uint16_t>(port)));
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t index = 0; index < workerCount; ++index)
+    {
+        workers.push_back(std::make_unique<Worker>(service, "worker" + std::to_string(index + 1), script));
+        IfFailRet(workers.back()->Start());
+    }
+
+    ScriptedClients clients;
+    for (auto& worker : workers)
+    {
+        if (!clients.Connect("ws://127.0.0.1:" + std::to_string(port) + "/" + worker->Name()))
+        {
+            return JsErrorInvalidArgument;
+        }
+    }
+
+    if (!clients.WaitForOpen(std::chrono::seconds(30)))
+    {
+        fwprintf(stderr, L"chakrahost: clients failed to connect.\n");
+        return JsErrorFatal;
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(arguments.warmupSeconds));
+
+    Snapshot start = TakeSnapshot(workers, clients);
+    clients.StartRecording();
+
+    std::this_thread::sleep_for(std::chrono::seconds(arguments.measureSeconds));
+
+    clients.StopRecording();
+    Snapshot end = TakeSnapshot(workers, clients);
+
+    clients.Stop();
+
+    for (auto& worker : workers)
+    {
+        worker->Stop();
+    }
+
+    IfFailRet(service.Close());
+
+    // Everything the process spent that the workers, clients and this thread
+    // didn't is the service's.
+    double seconds = std::chrono::duration<double>(end.time - start.time).count();
+    uint64_t processCpuTime = end.processCpuTime - start.processCpuTime;
+    uint64_t ownedCpuTime = end.ownedCpuTime - start.ownedCpuTime;
+    double serviceCpuPercent = processCpuTime > ownedCpuTime
+        ? (processCpuTime - ownedCpuTime) / (seconds * 10000000.0) * 100.0
+        : 0;
+
+    std::vector<uint32_t> allLatencies;
+    double worstSessionP99 = 0;
+
+    for (std::vector<uint32_t>& latencies : clients.TakeLatencies())
+    {
+        allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
+        worstSessionP99 = std::max(worstSessionP99, Percentile(latencies, 0.99));
+    }
+
+    wprintf(L"%7zu %14.1f %12.1f %10.3f %10.3f %12.3f %12.1f\n",
+        workerCount,
+        (end.iterations - start.iterations) / seconds,
+        allLatencies.size() / seconds,
+        Percentile(allLatencies, 0.5) / 1000.0,
+        Percentile(allLatencies, 0.99) / 1000.0,
+        worstSessionP99 / 1000.0,
+        serviceCpuPercent);
+
+    return JsNoError;
+}
+
+JsErrorCode RunRegistrations(size_t registrations, size_t workerCount, int port)
+{
+    DebugService service;
+    IfFailRet(service.Listen(static_cast<uint16_t>(port)));
+
+    // Each worker registers its own share, so the registry holds all of them at
+    // once before any is unregistered.
+    std::promise<void> go;
+    std::shared_future<void> started = go.get_future().share();
+
+    std::vector<std::unique_ptr<Registrar>> registrars;
+    for (size_t index = 0; index < workerCount; ++index)
+    {
+        size_t count = registrations / workerCount + (index < registrations % workerCount ? 1 : 0);
+        registrars.push_back(std::make_unique<Registrar>(service, "worker" + std::to_string(index + 1), count, started));
+    }
+
+    go.set_value();
+
+    std::chrono::steady_clock::duration registerTime {};
+    std::chrono::steady_clock::duration unregisterTime {};
+
+    for (auto& registrar : registrars)
+    {
+        IfFailRet(registrar->Join());
+        registerTime = std::max(registerTime, registrar->RegisterTime());
+        unregisterTime = std::max(unregisterTime, registrar->UnregisterTime());
+    }
+
+    IfFailRet(service.Close());
+
+    wprintf(L"%7zu %14zu %16.1f %16.1f\n",
+        workerCount,
+        registrations,
+        registrations / std::chrono::duration<double>(registerTime).count(),
+        registrations / std::chrono::duration<double>(unregisterTime).count());
+
+    return JsNoError;
+}
+
+//
+// The main entry point for the host.
+//
+int _cdecl wmain(int argc, wchar_t* argv[])
+{
+    int returnValue = EXIT_FAILURE;
+    CommandLineArguments arguments;
+
+    arguments.ParseCommandLine(argc, argv);
+
+    if (arguments.help)
+    {
+        arguments.ShowHelp();
+        return returnValue;
+    }
+
+    try
+    {
+        if (arguments.registrations != 0)
+        {
+            // Registrations are timed from the slowest worker's first to its last.
+            wprintf(L"%7s %14s %16s %16s\n", L"workers", L"registrations", L"registered/s", L"unregistered/s");
+
+            for (size_t index = 0; index < arguments.workerCounts.size(); ++index)
+            {
+                IfFailError(
+                    RunRegistrations(arguments.registrations, arguments.workerCounts[index], arguments.port + static_cast<int>(index)),
+                    L"failed to run registrations");
+            }
+
+            return EXIT_SUCCESS;
+        }
+
+        wchar_t fullPath[MAX_PATH];
+        DWORD pathLength = GetFullPathName(arguments.script.c_str(), MAX_PATH, fullPath, nullptr);
+        if (pathLength > MAX_PATH || pathLength == 0)
+        {
+            fwprintf(stderr, L"chakrahost: invalid script path.\n");
+            return returnValue;
+        }
+
+        // Every worker runs the same source, so it's read once.
+        std::wstring script = LoadScript(fullPath);
+        if (script.empty())
+        {
+            return returnValue;
+        }
+
+        // Latencies are per command in milliseconds, and service CPU is the
+        // percentage of one core.
+        wprintf(L"%7s %14s %12s %10s %10s %12s %12s\n",
+            L"workers", L"iterations/s", L"commands/s", L"p50 ms", L"p99 ms", L"worst p99", L"service cpu");
+
+        // Each run listens on its own port so it doesn't wait for the last
+        // run's connections to leave TIME_WAIT.
+        for (size_t index = 0; index < arguments.workerCounts.size(); ++index)
+        {
+            IfFailError(
+                RunWorkerCount(arguments, script, arguments.workerCounts[index], arguments.port + static_cast<int>(index)),
+                L"failed to run workers");
+        }
+
+        returnValue = EXIT_SUCCESS;
+    }
+    catch (...)
+    {
+        fwprintf(stderr, L"chakrahost: fatal error: internal error.\n");
+    }
+
+error:
+    return returnValue;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "DebugProtocolHandler.h"
+#include "DebugService.h"
+#include "ErrorHelpers.h"
+
+#include <ChakraCore.h>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+//
+// A thread with its own runtime and protocol handler that registers it on a
+// shared debug service under many IDs and then unregisters them all, timing
+// each pass. Registrars wait for a common signal so their passes overlap.
+//
+class Registrar
+{
+private:
+    DebugService& m_service;
+    std::string m_name;
+    size_t m_count;
+    std::shared_future<void> m_go;
+
+    std::thread m_thread;
+    JsErrorCode m_result{ JsNoError };
+    std::chrono::steady_clock::duration m_registerTime{};
+    std::chrono::steady_clock::duration m_unregisterTime{};
+
+    void ThreadProc()
+    {
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        JsErrorCode result = JsCreateRuntime(JsRuntimeAttributeDisableBackgroundWork, nullptr, &runtime);
+
+        if (result == JsNoError)
+        {
+            try
+            {
+                result = Run(runtime);
+            }
+            catch (...)
+            {
+                result = JsErrorFatal;
+            }
+
+            JsSetCurrentContext(JS_INVALID_REFERENCE);
+            JsDisposeRuntime(runtime);
+        }
+
+        m_result = result;
+    }
+
+    JsErrorCode Run(JsRuntimeHandle runtime)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        IfFailRet(JsCreateContext(runtime, &context));
+        IfFailRet(JsSetCurrentContext(context));
+
+        DebugProtocolHandler protocolHandler(runtime);
+
+        m_go.wait();
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t index = 0; index < m_count; ++index)
+        {
+            IfFailRet(m_service.RegisterHandler(Id(index), protocolHandler, false));
+        }
+
+        auto registered = std::chrono::steady_clock::now();
+
+        for (size_t index = 0; index < m_count; ++index)
+        {
+            IfFailRet(m_service.UnregisterHandler(Id(index)));
+        }
+
+        m_registerTime = registered - start;
+        m_unregisterTime = std::chrono::steady_clock::now() - registered;
+
+        return protocolHandler.Destroy();
+    }
+
+    std::string Id(size_t index) const
+    {
+        return m_name + "-" + std::to_string(index + 1);
+    }
+
+public:
+    Registrar(DebugService& service, std::string const& name, size_t count, std::shared_future<void> go)
+        : m_service(service)
+        , m_name(name)
+        , m_count(count)
+        , m_go(go)
+    {
+        m_thread = std::thread(&Registrar::ThreadProc, this);
+    }
+
+    Registrar(const Registrar&) = delete;
+    Registrar& operator=(const Registrar&) = delete;
+
+    ~Registrar()
+    {
+        Join();
+    }
+
+    JsErrorCode Join()
+    {
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        return m_result;
+    }
+
+    std::chrono::steady_clock::duration RegisterTime() const
+    {
+        return m_registerTime;
+    }
+
+    std::chrono::steady_clock::duration UnregisterTime() const
+    {
+        return m_unregisterTime;
+    }
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "CpuTime.h"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+//
+// WebSocket clients that each hold one debugging session and send a fixed
+// script of commands, one at a time, for as long as they are connected. All
+// of them share one client thread.
+//
+class ScriptedClients
+{
+private:
+    typedef websocketpp::client<websocketpp::config::asio_client> Client;
+
+    struct Command
+    {
+        const char* method;
+        const char* params;
+    };
+
+    struct Session
+    {
+        websocketpp::connection_hdl hdl;
+        size_t nextCommand;
+        int nextId;
+        std::chrono::steady_clock::time_point sentTime;
+        std::vector<uint32_t> latencies;
+    };
+
+    // Sent once when the session opens, so events flow as they would for a
+    // real debugger.
+    static const std::vector<Command>& SetupCommands()
+    {
+        static const std::vector<Command> commands = {
+            { "Runtime.enable", nullptr },
+            { "Debugger.enable", nullptr },
+        };
+
+        return commands;
+    }
+
+    // Repeated until the session closes. Only these are timed.
+    static const std::vector<Command>& LoopCommands()
+    {
+        static const std::vector<Command> commands = {
+            { "Runtime.evaluate", "{\"expression\":\"iterations\"}" },
+            { "Schema.getDomains", nullptr },
+        };
+
+        return commands;
+    }
+
+    Client m_client;
+    std::thread m_thread;
+    std::list<Session> m_sessions;
+    std::atomic<size_t> m_openCount{ 0 };
+    std::atomic<bool> m_isRecording{ false };
+
+    void SendNext(Session& session)
+    {
+        const std::vector<Command>& setup = SetupCommands();
+        const std::vector<Command>& loop = LoopCommands();
+
+        const Command& command = session.nextCommand < setup.size()
+            ? setup[session.nextCommand]
+            : loop[(session.nextCommand - setup.size()) % loop.size()];
+
+        std::string message = "{\"id\":" + std::to_string(session.nextId++) + ",\"method\":\"" + command.method + "\"";
+        if (command.params != nullptr)
+        {
+            message += ",\"params\":";
+            message += command.params;
+        }
+
+        message += "}";
+
+        session.sentTime = std::chrono::steady_clock::now();
+
+        websocketpp::lib::error_code ec;
+        m_client.send(session.hdl, message, websocketpp::frame::opcode::text, ec);
+    }
+
+    void OnMessage(Session& session, Client::message_ptr msg)
+    {
+        // With one command outstanding, anything that isn't an event is its
+        // response.
+        if (msg->get_payload().compare(0, 10, "{\"method\":") == 0)
+        {
+            return;
+        }
+
+        if (m_isRecording && session.nextCommand >= SetupCommands().size())
+        {
+            auto latency = std::chrono::steady_clock::now() - session.sentTime;
+            session.latencies.push_back(static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+        }
+
+        ++session.nextCommand;
+        SendNext(session);
+    }
+
+public:
+    ScriptedClients()
+    {
+        m_client.clear_access_channels(websocketpp::log::alevel::all);
+        m_client.clear_error_channels(websocketpp::log::elevel::all);
+        m_client.init_asio();
+        m_client.start_perpetual();
+
+        m_thread = std::thread(&Client::run, &m_client);
+    }
+
+    ScriptedClients(const ScriptedClients&) = delete;
+    ScriptedClients& operator=(const ScriptedClients&) = delete;
+
+    ~ScriptedClients()
+    {
+        Stop();
+    }
+
+    bool Connect(std::string const& uri)
+    {
+        websocketpp::lib::error_code ec;
+        Client::connection_ptr connection = m_client.get_connection(uri, ec);
+
+        if (ec)
+        {
+            return false;
+        }
+
+        m_sessions.emplace_back();
+        Session* session = &m_sessions.back();
+        session->hdl = connection->get_handle();
+        session->nextCommand = 0;
+        session->nextId = 1;
+
+        connection->set_open_handler([this, session](websocketpp::connection_hdl)
+        {
+            ++m_openCount;
+            SendNext(*session);
+        });
+
+        connection->set_message_handler([this, session](websocketpp::connection_hdl, Client::message_ptr msg)
+        {
+            OnMessage(*session, msg);
+        });
+
+        m_client.connect(connection);
+        return true;
+    }
+
+    bool WaitForOpen(std::chrono::milliseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (m_openCount < m_sessions.size())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return true;
+    }
+
+    void StartRecording()
+    {
+        m_isRecording = true;
+    }
+
+    void StopRecording()
+    {
+        m_isRecording = false;
+    }
+
+    void Stop()
+    {
+        if (!m_thread.joinable())
+        {
+            return;
+        }
+
+        for (Session& session : m_sessions)
+        {
+            websocketpp::lib::error_code ec;
+            m_client.close(session.hdl, websocketpp::close::status::going_away, std::string(), ec);
+        }
+
+        m_client.stop_perpetual();
+        m_thread.join();
+    }
+
+    uint64_t ThreadCpuTime()
+    {
+        return CpuTime::OfThread(m_thread.native_handle());
+    }
+
+    // Only valid once stopped, when the client thread no longer touches them.
+    std::vector<std::vector<uint32_t>> TakeLatencies()
+    {
+        std::vector<std::vector<uint32_t>> latencies;
+
+        for (Session& session : m_sessions)
+        {
+            latencies.push_back(std::move(session.latencies));
+        }
+
+        return latencies;
+    }
+};
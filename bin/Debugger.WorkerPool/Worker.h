@@ -0,0 +1,177 @@
+#pragma once
+
+#include "CpuTime.h"
+#include "DebugProtocolHandler.h"
+#include "DebugService.h"
+#include "ErrorHelpers.h"
+
+#include <ChakraCore.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+//
+// A thread with its own runtime and protocol handler, registered on a shared
+// debug service, that calls the workload's work() function until stopped.
+//
+class Worker
+{
+private:
+    DebugService& m_service;
+    std::string m_name;
+    const std::wstring& m_script;
+
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_started;
+    bool m_isStarted{ false };
+    JsErrorCode m_startResult{ JsNoError };
+
+    std::atomic<bool> m_isStopping{ false };
+    std::atomic<uint64_t> m_iterations{ 0 };
+
+    void SignalStarted(JsErrorCode result)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+
+            if (m_isStarted)
+            {
+                return;
+            }
+
+            m_isStarted = true;
+            m_startResult = result;
+        }
+
+        m_started.notify_one();
+    }
+
+    void ThreadProc()
+    {
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+
+        // Background JIT and GC are turned off so the only threads the
+        // benchmark doesn't own are the debug service's.
+        JsErrorCode result = JsCreateRuntime(
+            static_cast<JsRuntimeAttributes>(JsRuntimeAttributeDisableBackgroundWork | JsRuntimeAttributeDispatchSetExceptionsToDebugger),
+            nullptr,
+            &runtime);
+
+        if (result == JsNoError)
+        {
+            try
+            {
+                result = Run(runtime);
+            }
+            catch (...)
+            {
+                result = JsErrorFatal;
+            }
+
+            JsSetCurrentContext(JS_INVALID_REFERENCE);
+            JsDisposeRuntime(runtime);
+        }
+
+        SignalStarted(result);
+    }
+
+    JsErrorCode Run(JsRuntimeHandle runtime)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        IfFailRet(JsCreateContext(runtime, &context));
+        IfFailRet(JsSetCurrentContext(context));
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        IfFailRet(JsRunScript(m_script.c_str(), 0, L"workload.js", &result));
+
+        JsValueRef globalObject = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetGlobalObject(&globalObject));
+
+        JsPropertyIdRef workName = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetPropertyIdFromName(L"work", &workName));
+
+        JsValueRef work = JS_INVALID_REFERENCE;
+        IfFailRet(JsGetProperty(globalObject, workName, &work));
+
+        DebugProtocolHandler protocolHandler(runtime);
+        IfFailRet(m_service.RegisterHandler(m_name, protocolHandler, false));
+
+        SignalStarted(JsNoError);
+
+        JsErrorCode errorCode = JsNoError;
+
+        while (errorCode == JsNoError && !m_isStopping)
+        {
+            errorCode = JsCallFunction(work, &globalObject, 1, &result);
+
+            if (errorCode == JsNoError)
+            {
+                ++m_iterations;
+
+                // Commands sent while work() runs are handled at an async
+                // break. This picks up any that arrive between calls.
+                errorCode = protocolHandler.ProcessCommandQueue();
+            }
+        }
+
+        m_service.UnregisterHandler(m_name);
+        IfFailRet(protocolHandler.Destroy());
+
+        return errorCode;
+    }
+
+public:
+    Worker(DebugService& service, std::string const& name, const std::wstring& script)
+        : m_service(service)
+        , m_name(name)
+        , m_script(script)
+    {
+    }
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    ~Worker()
+    {
+        Stop();
+    }
+
+    // Returns once the handler is registered, or with the error that stopped it.
+    JsErrorCode Start()
+    {
+        m_thread = std::thread(&Worker::ThreadProc, this);
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_started.wait(lock, [this]() { return m_isStarted; });
+
+        return m_startResult;
+    }
+
+    void Stop()
+    {
+        m_isStopping = true;
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    const std::string& Name() const
+    {
+        return m_name;
+    }
+
+    uint64_t Iterations() const
+    {
+        return m_iterations;
+    }
+
+    uint64_t ThreadCpuTime()
+    {
+        return CpuTime::OfThread(m_thread.native_handle());
+    }
+};
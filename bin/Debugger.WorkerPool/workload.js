@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// Workload for the worker pool benchmark. The host calls work() in a loop and
+// handles debugger commands between calls, so each call should stay short.
+//
+
+var iterations = 0;
+
+function work() {
+  const items = [];
+  for (let i = 0; i < 1000; i++) {
+    items.push({ id: i, name: "item" + i, value: (i * 7919) % 1000 });
+  }
+
+  items.sort((a, b) => a.value - b.value);
+
+  let text = "";
+  for (const item of items) {
+    if (item.value % 10 === 0) {
+      text += item.name + ",";
+    }
+  }
+
+  iterations++;
+  return JSON.parse(JSON.stringify(items)).length + text.length;
+}
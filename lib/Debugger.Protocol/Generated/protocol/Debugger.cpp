@@ -276,6 +276,45 @@ std::unique_ptr<API::SearchMatch> API::SearchMatch::fromJSONString(const StringV
     return protocol::Debugger::SearchMatch::fromValue(value.get(), &errors);
 }
 
+std::unique_ptr<EvaluateBatchResult> EvaluateBatchResult::fromValue(protocol::Value* value, ErrorSupport* errors)
+{
+    if (!value || value->type() != protocol::Value::TypeObject) {
+        errors->addError("object expected");
+        return nullptr;
+    }
+
+    std::unique_ptr<EvaluateBatchResult> result(new EvaluateBatchResult());
+    protocol::DictionaryValue* object = DictionaryValue::cast(value);
+    errors->push();
+    protocol::Value* resultValue = object->get("result");
+    errors->setName("result");
+    result->m_result = ValueConversions<protocol::Runtime::RemoteObject>::fromValue(resultValue, errors);
+    protocol::Value* exceptionDetailsValue = object->get("exceptionDetails");
+    if (exceptionDetailsValue) {
+        errors->setName("exceptionDetails");
+        result->m_exceptionDetails = ValueConversions<protocol::Runtime::ExceptionDetails>::fromValue(exceptionDetailsValue, errors);
+    }
+    errors->pop();
+    if (errors->hasErrors())
+        return nullptr;
+    return result;
+}
+
+std::unique_ptr<protocol::DictionaryValue> EvaluateBatchResult::toValue() const
+{
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    result->setValue("result", ValueConversions<protocol::Runtime::RemoteObject>::toValue(m_result.get()));
+    if (m_exceptionDetails.isJust())
+        result->setValue("exceptionDetails", ValueConversions<protocol::Runtime::ExceptionDetails>::toValue(m_exceptionDetails.fromJust()));
+    return result;
+}
+
+std::unique_ptr<EvaluateBatchResult> EvaluateBatchResult::clone() const
+{
+    ErrorSupport errors;
+    return fromValue(toValue().get(), &errors);
+}
+
 std::unique_ptr<ScriptParsedNotification> ScriptParsedNotification::fromValue(protocol::Value* value, ErrorSupport* errors)
 {
     if (!value || value->type() != protocol::Value::TypeObject) {
@@ -708,6 +747,7 @@ public:
         m_dispatchMap["Debugger.getScriptSource"] = &DispatcherImpl::getScriptSource;
         m_dispatchMap["Debugger.setPauseOnExceptions"] = &DispatcherImpl::setPauseOnExceptions;
         m_dispatchMap["Debugger.evaluateOnCallFrame"] = &DispatcherImpl::evaluateOnCallFrame;
+        m_dispatchMap["Debugger.evaluateBatchOnCallFrame"] = &DispatcherImpl::evaluateBatchOnCallFrame;
         m_dispatchMap["Debugger.setVariableValue"] = &DispatcherImpl::setVariableValue;
         m_dispatchMap["Debugger.setAsyncCallStackDepth"] = &DispatcherImpl::setAsyncCallStackDepth;
         m_dispatchMap["Debugger.setBlackboxPatterns"] = &DispatcherImpl::setBlackboxPatterns;
@@ -742,6 +782,7 @@ protected:
     DispatchResponse::Status getScriptSource(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
     DispatchResponse::Status setPauseOnExceptions(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
     DispatchResponse::Status evaluateOnCallFrame(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
+    DispatchResponse::Status evaluateBatchOnCallFrame(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
     DispatchResponse::Status setVariableValue(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
     DispatchResponse::Status setAsyncCallStackDepth(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
     DispatchResponse::Status setBlackboxPatterns(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
@@ -1277,6 +1318,50 @@ DispatchResponse::Status DispatcherImpl::evaluateOnCallFrame(int callId, std::un
     return response.status();
 }
 
+DispatchResponse::Status DispatcherImpl::evaluateBatchOnCallFrame(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
+{
+    // Prepare input parameters.
+    protocol::DictionaryValue* object = DictionaryValue::cast(requestMessageObject->get("params"));
+    errors->push();
+    protocol::Value* callFrameIdValue = object ? object->get("callFrameId") : nullptr;
+    errors->setName("callFrameId");
+    String in_callFrameId = ValueConversions<String>::fromValue(callFrameIdValue, errors);
+    protocol::Value* expressionsValue = object ? object->get("expressions") : nullptr;
+    errors->setName("expressions");
+    std::unique_ptr<protocol::Array<String>> in_expressions = ValueConversions<protocol::Array<String>>::fromValue(expressionsValue, errors);
+    protocol::Value* objectGroupValue = object ? object->get("objectGroup") : nullptr;
+    Maybe<String> in_objectGroup;
+    if (objectGroupValue) {
+        errors->setName("objectGroup");
+        in_objectGroup = ValueConversions<String>::fromValue(objectGroupValue, errors);
+    }
+    protocol::Value* returnByValueValue = object ? object->get("returnByValue") : nullptr;
+    Maybe<bool> in_returnByValue;
+    if (returnByValueValue) {
+        errors->setName("returnByValue");
+        in_returnByValue = ValueConversions<bool>::fromValue(returnByValueValue, errors);
+    }
+    errors->pop();
+    if (errors->hasErrors()) {
+        reportProtocolError(callId, DispatchResponse::kInvalidParams, kInvalidParamsString, errors);
+        return DispatchResponse::kError;
+    }
+    // Declare output parameters.
+    std::unique_ptr<protocol::Array<protocol::Debugger::EvaluateBatchResult>> out_results;
+
+    std::unique_ptr<DispatcherBase::WeakPtr> weak = weakPtr();
+    DispatchResponse response = m_backend->evaluateBatchOnCallFrame(in_callFrameId, std::move(in_expressions), std::move(in_objectGroup), std::move(in_returnByValue), &out_results);
+    if (response.status() == DispatchResponse::kFallThrough)
+        return response.status();
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    if (response.status() == DispatchResponse::kSuccess) {
+        result->setValue("results", ValueConversions<protocol::Array<protocol::Debugger::EvaluateBatchResult>>::toValue(out_results.get()));
+    }
+    if (weak->get())
+        weak->get()->sendResponse(callId, response, std::move(result));
+    return response.status();
+}
+
 DispatchResponse::Status DispatcherImpl::setVariableValue(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
 {
     // Prepare input parameters.
@@ -25,6 +25,7 @@ class ScriptPosition;
 class CallFrame;
 class Scope;
 class SearchMatch;
+class EvaluateBatchResult;
 class ScriptParsedNotification;
 class ScriptFailedToParseNotification;
 class BreakpointResolvedNotification;
@@ -541,6 +542,79 @@ private:
 };
 
 
+class  EvaluateBatchResult : public Serializable{
+    PROTOCOL_DISALLOW_COPY(EvaluateBatchResult);
+public:
+    static std::unique_ptr<EvaluateBatchResult> fromValue(protocol::Value* value, ErrorSupport* errors);
+
+    ~EvaluateBatchResult() override { }
+
+    protocol::Runtime::RemoteObject* getResult() { return m_result.get(); }
+    void setResult(std::unique_ptr<protocol::Runtime::RemoteObject> value) { m_result = std::move(value); }
+
+    bool hasExceptionDetails() { return m_exceptionDetails.isJust(); }
+    protocol::Runtime::ExceptionDetails* getExceptionDetails(protocol::Runtime::ExceptionDetails* defaultValue) { return m_exceptionDetails.isJust() ? m_exceptionDetails.fromJust() : defaultValue; }
+    void setExceptionDetails(std::unique_ptr<protocol::Runtime::ExceptionDetails> value) { m_exceptionDetails = std::move(value); }
+
+    std::unique_ptr<protocol::DictionaryValue> toValue() const;
+    String serialize() override { return toValue()->serialize(); }
+    std::unique_ptr<EvaluateBatchResult> clone() const;
+
+    template<int STATE>
+    class EvaluateBatchResultBuilder {
+    public:
+        enum {
+            NoFieldsSet = 0,
+            ResultSet = 1 << 1,
+            AllFieldsSet = (ResultSet | 0)};
+
+
+        EvaluateBatchResultBuilder<STATE | ResultSet>& setResult(std::unique_ptr<protocol::Runtime::RemoteObject> value)
+        {
+            static_assert(!(STATE & ResultSet), "property result should not be set yet");
+            m_result->setResult(std::move(value));
+            return castState<ResultSet>();
+        }
+
+        EvaluateBatchResultBuilder<STATE>& setExceptionDetails(std::unique_ptr<protocol::Runtime::ExceptionDetails> value)
+        {
+            m_result->setExceptionDetails(std::move(value));
+            return *this;
+        }
+
+        std::unique_ptr<EvaluateBatchResult> build()
+        {
+            static_assert(STATE == AllFieldsSet, "state should be AllFieldsSet");
+            return std::move(m_result);
+        }
+
+    private:
+        friend class EvaluateBatchResult;
+        EvaluateBatchResultBuilder() : m_result(new EvaluateBatchResult()) { }
+
+        template<int STEP> EvaluateBatchResultBuilder<STATE | STEP>& castState()
+        {
+            return *reinterpret_cast<EvaluateBatchResultBuilder<STATE | STEP>*>(this);
+        }
+
+        std::unique_ptr<protocol::Debugger::EvaluateBatchResult> m_result;
+    };
+
+    static EvaluateBatchResultBuilder<0> create()
+    {
+        return EvaluateBatchResultBuilder<0>();
+    }
+
+private:
+    EvaluateBatchResult()
+    {
+    }
+
+    std::unique_ptr<protocol::Runtime::RemoteObject> m_result;
+    Maybe<protocol::Runtime::ExceptionDetails> m_exceptionDetails;
+};
+
+
 class  ScriptParsedNotification : public Serializable{
     PROTOCOL_DISALLOW_COPY(ScriptParsedNotification);
 public:
@@ -1137,6 +1211,7 @@ public:
     virtual DispatchResponse getScriptSource(const String& in_scriptId, String* out_scriptSource) = 0;
     virtual DispatchResponse setPauseOnExceptions(const String& in_state) = 0;
     virtual DispatchResponse evaluateOnCallFrame(const String& in_callFrameId, const String& in_expression, Maybe<String> in_objectGroup, Maybe<bool> in_includeCommandLineAPI, Maybe<bool> in_silent, Maybe<bool> in_returnByValue, Maybe<bool> in_generatePreview, std::unique_ptr<protocol::Runtime::RemoteObject>* out_result, Maybe<protocol::Runtime::ExceptionDetails>* out_exceptionDetails) = 0;
+    virtual DispatchResponse evaluateBatchOnCallFrame(const String& in_callFrameId, std::unique_ptr<protocol::Array<String>> in_expressions, Maybe<String> in_objectGroup, Maybe<bool> in_returnByValue, std::unique_ptr<protocol::Array<protocol::Debugger::EvaluateBatchResult>>* out_results) = 0;
     virtual DispatchResponse setVariableValue(int in_scopeNumber, const String& in_variableName, std::unique_ptr<protocol::Runtime::CallArgument> in_newValue, const String& in_callFrameId) = 0;
     virtual DispatchResponse setAsyncCallStackDepth(int in_maxDepth) = 0;
     virtual DispatchResponse setBlackboxPatterns(std::unique_ptr<protocol::Array<String>> in_patterns) = 0;
@@ -0,0 +1,287 @@
+// This file is generated
+
+// Copyright (c) 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "protocol/Performance.h"
+
+#include "protocol/Protocol.h"
+
+namespace JsDebug {
+namespace protocol {
+namespace Performance {
+
+// ------------- Enum values from types.
+
+const char Metainfo::domainName[] = "Performance";
+const char Metainfo::commandPrefix[] = "Performance.";
+const char Metainfo::version[] = "1.2";
+
+std::unique_ptr<Metric> Metric::fromValue(protocol::Value* value, ErrorSupport* errors)
+{
+    if (!value || value->type() != protocol::Value::TypeObject) {
+        errors->addError("object expected");
+        return nullptr;
+    }
+
+    std::unique_ptr<Metric> result(new Metric());
+    protocol::DictionaryValue* object = DictionaryValue::cast(value);
+    errors->push();
+    protocol::Value* nameValue = object->get("name");
+    errors->setName("name");
+    result->m_name = ValueConversions<String>::fromValue(nameValue, errors);
+    protocol::Value* valueValue = object->get("value");
+    errors->setName("value");
+    result->m_value = ValueConversions<double>::fromValue(valueValue, errors);
+    errors->pop();
+    if (errors->hasErrors())
+        return nullptr;
+    return result;
+}
+
+std::unique_ptr<protocol::DictionaryValue> Metric::toValue() const
+{
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    result->setValue("name", ValueConversions<String>::toValue(m_name));
+    result->setValue("value", ValueConversions<double>::toValue(m_value));
+    return result;
+}
+
+std::unique_ptr<Metric> Metric::clone() const
+{
+    ErrorSupport errors;
+    return fromValue(toValue().get(), &errors);
+}
+
+std::unique_ptr<MetricsNotification> MetricsNotification::fromValue(protocol::Value* value, ErrorSupport* errors)
+{
+    if (!value || value->type() != protocol::Value::TypeObject) {
+        errors->addError("object expected");
+        return nullptr;
+    }
+
+    std::unique_ptr<MetricsNotification> result(new MetricsNotification());
+    protocol::DictionaryValue* object = DictionaryValue::cast(value);
+    errors->push();
+    protocol::Value* metricsValue = object->get("metrics");
+    errors->setName("metrics");
+    result->m_metrics = ValueConversions<protocol::Array<protocol::Performance::Metric>>::fromValue(metricsValue, errors);
+    protocol::Value* titleValue = object->get("title");
+    errors->setName("title");
+    result->m_title = ValueConversions<String>::fromValue(titleValue, errors);
+    errors->pop();
+    if (errors->hasErrors())
+        return nullptr;
+    return result;
+}
+
+std::unique_ptr<protocol::DictionaryValue> MetricsNotification::toValue() const
+{
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    result->setValue("metrics", ValueConversions<protocol::Array<protocol::Performance::Metric>>::toValue(m_metrics.get()));
+    result->setValue("title", ValueConversions<String>::toValue(m_title));
+    return result;
+}
+
+std::unique_ptr<MetricsNotification> MetricsNotification::clone() const
+{
+    ErrorSupport errors;
+    return fromValue(toValue().get(), &errors);
+}
+
+std::unique_ptr<GarbageCollectionNotification> GarbageCollectionNotification::fromValue(protocol::Value* value, ErrorSupport* errors)
+{
+    if (!value || value->type() != protocol::Value::TypeObject) {
+        errors->addError("object expected");
+        return nullptr;
+    }
+
+    std::unique_ptr<GarbageCollectionNotification> result(new GarbageCollectionNotification());
+    protocol::DictionaryValue* object = DictionaryValue::cast(value);
+    errors->push();
+    protocol::Value* startTimeValue = object->get("startTime");
+    errors->setName("startTime");
+    result->m_startTime = ValueConversions<double>::fromValue(startTimeValue, errors);
+    protocol::Value* durationValue = object->get("duration");
+    errors->setName("duration");
+    result->m_duration = ValueConversions<double>::fromValue(durationValue, errors);
+    protocol::Value* usedSizeBeforeValue = object->get("usedSizeBefore");
+    errors->setName("usedSizeBefore");
+    result->m_usedSizeBefore = ValueConversions<double>::fromValue(usedSizeBeforeValue, errors);
+    protocol::Value* usedSizeAfterValue = object->get("usedSizeAfter");
+    errors->setName("usedSizeAfter");
+    result->m_usedSizeAfter = ValueConversions<double>::fromValue(usedSizeAfterValue, errors);
+    errors->pop();
+    if (errors->hasErrors())
+        return nullptr;
+    return result;
+}
+
+std::unique_ptr<protocol::DictionaryValue> GarbageCollectionNotification::toValue() const
+{
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    result->setValue("startTime", ValueConversions<double>::toValue(m_startTime));
+    result->setValue("duration", ValueConversions<double>::toValue(m_duration));
+    result->setValue("usedSizeBefore", ValueConversions<double>::toValue(m_usedSizeBefore));
+    result->setValue("usedSizeAfter", ValueConversions<double>::toValue(m_usedSizeAfter));
+    return result;
+}
+
+std::unique_ptr<GarbageCollectionNotification> GarbageCollectionNotification::clone() const
+{
+    ErrorSupport errors;
+    return fromValue(toValue().get(), &errors);
+}
+
+// ------------- Enum values from params.
+
+
+// ------------- Frontend notifications.
+
+void Frontend::metrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>> metrics, const String& title)
+{
+    if (!m_frontendChannel)
+        return;
+    std::unique_ptr<MetricsNotification> messageData = MetricsNotification::create()
+        .setMetrics(std::move(metrics))
+        .setTitle(title)
+        .build();
+    m_frontendChannel->sendProtocolNotification(InternalResponse::createNotification("Performance.metrics", std::move(messageData)));
+}
+
+void Frontend::garbageCollection(double startTime, double duration, double usedSizeBefore, double usedSizeAfter)
+{
+    if (!m_frontendChannel)
+        return;
+    std::unique_ptr<GarbageCollectionNotification> messageData = GarbageCollectionNotification::create()
+        .setStartTime(startTime)
+        .setDuration(duration)
+        .setUsedSizeBefore(usedSizeBefore)
+        .setUsedSizeAfter(usedSizeAfter)
+        .build();
+    m_frontendChannel->sendProtocolNotification(InternalResponse::createNotification("Performance.garbageCollection", std::move(messageData)));
+}
+
+void Frontend::flush()
+{
+    m_frontendChannel->flushProtocolNotifications();
+}
+
+void Frontend::sendRawNotification(const String& notification)
+{
+    m_frontendChannel->sendProtocolNotification(InternalRawNotification::create(notification));
+}
+
+// --------------------- Dispatcher.
+
+class DispatcherImpl : public protocol::DispatcherBase {
+public:
+    DispatcherImpl(FrontendChannel* frontendChannel, Backend* backend, bool fallThroughForNotFound)
+        : DispatcherBase(frontendChannel)
+        , m_backend(backend)
+        , m_fallThroughForNotFound(fallThroughForNotFound) {
+        m_dispatchMap["Performance.enable"] = &DispatcherImpl::enable;
+        m_dispatchMap["Performance.disable"] = &DispatcherImpl::disable;
+        m_dispatchMap["Performance.getMetrics"] = &DispatcherImpl::getMetrics;
+    }
+    ~DispatcherImpl() override { }
+    DispatchResponse::Status dispatch(int callId, const String& method, std::unique_ptr<protocol::DictionaryValue> messageObject) override;
+    HashMap<String, String>& redirects() { return m_redirects; }
+
+protected:
+    using CallHandler = DispatchResponse::Status (DispatcherImpl::*)(int callId, std::unique_ptr<DictionaryValue> messageObject, ErrorSupport* errors);
+    using DispatchMap = protocol::HashMap<String, CallHandler>;
+    DispatchMap m_dispatchMap;
+    HashMap<String, String> m_redirects;
+
+    DispatchResponse::Status enable(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
+    DispatchResponse::Status disable(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
+    DispatchResponse::Status getMetrics(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
+
+    Backend* m_backend;
+    bool m_fallThroughForNotFound;
+};
+
+DispatchResponse::Status DispatcherImpl::dispatch(int callId, const String& method, std::unique_ptr<protocol::DictionaryValue> messageObject)
+{
+    protocol::HashMap<String, CallHandler>::iterator it = m_dispatchMap.find(method);
+    if (it == m_dispatchMap.end()) {
+        if (m_fallThroughForNotFound)
+            return DispatchResponse::kFallThrough;
+        reportProtocolError(callId, DispatchResponse::kMethodNotFound, "'" + method + "' wasn't found", nullptr);
+        return DispatchResponse::kError;
+    }
+
+    protocol::ErrorSupport errors;
+    return (this->*(it->second))(callId, std::move(messageObject), &errors);
+}
+
+
+DispatchResponse::Status DispatcherImpl::enable(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
+{
+    // Prepare input parameters.
+    protocol::DictionaryValue* object = DictionaryValue::cast(requestMessageObject->get("params"));
+    errors->push();
+    protocol::Value* samplingIntervalValue = object ? object->get("samplingInterval") : nullptr;
+    Maybe<int> in_samplingInterval;
+    if (samplingIntervalValue) {
+        errors->setName("samplingInterval");
+        in_samplingInterval = ValueConversions<int>::fromValue(samplingIntervalValue, errors);
+    }
+    errors->pop();
+    if (errors->hasErrors()) {
+        reportProtocolError(callId, DispatchResponse::kInvalidParams, kInvalidParamsString, errors);
+        return DispatchResponse::kError;
+    }
+
+    std::unique_ptr<DispatcherBase::WeakPtr> weak = weakPtr();
+    DispatchResponse response = m_backend->enable(std::move(in_samplingInterval));
+    if (response.status() == DispatchResponse::kFallThrough)
+        return response.status();
+    if (weak->get())
+        weak->get()->sendResponse(callId, response);
+    return response.status();
+}
+
+DispatchResponse::Status DispatcherImpl::disable(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
+{
+
+    std::unique_ptr<DispatcherBase::WeakPtr> weak = weakPtr();
+    DispatchResponse response = m_backend->disable();
+    if (response.status() == DispatchResponse::kFallThrough)
+        return response.status();
+    if (weak->get())
+        weak->get()->sendResponse(callId, response);
+    return response.status();
+}
+
+DispatchResponse::Status DispatcherImpl::getMetrics(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
+{
+    // Declare output parameters.
+    std::unique_ptr<protocol::Array<protocol::Performance::Metric>> out_metrics;
+
+    std::unique_ptr<DispatcherBase::WeakPtr> weak = weakPtr();
+    DispatchResponse response = m_backend->getMetrics(&out_metrics);
+    if (response.status() == DispatchResponse::kFallThrough)
+        return response.status();
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    if (response.status() == DispatchResponse::kSuccess) {
+        result->setValue("metrics", ValueConversions<protocol::Array<protocol::Performance::Metric>>::toValue(out_metrics.get()));
+    }
+    if (weak->get())
+        weak->get()->sendResponse(callId, response, std::move(result));
+    return response.status();
+}
+
+// static
+void Dispatcher::wire(UberDispatcher* uber, Backend* backend)
+{
+    std::unique_ptr<DispatcherImpl> dispatcher(new DispatcherImpl(uber->channel(), backend, uber->fallThroughForNotFound()));
+    uber->setupRedirects(dispatcher->redirects());
+    uber->registerBackend("Performance", std::move(dispatcher));
+}
+
+} // Performance
+} // namespace JsDebug
+} // namespace protocol
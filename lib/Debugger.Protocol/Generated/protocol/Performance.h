@@ -0,0 +1,328 @@
+// This file is generated
+
+// Copyright (c) 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef JsDebug_protocol_Performance_h
+#define JsDebug_protocol_Performance_h
+
+#include "protocol/Protocol.h"
+// For each imported domain we generate a ValueConversions struct instead of a full domain definition
+// and include Domain::API version from there.
+
+namespace JsDebug {
+namespace protocol {
+namespace Performance {
+
+// ------------- Forward and enum declarations.
+class Metric;
+class MetricsNotification;
+class GarbageCollectionNotification;
+
+// ------------- Type and builder declarations.
+
+class  Metric : public Serializable{
+    PROTOCOL_DISALLOW_COPY(Metric);
+public:
+    static std::unique_ptr<Metric> fromValue(protocol::Value* value, ErrorSupport* errors);
+
+    ~Metric() override { }
+
+    String getName() { return m_name; }
+    void setName(const String& value) { m_name = value; }
+
+    double getValue() { return m_value; }
+    void setValue(double value) { m_value = value; }
+
+    std::unique_ptr<protocol::DictionaryValue> toValue() const;
+    String serialize() override { return toValue()->serialize(); }
+    std::unique_ptr<Metric> clone() const;
+
+    template<int STATE>
+    class MetricBuilder {
+    public:
+        enum {
+            NoFieldsSet = 0,
+            NameSet = 1 << 1,
+            ValueSet = 1 << 2,
+            AllFieldsSet = (NameSet | ValueSet | 0)};
+
+
+        MetricBuilder<STATE | NameSet>& setName(const String& value)
+        {
+            static_assert(!(STATE & NameSet), "property name should not be set yet");
+            m_result->setName(value);
+            return castState<NameSet>();
+        }
+
+        MetricBuilder<STATE | ValueSet>& setValue(double value)
+        {
+            static_assert(!(STATE & ValueSet), "property value should not be set yet");
+            m_result->setValue(value);
+            return castState<ValueSet>();
+        }
+
+        std::unique_ptr<Metric> build()
+        {
+            static_assert(STATE == AllFieldsSet, "state should be AllFieldsSet");
+            return std::move(m_result);
+        }
+
+    private:
+        friend class Metric;
+        MetricBuilder() : m_result(new Metric()) { }
+
+        template<int STEP> MetricBuilder<STATE | STEP>& castState()
+        {
+            return *reinterpret_cast<MetricBuilder<STATE | STEP>*>(this);
+        }
+
+        std::unique_ptr<protocol::Performance::Metric> m_result;
+    };
+
+    static MetricBuilder<0> create()
+    {
+        return MetricBuilder<0>();
+    }
+
+private:
+    Metric()
+    {
+          m_value = 0;
+    }
+
+    String m_name;
+    double m_value;
+};
+
+
+class  MetricsNotification : public Serializable{
+    PROTOCOL_DISALLOW_COPY(MetricsNotification);
+public:
+    static std::unique_ptr<MetricsNotification> fromValue(protocol::Value* value, ErrorSupport* errors);
+
+    ~MetricsNotification() override { }
+
+    protocol::Array<protocol::Performance::Metric>* getMetrics() { return m_metrics.get(); }
+    void setMetrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>> value) { m_metrics = std::move(value); }
+
+    String getTitle() { return m_title; }
+    void setTitle(const String& value) { m_title = value; }
+
+    std::unique_ptr<protocol::DictionaryValue> toValue() const;
+    String serialize() override { return toValue()->serialize(); }
+    std::unique_ptr<MetricsNotification> clone() const;
+
+    template<int STATE>
+    class MetricsNotificationBuilder {
+    public:
+        enum {
+            NoFieldsSet = 0,
+            MetricsSet = 1 << 1,
+            TitleSet = 1 << 2,
+            AllFieldsSet = (MetricsSet | TitleSet | 0)};
+
+
+        MetricsNotificationBuilder<STATE | MetricsSet>& setMetrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>> value)
+        {
+            static_assert(!(STATE & MetricsSet), "property metrics should not be set yet");
+            m_result->setMetrics(std::move(value));
+            return castState<MetricsSet>();
+        }
+
+        MetricsNotificationBuilder<STATE | TitleSet>& setTitle(const String& value)
+        {
+            static_assert(!(STATE & TitleSet), "property title should not be set yet");
+            m_result->setTitle(value);
+            return castState<TitleSet>();
+        }
+
+        std::unique_ptr<MetricsNotification> build()
+        {
+            static_assert(STATE == AllFieldsSet, "state should be AllFieldsSet");
+            return std::move(m_result);
+        }
+
+    private:
+        friend class MetricsNotification;
+        MetricsNotificationBuilder() : m_result(new MetricsNotification()) { }
+
+        template<int STEP> MetricsNotificationBuilder<STATE | STEP>& castState()
+        {
+            return *reinterpret_cast<MetricsNotificationBuilder<STATE | STEP>*>(this);
+        }
+
+        std::unique_ptr<protocol::Performance::MetricsNotification> m_result;
+    };
+
+    static MetricsNotificationBuilder<0> create()
+    {
+        return MetricsNotificationBuilder<0>();
+    }
+
+private:
+    MetricsNotification()
+    {
+    }
+
+    std::unique_ptr<protocol::Array<protocol::Performance::Metric>> m_metrics;
+    String m_title;
+};
+
+
+class  GarbageCollectionNotification : public Serializable{
+    PROTOCOL_DISALLOW_COPY(GarbageCollectionNotification);
+public:
+    static std::unique_ptr<GarbageCollectionNotification> fromValue(protocol::Value* value, ErrorSupport* errors);
+
+    ~GarbageCollectionNotification() override { }
+
+    double getStartTime() { return m_startTime; }
+    void setStartTime(double value) { m_startTime = value; }
+
+    double getDuration() { return m_duration; }
+    void setDuration(double value) { m_duration = value; }
+
+    double getUsedSizeBefore() { return m_usedSizeBefore; }
+    void setUsedSizeBefore(double value) { m_usedSizeBefore = value; }
+
+    double getUsedSizeAfter() { return m_usedSizeAfter; }
+    void setUsedSizeAfter(double value) { m_usedSizeAfter = value; }
+
+    std::unique_ptr<protocol::DictionaryValue> toValue() const;
+    String serialize() override { return toValue()->serialize(); }
+    std::unique_ptr<GarbageCollectionNotification> clone() const;
+
+    template<int STATE>
+    class GarbageCollectionNotificationBuilder {
+    public:
+        enum {
+            NoFieldsSet = 0,
+            StartTimeSet = 1 << 1,
+            DurationSet = 1 << 2,
+            UsedSizeBeforeSet = 1 << 3,
+            UsedSizeAfterSet = 1 << 4,
+            AllFieldsSet = (StartTimeSet | DurationSet | UsedSizeBeforeSet | UsedSizeAfterSet | 0)};
+
+
+        GarbageCollectionNotificationBuilder<STATE | StartTimeSet>& setStartTime(double value)
+        {
+            static_assert(!(STATE & StartTimeSet), "property startTime should not be set yet");
+            m_result->setStartTime(value);
+            return castState<StartTimeSet>();
+        }
+
+        GarbageCollectionNotificationBuilder<STATE | DurationSet>& setDuration(double value)
+        {
+            static_assert(!(STATE & DurationSet), "property duration should not be set yet");
+            m_result->setDuration(value);
+            return castState<DurationSet>();
+        }
+
+        GarbageCollectionNotificationBuilder<STATE | UsedSizeBeforeSet>& setUsedSizeBefore(double value)
+        {
+            static_assert(!(STATE & UsedSizeBeforeSet), "property usedSizeBefore should not be set yet");
+            m_result->setUsedSizeBefore(value);
+            return castState<UsedSizeBeforeSet>();
+        }
+
+        GarbageCollectionNotificationBuilder<STATE | UsedSizeAfterSet>& setUsedSizeAfter(double value)
+        {
+            static_assert(!(STATE & UsedSizeAfterSet), "property usedSizeAfter should not be set yet");
+            m_result->setUsedSizeAfter(value);
+            return castState<UsedSizeAfterSet>();
+        }
+
+        std::unique_ptr<GarbageCollectionNotification> build()
+        {
+            static_assert(STATE == AllFieldsSet, "state should be AllFieldsSet");
+            return std::move(m_result);
+        }
+
+    private:
+        friend class GarbageCollectionNotification;
+        GarbageCollectionNotificationBuilder() : m_result(new GarbageCollectionNotification()) { }
+
+        template<int STEP> GarbageCollectionNotificationBuilder<STATE | STEP>& castState()
+        {
+            return *reinterpret_cast<GarbageCollectionNotificationBuilder<STATE | STEP>*>(this);
+        }
+
+        std::unique_ptr<protocol::Performance::GarbageCollectionNotification> m_result;
+    };
+
+    static GarbageCollectionNotificationBuilder<0> create()
+    {
+        return GarbageCollectionNotificationBuilder<0>();
+    }
+
+private:
+    GarbageCollectionNotification()
+    {
+          m_startTime = 0;
+          m_duration = 0;
+          m_usedSizeBefore = 0;
+          m_usedSizeAfter = 0;
+    }
+
+    double m_startTime;
+    double m_duration;
+    double m_usedSizeBefore;
+    double m_usedSizeAfter;
+};
+
+
+// ------------- Backend interface.
+
+class  Backend {
+public:
+    virtual ~Backend() { }
+
+    virtual DispatchResponse enable(Maybe<int> in_samplingInterval) = 0;
+    virtual DispatchResponse disable() = 0;
+    virtual DispatchResponse getMetrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>>* out_metrics) = 0;
+
+};
+
+// ------------- Frontend interface.
+
+class  Frontend {
+public:
+    explicit Frontend(FrontendChannel* frontendChannel) : m_frontendChannel(frontendChannel) { }
+    void metrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>> metrics, const String& title);
+    void garbageCollection(double startTime, double duration, double usedSizeBefore, double usedSizeAfter);
+
+    void flush();
+    void sendRawNotification(const String&);
+private:
+    FrontendChannel* m_frontendChannel;
+};
+
+// ------------- Dispatcher.
+
+class  Dispatcher {
+public:
+    static void wire(UberDispatcher*, Backend*);
+
+private:
+    Dispatcher() { }
+};
+
+// ------------- Metainfo.
+
+class  Metainfo {
+public:
+    using BackendClass = Backend;
+    using FrontendClass = Frontend;
+    using DispatcherClass = Dispatcher;
+    static const char domainName[];
+    static const char commandPrefix[];
+    static const char version[];
+};
+
+} // namespace Performance
+} // namespace JsDebug
+} // namespace protocol
+
+#endif // !defined(JsDebug_protocol_Performance_h)
@@ -0,0 +1,165 @@
+// This file is generated
+
+// Copyright (c) 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "protocol/Session.h"
+
+#include "protocol/Protocol.h"
+
+namespace JsDebug {
+namespace protocol {
+namespace Session {
+
+// ------------- Enum values from types.
+
+const char Metainfo::domainName[] = "Session";
+const char Metainfo::commandPrefix[] = "Session.";
+const char Metainfo::version[] = "1.2";
+
+std::unique_ptr<TargetBusyNotification> TargetBusyNotification::fromValue(protocol::Value* value, ErrorSupport* errors)
+{
+    if (!value || value->type() != protocol::Value::TypeObject) {
+        errors->addError("object expected");
+        return nullptr;
+    }
+
+    std::unique_ptr<TargetBusyNotification> result(new TargetBusyNotification());
+    protocol::DictionaryValue* object = DictionaryValue::cast(value);
+    errors->push();
+    protocol::Value* busyTimeValue = object->get("busyTime");
+    errors->setName("busyTime");
+    result->m_busyTime = ValueConversions<double>::fromValue(busyTimeValue, errors);
+    protocol::Value* queuedCommandsValue = object->get("queuedCommands");
+    errors->setName("queuedCommands");
+    result->m_queuedCommands = ValueConversions<int>::fromValue(queuedCommandsValue, errors);
+    protocol::Value* eventsValue = object->get("events");
+    errors->setName("events");
+    result->m_events = ValueConversions<protocol::Array<protocol::DictionaryValue>>::fromValue(eventsValue, errors);
+    errors->pop();
+    if (errors->hasErrors())
+        return nullptr;
+    return result;
+}
+
+std::unique_ptr<protocol::DictionaryValue> TargetBusyNotification::toValue() const
+{
+    std::unique_ptr<protocol::DictionaryValue> result = DictionaryValue::create();
+    result->setValue("busyTime", ValueConversions<double>::toValue(m_busyTime));
+    result->setValue("queuedCommands", ValueConversions<int>::toValue(m_queuedCommands));
+    result->setValue("events", ValueConversions<protocol::Array<protocol::DictionaryValue>>::toValue(m_events.get()));
+    return result;
+}
+
+std::unique_ptr<TargetBusyNotification> TargetBusyNotification::clone() const
+{
+    ErrorSupport errors;
+    return fromValue(toValue().get(), &errors);
+}
+
+// ------------- Enum values from params.
+
+
+// ------------- Frontend notifications.
+
+void Frontend::targetBusy(double busyTime, int queuedCommands, std::unique_ptr<protocol::Array<protocol::DictionaryValue>> events)
+{
+    if (!m_frontendChannel)
+        return;
+    std::unique_ptr<TargetBusyNotification> messageData = TargetBusyNotification::create()
+        .setBusyTime(busyTime)
+        .setQueuedCommands(queuedCommands)
+        .setEvents(std::move(events))
+        .build();
+    m_frontendChannel->sendProtocolNotification(InternalResponse::createNotification("Session.targetBusy", std::move(messageData)));
+}
+
+void Frontend::flush()
+{
+    m_frontendChannel->flushProtocolNotifications();
+}
+
+void Frontend::sendRawNotification(const String& notification)
+{
+    m_frontendChannel->sendProtocolNotification(InternalRawNotification::create(notification));
+}
+
+// --------------------- Dispatcher.
+
+class DispatcherImpl : public protocol::DispatcherBase {
+public:
+    DispatcherImpl(FrontendChannel* frontendChannel, Backend* backend, bool fallThroughForNotFound)
+        : DispatcherBase(frontendChannel)
+        , m_backend(backend)
+        , m_fallThroughForNotFound(fallThroughForNotFound) {
+        m_dispatchMap["Session.setEventMask"] = &DispatcherImpl::setEventMask;
+    }
+    ~DispatcherImpl() override { }
+    DispatchResponse::Status dispatch(int callId, const String& method, std::unique_ptr<protocol::DictionaryValue> messageObject) override;
+    HashMap<String, String>& redirects() { return m_redirects; }
+
+protected:
+    using CallHandler = DispatchResponse::Status (DispatcherImpl::*)(int callId, std::unique_ptr<DictionaryValue> messageObject, ErrorSupport* errors);
+    using DispatchMap = protocol::HashMap<String, CallHandler>;
+    DispatchMap m_dispatchMap;
+    HashMap<String, String> m_redirects;
+
+    DispatchResponse::Status setEventMask(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport*);
+
+    Backend* m_backend;
+    bool m_fallThroughForNotFound;
+};
+
+DispatchResponse::Status DispatcherImpl::dispatch(int callId, const String& method, std::unique_ptr<protocol::DictionaryValue> messageObject)
+{
+    protocol::HashMap<String, CallHandler>::iterator it = m_dispatchMap.find(method);
+    if (it == m_dispatchMap.end()) {
+        if (m_fallThroughForNotFound)
+            return DispatchResponse::kFallThrough;
+        reportProtocolError(callId, DispatchResponse::kMethodNotFound, "'" + method + "' wasn't found", nullptr);
+        return DispatchResponse::kError;
+    }
+
+    protocol::ErrorSupport errors;
+    return (this->*(it->second))(callId, std::move(messageObject), &errors);
+}
+
+
+DispatchResponse::Status DispatcherImpl::setEventMask(int callId, std::unique_ptr<DictionaryValue> requestMessageObject, ErrorSupport* errors)
+{
+    // Prepare input parameters.
+    protocol::DictionaryValue* object = DictionaryValue::cast(requestMessageObject->get("params"));
+    errors->push();
+    protocol::Value* eventsValue = object ? object->get("events") : nullptr;
+    Maybe<protocol::Array<String>> in_events;
+    if (eventsValue) {
+        errors->setName("events");
+        in_events = ValueConversions<protocol::Array<String>>::fromValue(eventsValue, errors);
+    }
+    errors->pop();
+    if (errors->hasErrors()) {
+        reportProtocolError(callId, DispatchResponse::kInvalidParams, kInvalidParamsString, errors);
+        return DispatchResponse::kError;
+    }
+
+    std::unique_ptr<DispatcherBase::WeakPtr> weak = weakPtr();
+    DispatchResponse response = m_backend->setEventMask(std::move(in_events));
+    if (response.status() == DispatchResponse::kFallThrough)
+        return response.status();
+    if (weak->get())
+        weak->get()->sendResponse(callId, response);
+    return response.status();
+}
+
+// static
+void Dispatcher::wire(UberDispatcher* uber, Backend* backend)
+{
+    std::unique_ptr<DispatcherImpl> dispatcher(new DispatcherImpl(uber->channel(), backend, uber->fallThroughForNotFound()));
+    uber->setupRedirects(dispatcher->redirects());
+    uber->registerBackend("Session", std::move(dispatcher));
+}
+
+} // Session
+} // namespace JsDebug
+} // namespace protocol
@@ -0,0 +1,160 @@
+// This file is generated
+
+// Copyright (c) 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef JsDebug_protocol_Session_h
+#define JsDebug_protocol_Session_h
+
+#include "protocol/Protocol.h"
+// For each imported domain we generate a ValueConversions struct instead of a full domain definition
+// and include Domain::API version from there.
+
+namespace JsDebug {
+namespace protocol {
+namespace Session {
+
+// ------------- Forward and enum declarations.
+class TargetBusyNotification;
+
+// ------------- Type and builder declarations.
+
+class  TargetBusyNotification : public Serializable{
+    PROTOCOL_DISALLOW_COPY(TargetBusyNotification);
+public:
+    static std::unique_ptr<TargetBusyNotification> fromValue(protocol::Value* value, ErrorSupport* errors);
+
+    ~TargetBusyNotification() override { }
+
+    double getBusyTime() { return m_busyTime; }
+    void setBusyTime(double value) { m_busyTime = value; }
+
+    int getQueuedCommands() { return m_queuedCommands; }
+    void setQueuedCommands(int value) { m_queuedCommands = value; }
+
+    protocol::Array<protocol::DictionaryValue>* getEvents() { return m_events.get(); }
+    void setEvents(std::unique_ptr<protocol::Array<protocol::DictionaryValue>> value) { m_events = std::move(value); }
+
+    std::unique_ptr<protocol::DictionaryValue> toValue() const;
+    String serialize() override { return toValue()->serialize(); }
+    std::unique_ptr<TargetBusyNotification> clone() const;
+
+    template<int STATE>
+    class TargetBusyNotificationBuilder {
+    public:
+        enum {
+            NoFieldsSet = 0,
+            BusyTimeSet = 1 << 1,
+            QueuedCommandsSet = 1 << 2,
+            EventsSet = 1 << 3,
+            AllFieldsSet = (BusyTimeSet | QueuedCommandsSet | EventsSet | 0)};
+
+
+        TargetBusyNotificationBuilder<STATE | BusyTimeSet>& setBusyTime(double value)
+        {
+            static_assert(!(STATE & BusyTimeSet), "property busyTime should not be set yet");
+            m_result->setBusyTime(value);
+            return castState<BusyTimeSet>();
+        }
+
+        TargetBusyNotificationBuilder<STATE | QueuedCommandsSet>& setQueuedCommands(int value)
+        {
+            static_assert(!(STATE & QueuedCommandsSet), "property queuedCommands should not be set yet");
+            m_result->setQueuedCommands(value);
+            return castState<QueuedCommandsSet>();
+        }
+
+        TargetBusyNotificationBuilder<STATE | EventsSet>& setEvents(std::unique_ptr<protocol::Array<protocol::DictionaryValue>> value)
+        {
+            static_assert(!(STATE & EventsSet), "property events should not be set yet");
+            m_result->setEvents(std::move(value));
+            return castState<EventsSet>();
+        }
+
+        std::unique_ptr<TargetBusyNotification> build()
+        {
+            static_assert(STATE == AllFieldsSet, "state should be AllFieldsSet");
+            return std::move(m_result);
+        }
+
+    private:
+        friend class TargetBusyNotification;
+        TargetBusyNotificationBuilder() : m_result(new TargetBusyNotification()) { }
+
+        template<int STEP> TargetBusyNotificationBuilder<STATE | STEP>& castState()
+        {
+            return *reinterpret_cast<TargetBusyNotificationBuilder<STATE | STEP>*>(this);
+        }
+
+        std::unique_ptr<protocol::Session::TargetBusyNotification> m_result;
+    };
+
+    static TargetBusyNotificationBuilder<0> create()
+    {
+        return TargetBusyNotificationBuilder<0>();
+    }
+
+private:
+    TargetBusyNotification()
+    {
+          m_busyTime = 0;
+          m_queuedCommands = 0;
+    }
+
+    double m_busyTime;
+    int m_queuedCommands;
+    std::unique_ptr<protocol::Array<protocol::DictionaryValue>> m_events;
+};
+
+
+// ------------- Backend interface.
+
+class  Backend {
+public:
+    virtual ~Backend() { }
+
+    virtual DispatchResponse setEventMask(Maybe<protocol::Array<String>> in_events) = 0;
+
+};
+
+// ------------- Frontend interface.
+
+class  Frontend {
+public:
+    explicit Frontend(FrontendChannel* frontendChannel) : m_frontendChannel(frontendChannel) { }
+    void targetBusy(double busyTime, int queuedCommands, std::unique_ptr<protocol::Array<protocol::DictionaryValue>> events);
+
+    void flush();
+    void sendRawNotification(const String&);
+private:
+    FrontendChannel* m_frontendChannel;
+};
+
+// ------------- Dispatcher.
+
+class  Dispatcher {
+public:
+    static void wire(UberDispatcher*, Backend*);
+
+private:
+    Dispatcher() { }
+};
+
+// ------------- Metainfo.
+
+class  Metainfo {
+public:
+    using BackendClass = Backend;
+    using FrontendClass = Frontend;
+    using DispatcherClass = Dispatcher;
+    static const char domainName[];
+    static const char commandPrefix[];
+    static const char version[];
+};
+
+} // namespace Session
+} // namespace JsDebug
+} // namespace protocol
+
+#endif // !defined(JsDebug_protocol_Session_h)
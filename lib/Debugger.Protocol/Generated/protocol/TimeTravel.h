@@ -0,0 +1,79 @@
+// This file is generated
+
+// Copyright (c) 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef JsDebug_protocol_TimeTravel_h
+#define JsDebug_protocol_TimeTravel_h
+
+#include "protocol/Protocol.h"
+// For each imported domain we generate a ValueConversions struct instead of a full domain definition
+// and include Domain::API version from there.
+
+namespace JsDebug {
+namespace protocol {
+namespace TimeTravel {
+
+// ------------- Forward and enum declarations.
+
+// ------------- Type and builder declarations.
+
+// ------------- Backend interface.
+
+class  Backend {
+public:
+    virtual ~Backend() { }
+
+    class  WriteTTDLogCallback {
+    public:
+        virtual void sendSuccess() = 0;
+        virtual void sendFailure(const DispatchResponse&) = 0;
+        virtual void fallThrough() = 0;
+        virtual ~WriteTTDLogCallback() { }
+    };
+    virtual void writeTTDLog(const String& in_uri, std::unique_ptr<WriteTTDLogCallback> callback) = 0;
+    virtual DispatchResponse stepBack() = 0;
+    virtual DispatchResponse reverse() = 0;
+
+};
+
+// ------------- Frontend interface.
+
+class  Frontend {
+public:
+    explicit Frontend(FrontendChannel* frontendChannel) : m_frontendChannel(frontendChannel) { }
+
+    void flush();
+    void sendRawNotification(const String&);
+private:
+    FrontendChannel* m_frontendChannel;
+};
+
+// ------------- Dispatcher.
+
+class  Dispatcher {
+public:
+    static void wire(UberDispatcher*, Backend*);
+
+private:
+    Dispatcher() { }
+};
+
+// ------------- Metainfo.
+
+class  Metainfo {
+public:
+    using BackendClass = Backend;
+    using FrontendClass = Frontend;
+    using DispatcherClass = Dispatcher;
+    static const char domainName[];
+    static const char commandPrefix[];
+    static const char version[];
+};
+
+} // namespace TimeTravel
+} // namespace JsDebug
+} // namespace protocol
+
+#endif // !defined(JsDebug_protocol_TimeTravel_h)
@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "AllocationProfile.h"
+
+#include "Debugger.h"
+#include "PropertyHelpers.h"
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::HeapProfiler::SamplingHeapProfile;
+    using protocol::HeapProfiler::SamplingHeapProfileNode;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_RootFunctionName[] = "(root)";
+        const uint32_t c_RootFunction = UINT32_MAX;
+    }
+
+    AllocationProfile::AllocationProfile()
+        : m_isStarted(false)
+    {
+    }
+
+    void AllocationProfile::Start()
+    {
+        m_functions.Clear();
+        m_nodes.clear();
+        m_nodes.push_back(Node { c_RootFunction, 0 });
+
+        m_isStarted = true;
+    }
+
+    void AllocationProfile::Stop()
+    {
+        m_isStarted = false;
+    }
+
+    bool AllocationProfile::IsStarted() const
+    {
+        return m_isStarted;
+    }
+
+    void AllocationProfile::AddSample(size_t size)
+    {
+        if (!m_isStarted)
+        {
+            return;
+        }
+
+        size_t node = 0;
+
+        // Only function handles are read from each frame, outermost first.
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        if (JsDiagGetStackTrace(&stackTrace) == JsNoError)
+        {
+            int length = PropertyHelpers::GetPropertyInt(stackTrace, PropertyHelpers::Names::Length);
+
+            for (int index = length; index > 0; --index)
+            {
+                JsValueRef callFrame = PropertyHelpers::GetIndexedProperty(stackTrace, index - 1);
+                uint32_t function = m_functions.Intern(
+                    PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::FunctionHandle));
+
+                auto child = m_nodes[node].children.find(function);
+                if (child != m_nodes[node].children.end())
+                {
+                    node = child->second;
+                }
+                else
+                {
+                    m_nodes.push_back(Node { function, 0 });
+                    m_nodes[node].children.emplace(function, m_nodes.size() - 1);
+                    node = m_nodes.size() - 1;
+                }
+            }
+        }
+
+        m_nodes[node].selfSize += static_cast<double>(size);
+    }
+
+    std::unique_ptr<SamplingHeapProfile> AllocationProfile::ToProtocolValue(Debugger* debugger) const
+    {
+        std::unique_ptr<SamplingHeapProfileNode> head;
+
+        if (m_nodes.empty())
+        {
+            head = SamplingHeapProfileNode::create()
+                .setCallFrame(FunctionTable::SyntheticCallFrame(c_RootFunctionName))
+                .setSelfSize(0)
+                .setChildren(Array<SamplingHeapProfileNode>::create())
+                .build();
+        }
+        else
+        {
+            head = ToProtocolValue(0, m_functions.GetScriptUrls(debugger));
+        }
+
+        return SamplingHeapProfile::create()
+            .setHead(std::move(head))
+            .build();
+    }
+
+    std::unique_ptr<SamplingHeapProfileNode> AllocationProfile::ToProtocolValue(
+        size_t node,
+        const std::map<int, String>& scriptUrls) const
+    {
+        auto children = Array<SamplingHeapProfileNode>::create();
+        for (const auto& child : m_nodes[node].children)
+        {
+            children->addItem(ToProtocolValue(child.second, scriptUrls));
+        }
+
+        return SamplingHeapProfileNode::create()
+            .setCallFrame(m_nodes[node].function == c_RootFunction
+                ? FunctionTable::SyntheticCallFrame(c_RootFunctionName)
+                : m_functions.ToCallFrame(m_nodes[node].function, scriptUrls))
+            .setSelfSize(m_nodes[node].selfSize)
+            .setChildren(std::move(children))
+            .build();
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\HeapProfiler.h>
+
+#include <ChakraCore.h>
+
+#include "FunctionTable.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace JsDebug
+{
+    class Debugger;
+
+    /// <summary>
+    /// Allocated bytes charged to the call stacks that were running when they
+    /// were sampled. The tree is kept as it grows, since allocation samples are
+    /// far rarer than CPU samples and share most of their stacks.
+    /// </summary>
+    class AllocationProfile
+    {
+    public:
+        AllocationProfile();
+        AllocationProfile(const AllocationProfile&) = delete;
+        AllocationProfile& operator=(const AllocationProfile&) = delete;
+
+        void Start();
+        void Stop();
+        bool IsStarted() const;
+
+        // Should be called while the engine is at a break. Without a script
+        // stack to inspect, the bytes are charged to the root.
+        void AddSample(size_t size);
+
+        std::unique_ptr<protocol::HeapProfiler::SamplingHeapProfile> ToProtocolValue(Debugger* debugger) const;
+
+    private:
+        struct Node
+        {
+            uint32_t function;
+            double selfSize;
+            std::map<uint32_t, size_t> children;
+        };
+
+        std::unique_ptr<protocol::HeapProfiler::SamplingHeapProfileNode> ToProtocolValue(
+            size_t node,
+            const std::map<int, protocol::String>& scriptUrls) const;
+
+        bool m_isStarted;
+        FunctionTable m_functions;
+
+        // The first node is the root.
+        std::vector<Node> m_nodes;
+    };
+}
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace JsDebug
+{
+    // Fixed size queue that any thread can push to and pop from without taking
+    // a lock. Each slot carries a sequence number saying whose turn it is, so a
+    // push or pop only contends on the index it advances. Pushes fail rather
+    // than wait when the queue is full.
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        // The capacity is rounded up to a power of two.
+        explicit BoundedQueue(size_t capacity)
+            : m_mask(RoundUp(capacity) - 1)
+            , m_slots(new Slot[m_mask + 1])
+            , m_head(0)
+            , m_tail(0)
+        {
+            for (size_t i = 0; i <= m_mask; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        bool TryPush(const T& value)
+        {
+            size_t position = m_tail.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                Slot& slot = m_slots[position & m_mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0)
+                {
+                    if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = value;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool TryPop(T* value)
+        {
+            size_t position = m_head.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                Slot& slot = m_slots[position & m_mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (difference == 0)
+                {
+                    if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        *value = slot.value;
+                        slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        static size_t RoundUp(size_t capacity)
+        {
+            size_t size = 1;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+
+            return size;
+        }
+
+        const size_t m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+    };
+}
@@ -58,6 +58,48 @@ CHAKRA_API JsDebugProtocolHandlerDisconnect(JsDebugProtocolHandler protocolHandl
         });
 }
 
+CHAKRA_API JsDebugProtocolHandlerConnectObserver(
+    JsDebugProtocolHandler protocolHandler,
+    JsDebugProtocolHandlerSendResponseCallback callback,
+    void* callbackState,
+    unsigned int* sessionId)
+{
+    if (sessionId == nullptr)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            *sessionId = instance->ConnectObserver(callback, callbackState);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerDisconnectObserver(JsDebugProtocolHandler protocolHandler, unsigned int sessionId)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->DisconnectObserver(sessionId);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerSendObserverCommand(
+    JsDebugProtocolHandler protocolHandler,
+    unsigned int sessionId,
+    const char* command)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->SendObserverCommand(sessionId, command);
+        });
+}
+
 CHAKRA_API JsDebugProtocolHandlerSendCommand(JsDebugProtocolHandler protocolHandler, const char* command)
 {
     return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
@@ -88,6 +130,36 @@ CHAKRA_API JsDebugConsoleAPIEvent(_In_ JsDebugProtocolHandler protocolHandler, _
     });
 }
 
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskScheduled(JsDebugProtocolHandler protocolHandler, JsValueRef task)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->AsyncTaskScheduled(task);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskStarted(JsDebugProtocolHandler protocolHandler, JsValueRef task)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->AsyncTaskStarted(task);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskFinished(JsDebugProtocolHandler protocolHandler, JsValueRef task)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->AsyncTaskFinished(task);
+        });
+}
+
 CHAKRA_API JsDebugProtocolHandlerWaitForDebugger(JsDebugProtocolHandler protocolHandler)
 {
     return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
@@ -120,3 +192,88 @@ CHAKRA_API JsDebugProtocolHandlerSetCommandQueueCallback(
             instance->SetCommandQueueCallback(callback, callbackState);
         });
 }
+
+CHAKRA_API JsDebugProtocolHandlerGetStatistics(
+    JsDebugProtocolHandler protocolHandler,
+    JsDebugProtocolHandlerStatistics* statistics)
+{
+    if (statistics == nullptr)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            const JsDebug::HandlerStatistics& counters = instance->GetStatistics();
+            int64_t now = JsDebug::HandlerStatistics::Now();
+            int64_t queueWaitStartTime = counters.queueWaitStartTime;
+            int64_t pauseStartTime = counters.pauseStartTime;
+            uint64_t pausedMicroseconds = counters.pausedMicroseconds;
+
+            if (pauseStartTime != 0 && now > pauseStartTime)
+            {
+                pausedMicroseconds += now - pauseStartTime;
+            }
+
+            statistics->queuedCommands = counters.queuedCommands;
+            statistics->isBreakPending = counters.isBreakPending;
+            statistics->isPaused = pauseStartTime != 0;
+            statistics->scriptCount = counters.scriptCount;
+            statistics->breakpointCount = counters.breakpointCount;
+            statistics->retainedValueCount = counters.retainedValueCount;
+            statistics->bytesReceived = counters.bytesReceived;
+            statistics->bytesSent = counters.bytesSent;
+            statistics->pausedMicroseconds = pausedMicroseconds;
+            statistics->retainedBytes = counters.RetainedBytes();
+            statistics->busyMicroseconds = queueWaitStartTime != 0 && now > queueWaitStartTime ? now - queueWaitStartTime : 0;
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerSetMemoryBudget(JsDebugProtocolHandler protocolHandler, unsigned long long maxBytes)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->SetMemoryBudget(maxBytes);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerSetRuntimeMemoryCallbacks(
+    JsDebugProtocolHandler protocolHandler,
+    JsMemoryAllocationCallback allocationCallback,
+    JsBeforeCollectCallback beforeCollectCallback,
+    void* callbackState)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->SetRuntimeMemoryCallbacks(allocationCallback, beforeCollectCallback, callbackState);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerEnableBusyStatus(JsDebugProtocolHandler protocolHandler, bool enable)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->EnableBusyStatus(enable);
+        });
+}
+
+CHAKRA_API JsDebugProtocolHandlerGetBusyStatus(
+    JsDebugProtocolHandler protocolHandler,
+    JsDebugProtocolHandlerSendResponseCallback callback,
+    void* callbackState)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::ProtocolHandler*>(
+        protocolHandler,
+        [&](JsDebug::ProtocolHandler* instance) -> void
+        {
+            instance->GetBusyStatus(callback, callbackState);
+        });
+}
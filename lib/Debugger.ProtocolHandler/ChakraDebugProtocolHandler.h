@@ -11,6 +11,33 @@ typedef void(CHAKRA_CALLBACK* JsDebugProtocolHandlerSendResponseCallback)(
     _In_opt_ void* callbackState);
 typedef void(CHAKRA_CALLBACK* JsDebugProtocolHandlerCommandQueueCallback)(_In_opt_ void* callbackState);
 
+/// <summary>Counters describing the work a protocol handler is doing.</summary>
+typedef struct JsDebugProtocolHandlerStatistics
+{
+    /// <summary>Commands received but not yet processed.</summary>
+    unsigned int queuedCommands;
+    /// <summary>Whether a break has been requested that the engine has not yet taken.</summary>
+    bool isBreakPending;
+    /// <summary>Whether the engine is currently paused in the debugger.</summary>
+    bool isPaused;
+    /// <summary>Scripts held for the Debugger domain.</summary>
+    unsigned int scriptCount;
+    /// <summary>Breakpoints set through the Debugger domain.</summary>
+    unsigned int breakpointCount;
+    /// <summary>Engine values the handler keeps alive: inspected objects, script sources, pinned console arguments, compiled scripts and scheduled async tasks.</summary>
+    unsigned int retainedValueCount;
+    /// <summary>Bytes of commands received from all sessions.</summary>
+    unsigned long long bytesReceived;
+    /// <summary>Bytes of responses and notifications sent to all sessions.</summary>
+    unsigned long long bytesSent;
+    /// <summary>Total time spent paused, including the current pause.</summary>
+    unsigned long long pausedMicroseconds;
+    /// <summary>Bytes held for debugging sessions, which is what the memory budget is checked against.</summary>
+    unsigned long long retainedBytes;
+    /// <summary>How long queued commands have waited without the script thread taking any.</summary>
+    unsigned long long busyMicroseconds;
+} JsDebugProtocolHandlerStatistics;
+
 /// <summary>Creates a <seealso cref="JsDebugProtocolHandler" /> instance for a given runtime.</summary>
 /// <remarks>
 ///     It also implicitly enables debugging on the given runtime, so it will need to only be done when the engine is
@@ -50,6 +77,45 @@ CHAKRA_API JsDebugProtocolHandlerConnect(
 /// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
 CHAKRA_API JsDebugProtocolHandlerDisconnect(_In_ JsDebugProtocolHandler protocolHandler);
 
+/// <summary>Connect a read-only observer to the protocol handler.</summary>
+/// <remarks>
+///     Any number of observers may be connected alongside the primary connection. Each is sent the same
+///     notifications, serialized once, and the responses to its own commands. Observers may only send commands
+///     that inspect state. The callback must not call back into the protocol handler.
+/// </remarks>
+/// <param name="protocolHandler">The instance to connect to.</param>
+/// <param name="callback">The response callback function pointer.</param>
+/// <param name="callbackState">The state object to return on each invocation of the callback.</param>
+/// <param name="sessionId">The id that identifies the observer in later calls.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerConnectObserver(
+    _In_ JsDebugProtocolHandler protocolHandler,
+    _In_ JsDebugProtocolHandlerSendResponseCallback callback,
+    _In_opt_ void* callbackState,
+    _Out_ unsigned int* sessionId);
+
+/// <summary>Disconnect an observer from the protocol handler.</summary>
+/// <remarks>
+///     The observer's callback is not called again once this returns.
+/// </remarks>
+/// <param name="protocolHandler">The instance to disconnect from.</param>
+/// <param name="sessionId">The observer to disconnect.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerDisconnectObserver(_In_ JsDebugProtocolHandler protocolHandler, _In_ unsigned int sessionId);
+
+/// <summary>Send an incoming JSON-formatted command from an observer to the protocol handler.</summary>
+/// <remarks>
+///     The response will be returned asynchronously, to the observer only.
+/// </remarks>
+/// <param name="protocolHandler">The receiving protocol handler.</param>
+/// <param name="sessionId">The observer sending the command.</param>
+/// <param name="command">The JSON-formatted command to send.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerSendObserverCommand(
+    _In_ JsDebugProtocolHandler protocolHandler,
+    _In_ unsigned int sessionId,
+    _In_z_ const char* command);
+
 /// <summary>Send an incoming JSON-formatted command to the protocol handler.</summary>
 /// <remarks>
 ///     The response will be returned asynchronously.
@@ -73,6 +139,35 @@ CHAKRA_API JsDebugProtocolHandlerSendRequest(_In_ JsDebugProtocolHandler protoco
 CHAKRA_API JsDebugConsoleAPIEvent(_In_ JsDebugProtocolHandler protocolHandler, _In_z_ const char* type, 
     _In_ const JsValueRef* argv, _In_ unsigned short argc);
 
+/// <summary>Notify the protocol handler that an asynchronous task was scheduled.</summary>
+/// <remarks>
+///     This must be called from the script thread, such as from the promise continuation
+///     callback. While async call stacks are enabled, the task is kept alive until it starts,
+///     and the script stack is read when the engine reaches the next statement.
+/// </remarks>
+/// <param name="protocolHandler">The protocol handler to notify.</param>
+/// <param name="task">The task that was scheduled.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskScheduled(_In_ JsDebugProtocolHandler protocolHandler, _In_ JsValueRef task);
+
+/// <summary>Notify the protocol handler that a scheduled task is about to run.</summary>
+/// <remarks>
+///     This must be called from the script thread.
+/// </remarks>
+/// <param name="protocolHandler">The protocol handler to notify.</param>
+/// <param name="task">The task that is starting.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskStarted(_In_ JsDebugProtocolHandler protocolHandler, _In_ JsValueRef task);
+
+/// <summary>Notify the protocol handler that a running task has finished.</summary>
+/// <remarks>
+///     This must be called from the script thread.
+/// </remarks>
+/// <param name="protocolHandler">The protocol handler to notify.</param>
+/// <param name="task">The task that finished.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerAsyncTaskFinished(_In_ JsDebugProtocolHandler protocolHandler, _In_ JsValueRef task);
+
 /// <summary>Blocks the current thread until the debugger has connected.</summary>
 /// <remarks>
 ///     This must be called from the script thread.
@@ -101,3 +196,79 @@ CHAKRA_API JsDebugProtocolHandlerSetCommandQueueCallback(
     _In_ JsDebugProtocolHandler protocolHandler,
     _In_ JsDebugProtocolHandlerCommandQueueCallback callback,
     _In_opt_ void* callbackState);
+
+/// <summary>Reads the protocol handler's statistics.</summary>
+/// <remarks>
+///     This can be called from any thread, including while the engine is running script. It takes no locks, so each
+///     value is current but the set is not guaranteed to be consistent with each other.
+/// </remarks>
+/// <param name="protocolHandler">The instance to read.</param>
+/// <param name="statistics">The statistics.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerGetStatistics(
+    _In_ JsDebugProtocolHandler protocolHandler,
+    _Out_ JsDebugProtocolHandlerStatistics* statistics);
+
+/// <summary>Limits the memory the protocol handler holds for debugging sessions.</summary>
+/// <remarks>
+///     Queued commands, the script sources it holds, console history, compiled scripts and the notifications kept for
+///     busy status are counted against the budget. The metadata kept per script, such as its URL, and responses the
+///     host has been given but not yet delivered are not counted. When the budget is exceeded, script sources are
+///     evicted and read again from the engine when needed, then the notifications kept for busy status are dropped,
+///     then console history is dropped. If that is not enough, the session is sent an <c>Inspector.detached</c> notification and closed, and further
+///     commands fail until the host disconnects. The budget is enforced on the script thread the next time the
+///     command queue is processed. This can be called from any thread.
+/// </remarks>
+/// <param name="protocolHandler">The instance to limit.</param>
+/// <param name="maxBytes">The budget in bytes, or zero for no limit.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerSetMemoryBudget(_In_ JsDebugProtocolHandler protocolHandler, _In_ unsigned long long maxBytes);
+
+/// <summary>Registers the host's runtime memory callbacks with the protocol handler.</summary>
+/// <remarks>
+///     The runtime holds one allocation callback and one before-collect callback, and has no way to read either back.
+///     The protocol handler installs its own while memory is monitored or collections are timed, so a host that uses
+///     these callbacks must register them here rather than with <c>JsSetRuntimeMemoryAllocationCallback</c> and
+///     <c>JsSetRuntimeBeforeCollectCallback</c>. While the handler holds a slot it calls the host's callback from its
+///     own, including any veto of an allocation; at other times, and once the handler is destroyed, the host's
+///     callback is installed directly. This must be called from the script thread.
+/// </remarks>
+/// <param name="protocolHandler">The instance to register the callbacks on.</param>
+/// <param name="allocationCallback">The allocation callback, or null for none.</param>
+/// <param name="beforeCollectCallback">The before-collect callback, or null for none.</param>
+/// <param name="callbackState">The state object to return on each invocation of either callback.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerSetRuntimeMemoryCallbacks(
+    _In_ JsDebugProtocolHandler protocolHandler,
+    _In_opt_ JsMemoryAllocationCallback allocationCallback,
+    _In_opt_ JsBeforeCollectCallback beforeCollectCallback,
+    _In_opt_ void* callbackState);
+
+/// <summary>Keeps the notifications that describe the target so they can be included in its busy status.</summary>
+/// <remarks>
+///     While enabled, the most recent script notifications and the current pause are kept and counted against the
+///     memory budget. Disabling drops them. Only notifications sent after it is enabled are kept. This can be called
+///     from any thread.
+/// </remarks>
+/// <param name="protocolHandler">The instance to configure.</param>
+/// <param name="enable">Whether to keep the notifications.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerEnableBusyStatus(_In_ JsDebugProtocolHandler protocolHandler, _In_ bool enable);
+
+/// <summary>Builds a notification with the last known state of the target, for the host to deliver.</summary>
+/// <remarks>
+///     This is for use when the script thread has stopped answering, such as during a long native call. The
+///     <c>Session.targetBusy</c> notification carries how long commands have waited and, if busy status is enabled,
+///     the script and pause notifications that describe the target. It is passed to the callback on the calling
+///     thread and is not sent to any session or counted in the statistics, so the host decides which connections get
+///     it. The queued commands are still answered once the script thread gets to them. The callback is not called if
+///     no commands are waiting. This can be called from any thread.
+/// </remarks>
+/// <param name="protocolHandler">The instance to report on.</param>
+/// <param name="callback">The callback to pass the notification to.</param>
+/// <param name="callbackState">The state object to return on the callback.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugProtocolHandlerGetBusyStatus(
+    _In_ JsDebugProtocolHandler protocolHandler,
+    _In_ JsDebugProtocolHandlerSendResponseCallback callback,
+    _In_opt_ void* callbackState);
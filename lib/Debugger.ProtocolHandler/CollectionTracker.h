@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace JsDebug
+{
+    struct GarbageCollection
+    {
+        // Microseconds on the steady clock.
+        int64_t startTime;
+        int64_t endTime;
+        size_t memoryUsageBefore;
+        size_t memoryUsageAfter;
+    };
+
+    /// <summary>
+    /// Source of garbage collection timings, for consumers that only need to
+    /// know when the collector ran and not how memory is tracked.
+    /// </summary>
+    class CollectionTracker
+    {
+    public:
+        // Time garbage collections while at least one caller is tracking.
+        virtual void StartCollectionTracking() = 0;
+        virtual void StopCollectionTracking() = 0;
+
+        // Must be called on the engine thread. Returns the collections that
+        // started at or after the given time and are still in the history,
+        // oldest first.
+        virtual std::vector<GarbageCollection> GetCollections(int64_t since) = 0;
+
+    protected:
+        ~CollectionTracker() = default;
+    };
+}
@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "ConsoleAggregator.h"
+
+#include <cstring>
+
+namespace JsDebug
+{
+    namespace
+    {
+        const wchar_t c_DefaultLabel[] = L"default";
+        const wchar_t c_DefaultGroupLabel[] = L"console.group";
+
+        // Labels are usually a handful of literals. Script that builds a new
+        // one per call is cut off here rather than growing without bound.
+        const size_t c_MaxCounters = 1000;
+        const size_t c_MaxTimers = 1000;
+
+        // Rough cost of a map node beyond the characters of its label.
+        const uint64_t c_LabelEntryBytes = 64;
+
+        bool IsType(const char* type, const char* name)
+        {
+            return strcmp(type, name) == 0;
+        }
+    }
+
+    ConsoleAggregator::ConsoleAggregator(std::atomic<uint64_t>* retainedBytes)
+        : m_hasDirtyCounters(false)
+        , m_groupDepth(0)
+        , m_labelBytes(0)
+        , m_retainedBytes(retainedBytes)
+    {
+    }
+
+    bool ConsoleAggregator::HandleEvent(
+        const char* type,
+        const JsValueRef* argv,
+        unsigned short argc,
+        std::vector<Summary>* summaries)
+    {
+        if (IsType(type, "count"))
+        {
+            // Counting is the hot path: bump the counter and report the latest
+            // value on the next flush.
+            std::wstring label = GetLabel(argv, argc);
+            auto counter = m_counters.find(label);
+
+            if (counter == m_counters.end())
+            {
+                if (m_counters.size() >= c_MaxCounters)
+                {
+                    Flush(summaries);
+                    summaries->push_back({ "warning", L"Too many counters; '" + label + L"' is not counted" });
+                    return true;
+                }
+
+                UpdateRetainedBytes(m_labelBytes, m_labelBytes + GetLabelBytes(label));
+                counter = m_counters.emplace(std::move(label), Counter { 0, false }).first;
+            }
+
+            ++counter->second.count;
+            counter->second.isDirty = true;
+            m_hasDirtyCounters = true;
+            return true;
+        }
+
+        if (IsType(type, "time"))
+        {
+            std::wstring label = GetLabel(argv, argc);
+            auto now = std::chrono::steady_clock::now();
+
+            if (m_timers.find(label) != m_timers.end())
+            {
+                Flush(summaries);
+                summaries->push_back({ "warning", L"Timer '" + label + L"' already exists" });
+            }
+            else if (m_timers.size() >= c_MaxTimers)
+            {
+                Flush(summaries);
+                summaries->push_back({ "warning", L"Too many timers; '" + label + L"' is not started" });
+            }
+            else
+            {
+                UpdateRetainedBytes(m_labelBytes, m_labelBytes + GetLabelBytes(label));
+                m_timers.emplace(label, now);
+            }
+
+            return true;
+        }
+
+        if (IsType(type, "timeEnd"))
+        {
+            auto now = std::chrono::steady_clock::now();
+            std::wstring label = GetLabel(argv, argc);
+
+            Flush(summaries);
+
+            auto timer = m_timers.find(label);
+            if (timer == m_timers.end())
+            {
+                summaries->push_back({ "warning", L"Timer '" + label + L"' does not exist" });
+                return true;
+            }
+
+            std::chrono::duration<double, std::milli> elapsed = now - timer->second;
+            UpdateRetainedBytes(m_labelBytes, m_labelBytes - GetLabelBytes(label));
+            m_timers.erase(timer);
+
+            wchar_t elapsedBuf[64];
+            swprintf_s(elapsedBuf, L": %.3fms", elapsed.count());
+            summaries->push_back({ "timeEnd", label + elapsedBuf });
+            return true;
+        }
+
+        if (IsType(type, "countReset"))
+        {
+            std::wstring label = GetLabel(argv, argc);
+            auto counter = m_counters.find(label);
+
+            if (counter == m_counters.end())
+            {
+                Flush(summaries);
+                summaries->push_back({ "warning", L"Count for '" + label + L"' does not exist" });
+                return true;
+            }
+
+            counter->second.count = 0;
+            counter->second.isDirty = false;
+            return true;
+        }
+
+        bool isGroup = IsType(type, "group") || IsType(type, "startGroup");
+        bool isGroupCollapsed = IsType(type, "groupCollapsed") || IsType(type, "startGroupCollapsed");
+
+        if (isGroup || isGroupCollapsed)
+        {
+            // Counts logged so far belong outside of the new group.
+            Flush(summaries);
+
+            std::wstring label = argc > 0 ? GetLabel(argv, argc) : c_DefaultGroupLabel;
+            summaries->push_back({ isGroup ? "startGroup" : "startGroupCollapsed", label });
+            ++m_groupDepth;
+            return true;
+        }
+
+        if (IsType(type, "groupEnd") || IsType(type, "endGroup"))
+        {
+            // Unbalanced calls are dropped rather than confusing the frontend.
+            if (m_groupDepth > 0)
+            {
+                Flush(summaries);
+                summaries->push_back({ "endGroup", std::wstring() });
+                --m_groupDepth;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void ConsoleAggregator::Flush(std::vector<Summary>* summaries)
+    {
+        if (!m_hasDirtyCounters)
+        {
+            return;
+        }
+
+        for (auto& counter : m_counters)
+        {
+            if (counter.second.isDirty)
+            {
+                summaries->push_back({ "count", counter.first + L": " + std::to_wstring(counter.second.count) });
+                counter.second.isDirty = false;
+            }
+        }
+
+        m_hasDirtyCounters = false;
+    }
+
+    void ConsoleAggregator::Reset()
+    {
+        m_timers.clear();
+        m_counters.clear();
+        m_hasDirtyCounters = false;
+        m_groupDepth = 0;
+        UpdateRetainedBytes(m_labelBytes, 0);
+    }
+
+    std::wstring ConsoleAggregator::GetLabel(const JsValueRef* argv, unsigned short argc)
+    {
+        if (argc == 0)
+        {
+            return c_DefaultLabel;
+        }
+
+        JsValueType type = JsUndefined;
+        if (JsGetValueType(argv[0], &type) != JsNoError || type == JsUndefined)
+        {
+            return c_DefaultLabel;
+        }
+
+        JsValueRef labelValue = JS_INVALID_REFERENCE;
+        const wchar_t* label = nullptr;
+        size_t length = 0;
+
+        if (JsConvertValueToString(argv[0], &labelValue) != JsNoError ||
+            JsStringToPointer(labelValue, &label, &length) != JsNoError)
+        {
+            return c_DefaultLabel;
+        }
+
+        return std::wstring(label, length);
+    }
+
+    uint64_t ConsoleAggregator::GetLabelBytes(const std::wstring& label)
+    {
+        return label.length() * sizeof(wchar_t) + c_LabelEntryBytes;
+    }
+
+    void ConsoleAggregator::UpdateRetainedBytes(uint64_t oldBytes, uint64_t newBytes)
+    {
+        m_labelBytes = newBytes;
+
+        if (m_retainedBytes != nullptr && oldBytes != newBytes)
+        {
+            *m_retainedBytes += newBytes;
+            *m_retainedBytes -= oldBytes;
+        }
+    }
+}
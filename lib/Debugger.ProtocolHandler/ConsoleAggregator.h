@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <ChakraCore.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace JsDebug
+{
+    // Implements the timing, counting and grouping console methods natively so
+    // that hot code calling them only reports summaries to the frontend. The
+    // number of live counters and timers is capped, and the memory for their
+    // labels is added to retainedBytes.
+    class ConsoleAggregator
+    {
+    public:
+        struct Summary
+        {
+            const char* type;
+            std::wstring text;
+        };
+
+        explicit ConsoleAggregator(std::atomic<uint64_t>* retainedBytes);
+        ConsoleAggregator(const ConsoleAggregator&) = delete;
+        ConsoleAggregator& operator=(const ConsoleAggregator&) = delete;
+
+        // Returns true if the event was consumed. Anything that must be reported
+        // right away is appended to summaries.
+        bool HandleEvent(const char* type, const JsValueRef* argv, unsigned short argc, std::vector<Summary>* summaries);
+
+        // Appends the current value of every counter touched since the last flush.
+        void Flush(std::vector<Summary>* summaries);
+
+        void Reset();
+
+    private:
+        struct Counter
+        {
+            unsigned int count;
+            bool isDirty;
+        };
+
+        static std::wstring GetLabel(const JsValueRef* argv, unsigned short argc);
+        static uint64_t GetLabelBytes(const std::wstring& label);
+
+        void UpdateRetainedBytes(uint64_t oldBytes, uint64_t newBytes);
+
+        std::unordered_map<std::wstring, std::chrono::steady_clock::time_point> m_timers;
+        std::unordered_map<std::wstring, Counter> m_counters;
+        bool m_hasDirtyCounters;
+        unsigned int m_groupDepth;
+        uint64_t m_labelBytes;
+        std::atomic<uint64_t>* m_retainedBytes;
+    };
+}
@@ -0,0 +1,310 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "ConsoleBuffer.h"
+
+#include "ProtocolHelpers.h"
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::Runtime::RemoteObject;
+    using protocol::String;
+
+    ConsoleBuffer::ConsoleBuffer(
+        size_t capacity,
+        std::atomic<uint64_t>* retainedBytes,
+        std::atomic<uint32_t>* retainedValues)
+        : m_entries(capacity)
+        , m_head(0)
+        , m_count(0)
+        , m_droppedCount(0)
+        , m_retainedBytes(retainedBytes)
+        , m_retainedValues(retainedValues)
+    {
+    }
+
+    void ConsoleBuffer::Capture(const char* type, const JsValueRef* argv, unsigned short argc, bool pinObjects)
+    {
+        Entry& entry = AllocateEntry(type, argc);
+        size_t capacity = entry.payload.capacity();
+
+        try
+        {
+            for (unsigned short i = 0; i < argc; ++i)
+            {
+                CaptureArg(entry, entry.args[i], argv[i], pinObjects);
+            }
+        }
+        catch (...)
+        {
+            // The slot was never published, so only what it pinned is undone.
+            UpdateRetainedBytes(capacity, entry.payload.capacity());
+            ReleaseEntry(entry);
+            throw;
+        }
+
+        UpdateRetainedBytes(capacity, entry.payload.capacity());
+        PublishEntry();
+    }
+
+    void ConsoleBuffer::CaptureText(const char* type, const std::wstring& text)
+    {
+        Entry& entry = AllocateEntry(type, text.empty() ? 0 : 1);
+        size_t capacity = entry.payload.capacity();
+
+        if (!text.empty())
+        {
+            static_assert(sizeof(wchar_t) == sizeof(UChar));
+            entry.payload = String(reinterpret_cast<const UChar*>(text.c_str()), text.length()).toUtf8();
+
+            Arg& arg = entry.args[0];
+            arg.type = ArgType::String;
+            arg.offset = 0;
+            arg.length = entry.payload.length();
+        }
+
+        UpdateRetainedBytes(capacity, entry.payload.capacity());
+        PublishEntry();
+    }
+
+    bool ConsoleBuffer::IsEmpty() const
+    {
+        return m_count == 0;
+    }
+
+    size_t ConsoleBuffer::GetCount() const
+    {
+        return m_count;
+    }
+
+    size_t ConsoleBuffer::GetDroppedCount() const
+    {
+        return m_droppedCount;
+    }
+
+    void ConsoleBuffer::ReleaseObjects()
+    {
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            Entry& entry = m_entries[(m_head + i) % m_entries.size()];
+
+            for (unsigned short j = 0; j < entry.argCount; ++j)
+            {
+                ReleaseArg(entry.args[j]);
+            }
+        }
+    }
+
+    void ConsoleBuffer::Clear()
+    {
+        while (m_count > 0)
+        {
+            ReleaseEntry(m_entries[m_head]);
+            m_head = (m_head + 1) % m_entries.size();
+            --m_count;
+        }
+
+        m_head = 0;
+
+        for (Entry& entry : m_entries)
+        {
+            UpdateRetainedBytes(entry.payload.capacity(), 0);
+            std::string().swap(entry.payload);
+        }
+    }
+
+    ConsoleBuffer::Entry& ConsoleBuffer::AllocateEntry(const char* type, unsigned short argc)
+    {
+        if (m_count == m_entries.size())
+        {
+            // Overwrite the oldest entry rather than growing.
+            ReleaseEntry(m_entries[m_head]);
+            m_head = (m_head + 1) % m_entries.size();
+            --m_count;
+            ++m_droppedCount;
+        }
+
+        // The slot is filled in before it is counted, so a capture that fails
+        // part way never leaves a half built entry to be sent.
+        Entry& entry = m_entries[(m_head + m_count) % m_entries.size()];
+
+        // Assigning into the existing strings and vector keeps their capacity,
+        // so steady state logging does not allocate.
+        entry.type.assign(type);
+        entry.payload.clear();
+        entry.argCount = argc;
+
+        if (entry.args.size() < argc)
+        {
+            entry.args.resize(argc);
+        }
+
+        return entry;
+    }
+
+    void ConsoleBuffer::PublishEntry()
+    {
+        ++m_count;
+    }
+
+    void ConsoleBuffer::CaptureArg(Entry& entry, Arg& arg, JsValueRef value, bool pinObjects)
+    {
+        arg.number = 0;
+        arg.offset = 0;
+        arg.length = 0;
+
+        JsValueType valueType = JsUndefined;
+        IfJsErrorThrow(JsGetValueType(value, &valueType));
+
+        switch (valueType)
+        {
+        case JsUndefined:
+            arg.type = ArgType::Undefined;
+            break;
+
+        case JsNull:
+            arg.type = ArgType::Null;
+            break;
+
+        case JsBoolean:
+        {
+            bool boolValue = false;
+            IfJsErrorThrow(JsBooleanToBool(value, &boolValue));
+            arg.type = ArgType::Boolean;
+            arg.number = boolValue ? 1 : 0;
+            break;
+        }
+
+        case JsNumber:
+            arg.type = ArgType::Number;
+            IfJsErrorThrow(JsNumberToDouble(value, &arg.number));
+            break;
+
+        case JsString:
+        {
+            size_t length = 0;
+            IfJsErrorThrow(JsCopyString(value, nullptr, 0, &length));
+
+            arg.type = ArgType::String;
+            arg.offset = entry.payload.length();
+            arg.length = length;
+
+            entry.payload.resize(arg.offset + length);
+            IfJsErrorThrow(JsCopyString(value, &entry.payload[arg.offset], length, nullptr));
+            break;
+        }
+
+        default:
+            arg.type = valueType == JsFunction ? ArgType::Function : ArgType::Object;
+
+            if (pinObjects)
+            {
+                arg.object = value;
+
+                if (m_retainedValues != nullptr)
+                {
+                    m_retainedValues->fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            break;
+        }
+    }
+
+    void ConsoleBuffer::ReleaseEntry(Entry& entry)
+    {
+        for (unsigned short i = 0; i < entry.argCount; ++i)
+        {
+            ReleaseArg(entry.args[i]);
+        }
+
+        entry.argCount = 0;
+    }
+
+    void ConsoleBuffer::ReleaseArg(Arg& arg)
+    {
+        if (!arg.object.IsEmpty())
+        {
+            arg.object = JsPersistent();
+
+            if (m_retainedValues != nullptr)
+            {
+                m_retainedValues->fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void ConsoleBuffer::UpdateRetainedBytes(size_t oldCapacity, size_t newCapacity)
+    {
+        if (m_retainedBytes != nullptr && oldCapacity != newCapacity)
+        {
+            *m_retainedBytes += newCapacity;
+            *m_retainedBytes -= oldCapacity;
+        }
+    }
+
+    std::unique_ptr<Array<RemoteObject>> ConsoleBuffer::ToProtocolArgs(const Entry& entry) const
+    {
+        auto args = Array<RemoteObject>::create();
+
+        for (unsigned short i = 0; i < entry.argCount; ++i)
+        {
+            const Arg& arg = entry.args[i];
+
+            switch (arg.type)
+            {
+            case ArgType::Undefined:
+                args->addItem(ProtocolHelpers::GetUndefinedObject());
+                break;
+
+            case ArgType::Null:
+                args->addItem(RemoteObject::create()
+                    .setType("object")
+                    .setSubtype("null")
+                    .setValue(protocol::Value::null())
+                    .build());
+                break;
+
+            case ArgType::Boolean:
+                args->addItem(RemoteObject::create()
+                    .setType("boolean")
+                    .setValue(protocol::FundamentalValue::create(arg.number != 0))
+                    .build());
+                break;
+
+            case ArgType::Number:
+                args->addItem(RemoteObject::create()
+                    .setType("number")
+                    .setValue(protocol::FundamentalValue::create(arg.number))
+                    .setDescription(String::fromDouble(arg.number))
+                    .build());
+                break;
+
+            case ArgType::String:
+                args->addItem(RemoteObject::create()
+                    .setType("string")
+                    .setValue(protocol::StringValue::create(String::fromUtf8(entry.payload.data() + arg.offset, arg.length)))
+                    .build());
+                break;
+
+            default:
+                if (!arg.object.IsEmpty())
+                {
+                    args->addItem(ProtocolHelpers::WrapValue(arg.object.Get()));
+                }
+                else
+                {
+                    // The object was not kept alive, so only its type is known.
+                    args->addItem(RemoteObject::create()
+                        .setType(arg.type == ArgType::Function ? "function" : "object")
+                        .setDescription(arg.type == ArgType::Function ? "function" : "Object")
+                        .build());
+                }
+                break;
+            }
+        }
+
+        return args;
+    }
+}
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "JsPersistent.h"
+
+#include <protocol\Runtime.h>
+#include <ChakraCore.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace JsDebug
+{
+    // Fixed size ring of console messages waiting to be sent to the frontend.
+    // Primitive arguments are captured natively as a type tag plus a UTF-8
+    // payload; entries and their storage are reused once they have been sent.
+    // The storage held, and the number of objects pinned, are kept in optional
+    // counters that other threads may read.
+    class ConsoleBuffer
+    {
+    public:
+        explicit ConsoleBuffer(
+            size_t capacity,
+            std::atomic<uint64_t>* retainedBytes = nullptr,
+            std::atomic<uint32_t>* retainedValues = nullptr);
+        ConsoleBuffer(const ConsoleBuffer&) = delete;
+        ConsoleBuffer& operator=(const ConsoleBuffer&) = delete;
+
+        // Records a console call. Object arguments are only kept alive when
+        // pinObjects is set; otherwise just their type is recorded.
+        void Capture(const char* type, const JsValueRef* argv, unsigned short argc, bool pinObjects);
+        void CaptureText(const char* type, const std::wstring& text);
+
+        bool IsEmpty() const;
+        size_t GetCount() const;
+        size_t GetDroppedCount() const;
+
+        // Hands every pending entry, oldest first, to the handler as protocol
+        // arguments and then frees the slots for reuse.
+        template <typename Handler>
+        void Drain(Handler&& handler)
+        {
+            while (m_count > 0)
+            {
+                Entry& entry = m_entries[m_head];
+                handler(entry.type.c_str(), ToProtocolArgs(entry));
+
+                ReleaseEntry(entry);
+                m_head = (m_head + 1) % m_entries.size();
+                --m_count;
+            }
+        }
+
+        void ReleaseObjects();
+
+        // Drops every pending entry and frees the storage kept for reuse.
+        void Clear();
+
+    private:
+        enum class ArgType : uint8_t
+        {
+            Undefined,
+            Null,
+            Boolean,
+            Number,
+            String,
+            Object,
+            Function,
+        };
+
+        struct Arg
+        {
+            ArgType type;
+            double number;
+            size_t offset;
+            size_t length;
+            JsPersistent object;
+        };
+
+        struct Entry
+        {
+            std::string type;
+            std::vector<Arg> args;
+            unsigned short argCount;
+            std::string payload;
+        };
+
+        Entry& AllocateEntry(const char* type, unsigned short argc);
+        void PublishEntry();
+        void CaptureArg(Entry& entry, Arg& arg, JsValueRef value, bool pinObjects);
+        void ReleaseEntry(Entry& entry);
+        void ReleaseArg(Arg& arg);
+        void UpdateRetainedBytes(size_t oldCapacity, size_t newCapacity);
+        std::unique_ptr<protocol::Array<protocol::Runtime::RemoteObject>> ToProtocolArgs(const Entry& entry) const;
+
+        std::vector<Entry> m_entries;
+        size_t m_head;
+        size_t m_count;
+        size_t m_droppedCount;
+        std::atomic<uint64_t>* m_retainedBytes;
+        std::atomic<uint32_t>* m_retainedValues;
+    };
+}
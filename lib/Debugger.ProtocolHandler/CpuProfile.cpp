@@ -0,0 +1,279 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "CpuProfile.h"
+
+#include "Debugger.h"
+#include "PropertyHelpers.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::Profiler::PositionTickInfo;
+    using protocol::Profiler::Profile;
+    using protocol::Profiler::ProfileNode;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_RootFunctionName[] = "(root)";
+        const uint32_t c_RootFunction = UINT32_MAX;
+        const char c_GarbageCollectorFunctionName[] = "(garbage collector)";
+        const uint32_t c_GarbageCollectorFunction = UINT32_MAX - 1;
+
+        // Bounds a recording to a few tens of megabytes, which is several
+        // minutes of deep stacks at the default rate.
+        const size_t c_MaxSamples = 1000000;
+        const size_t c_MaxFrames = 4000000;
+
+        struct Node
+        {
+            uint32_t function;
+            int hitCount;
+            std::map<uint32_t, size_t> children;
+            std::map<int, int> lineTicks;
+        };
+    }
+
+    CpuProfile::CpuProfile()
+        : m_isStarted(false)
+        , m_isFull(false)
+        , m_startTime(0)
+        , m_endTime(0)
+    {
+    }
+
+    void CpuProfile::Start()
+    {
+        m_functions.Clear();
+        m_framePositions.clear();
+        m_frames.clear();
+        m_samples.clear();
+
+        m_isStarted = true;
+        m_isFull = false;
+        m_startTime = Now();
+        m_endTime = m_startTime;
+    }
+
+    void CpuProfile::Stop()
+    {
+        if (m_isStarted)
+        {
+            m_isStarted = false;
+
+            if (!m_isFull)
+            {
+                m_endTime = Now();
+            }
+        }
+    }
+
+    bool CpuProfile::IsStarted() const
+    {
+        return m_isStarted;
+    }
+
+    int64_t CpuProfile::StartTime() const
+    {
+        return m_startTime;
+    }
+
+    bool CpuProfile::IsFull() const
+    {
+        return m_isFull;
+    }
+
+    void CpuProfile::AddSample()
+    {
+        if (!m_isStarted || m_isFull)
+        {
+            return;
+        }
+
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        if (JsDiagGetStackTrace(&stackTrace) != JsNoError)
+        {
+            return;
+        }
+
+        int length = PropertyHelpers::GetPropertyInt(stackTrace, PropertyHelpers::Names::Length);
+        int64_t timestamp = Now();
+
+        if (m_samples.size() >= c_MaxSamples || m_frames.size() + length > c_MaxFrames)
+        {
+            m_isFull = true;
+            m_endTime = timestamp;
+            return;
+        }
+
+        size_t frameOffset = m_frames.size();
+
+        for (int index = 0; index < length; ++index)
+        {
+            JsValueRef callFrame = PropertyHelpers::GetIndexedProperty(stackTrace, index);
+            int scriptId = PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::ScriptId);
+            int line = PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Line);
+            int column = PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Column);
+
+            m_frames.push_back(Frame { GetFunction(callFrame, scriptId, line, column), line });
+        }
+
+        m_samples.push_back(Sample { frameOffset, static_cast<uint32_t>(length), timestamp });
+    }
+
+    uint32_t CpuProfile::GetFunction(JsValueRef callFrame, int scriptId, int line, int column)
+    {
+        auto position = std::make_tuple(scriptId, line, column);
+        auto existing = m_framePositions.find(position);
+
+        if (existing != m_framePositions.end())
+        {
+            return existing->second;
+        }
+
+        int functionHandle = PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::FunctionHandle);
+        uint32_t function = m_functions.Intern(functionHandle);
+
+        m_framePositions.emplace(position, function);
+        return function;
+    }
+
+    std::unique_ptr<Profile> CpuProfile::ToProtocolValue(
+        Debugger* debugger,
+        const std::vector<GarbageCollection>& collections) const
+    {
+        // Replay the samples into a call tree. Node ids are the index plus one,
+        // and the first node is the root.
+        std::vector<Node> tree;
+        tree.push_back(Node { c_RootFunction, 0 });
+
+        auto samples = Array<int>::create();
+        auto timeDeltas = Array<int>::create();
+        int64_t lastTimestamp = m_startTime;
+
+        size_t collectorNode = 0;
+        size_t nextCollection = 0;
+        auto addCollectionsBefore = [&](int64_t timestamp)
+        {
+            for (; nextCollection < collections.size() && collections[nextCollection].startTime < timestamp; ++nextCollection)
+            {
+                if (collectorNode == 0)
+                {
+                    tree.push_back(Node { c_GarbageCollectorFunction, 0 });
+                    collectorNode = tree.size() - 1;
+                    tree[0].children.emplace(c_GarbageCollectorFunction, collectorNode);
+                }
+
+                int64_t startTime = std::max(collections[nextCollection].startTime, lastTimestamp);
+                tree[collectorNode].hitCount++;
+                samples->addItem(static_cast<int>(collectorNode + 1));
+                timeDeltas->addItem(static_cast<int>(startTime - lastTimestamp));
+                lastTimestamp = startTime;
+            }
+        };
+
+        for (const Sample& sample : m_samples)
+        {
+            addCollectionsBefore(sample.timestamp);
+
+            size_t node = 0;
+
+            for (uint32_t i = sample.frameCount; i > 0; --i)
+            {
+                uint32_t function = m_frames[sample.frameOffset + i - 1].function;
+                auto child = tree[node].children.find(function);
+
+                if (child != tree[node].children.end())
+                {
+                    node = child->second;
+                }
+                else
+                {
+                    tree.push_back(Node { function, 0 });
+                    tree[node].children.emplace(function, tree.size() - 1);
+                    node = tree.size() - 1;
+                }
+            }
+
+            tree[node].hitCount++;
+
+            if (sample.frameCount > 0)
+            {
+                // Position ticks use 1-based lines.
+                tree[node].lineTicks[m_frames[sample.frameOffset].line + 1]++;
+            }
+
+            samples->addItem(static_cast<int>(node + 1));
+            timeDeltas->addItem(static_cast<int>(sample.timestamp - lastTimestamp));
+            lastTimestamp = sample.timestamp;
+        }
+
+        int64_t endTime = m_isStarted && !m_isFull ? Now() : m_endTime;
+        addCollectionsBefore(endTime);
+
+        std::map<int, String> scriptUrls = m_functions.GetScriptUrls(debugger);
+
+        auto nodes = Array<ProfileNode>::create();
+
+        for (size_t index = 0; index < tree.size(); ++index)
+        {
+            const Node& node = tree[index];
+            std::unique_ptr<protocol::Runtime::CallFrame> callFrame;
+
+            if (node.function == c_RootFunction)
+            {
+                callFrame = FunctionTable::SyntheticCallFrame(c_RootFunctionName);
+            }
+            else if (node.function == c_GarbageCollectorFunction)
+            {
+                callFrame = FunctionTable::SyntheticCallFrame(c_GarbageCollectorFunctionName);
+            }
+            else
+            {
+                callFrame = m_functions.ToCallFrame(node.function, scriptUrls);
+            }
+
+            auto children = Array<int>::create();
+            for (const auto& child : node.children)
+            {
+                children->addItem(static_cast<int>(child.second + 1));
+            }
+
+            auto positionTicks = Array<PositionTickInfo>::create();
+            for (const auto& lineTicks : node.lineTicks)
+            {
+                positionTicks->addItem(PositionTickInfo::create()
+                    .setLine(lineTicks.first)
+                    .setTicks(lineTicks.second)
+                    .build());
+            }
+
+            nodes->addItem(ProfileNode::create()
+                .setId(static_cast<int>(index + 1))
+                .setCallFrame(std::move(callFrame))
+                .setHitCount(node.hitCount)
+                .setChildren(std::move(children))
+                .setPositionTicks(std::move(positionTicks))
+                .build());
+        }
+
+        return Profile::create()
+            .setNodes(std::move(nodes))
+            .setStartTime(static_cast<double>(m_startTime))
+            .setEndTime(static_cast<double>(endTime))
+            .setSamples(std::move(samples))
+            .setTimeDeltas(std::move(timeDeltas))
+            .build();
+    }
+
+    int64_t CpuProfile::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
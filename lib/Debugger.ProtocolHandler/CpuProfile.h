@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Profiler.h>
+
+#include <ChakraCore.h>
+
+#include "CollectionTracker.h"
+#include "FunctionTable.h"
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace JsDebug
+{
+    class Debugger;
+
+    /// <summary>
+    /// Compact store for sampled call stacks. Samples are appended on the engine
+    /// thread while it is stopped at an async break, and the profile tree is only
+    /// built when the recording is turned into a protocol value.
+    /// </summary>
+    class CpuProfile
+    {
+    public:
+        CpuProfile();
+        CpuProfile(const CpuProfile&) = delete;
+        CpuProfile& operator=(const CpuProfile&) = delete;
+
+        void Start();
+        void Stop();
+        bool IsStarted() const;
+        int64_t StartTime() const;
+
+        // Must be called while the engine is at a break. Once the sample
+        // buffer is full, later samples are dropped and the profile ends at
+        // the last one kept.
+        void AddSample();
+        bool IsFull() const;
+
+        // Collections are merged in as samples of a "(garbage collector)" node
+        // under the root, so each one is charged the time until the next sample.
+        std::unique_ptr<protocol::Profiler::Profile> ToProtocolValue(
+            Debugger* debugger,
+            const std::vector<GarbageCollection>& collections) const;
+
+    private:
+        struct Frame
+        {
+            uint32_t function;
+            int line;
+        };
+
+        struct Sample
+        {
+            size_t frameOffset;
+            uint32_t frameCount;
+            int64_t timestamp;
+        };
+
+        static int64_t Now();
+
+        uint32_t GetFunction(JsValueRef callFrame, int scriptId, int line, int column);
+
+        bool m_isStarted;
+        bool m_isFull;
+        int64_t m_startTime;
+        int64_t m_endTime;
+
+        FunctionTable m_functions;
+
+        // Functions by the statement a frame was stopped at, so a function
+        // is only resolved through its handle the first time it is seen.
+        std::map<std::tuple<int, int, int>, uint32_t> m_framePositions;
+
+        // Frames of every sample, innermost first, stored back to back.
+        std::vector<Frame> m_frames;
+        std::vector<Sample> m_samples;
+    };
+}
@@ -8,25 +8,62 @@
 #include "PropertyHelpers.h"
 #include "ProtocolHandler.h"
 
+#include <algorithm>
+#include <climits>
+
 namespace JsDebug
 {
     namespace
     {
         const char c_ErrorInvalidOrdinal[] = "Invalid ordinal value";
+
+        // Events at which the engine is stopped at a statement, so that the
+        // stack and the objects on it can be inspected.
+        bool IsStopEvent(JsDiagDebugEvent debugEvent)
+        {
+            return debugEvent == JsDiagDebugEventBreakpoint ||
+                debugEvent == JsDiagDebugEventStepComplete ||
+                debugEvent == JsDiagDebugEventAsyncBreak ||
+                debugEvent == JsDiagDebugEventRuntimeException ||
+                debugEvent == JsDiagDebugEventDebuggerStatement;
+        }
+
+        // Scheduling stacks kept for async call stacks.
+        const size_t c_AsyncStackCapacity = 1024;
+
+        // Script sources held to save reading them from the engine again.
+        const size_t c_MaxRetainedSourceBytes = 16 * 1024 * 1024;
     }
 
     Debugger::Debugger(ProtocolHandler* handler, JsRuntimeHandle runtime)
         : m_handler(handler)
+        , m_statistics(&handler->GetStatistics())
         , m_runtime(runtime)
         , m_debugContext(runtime)
         , m_isEnabled(false)
         , m_isPaused(false)
+        , m_debugEventDepth(0)
+        , m_isHandlingStopEvent(false)
         , m_isRunningNestedMessageLoop(false)
         , m_shouldPauseOnNextStatement(false)
+        , m_isStepping(false)
+        , m_isResumingStep(false)
+        , m_stepType(JsDiagStepTypeStepIn)
+        , m_stepDepth(0)
         , m_sourceEventCallback(nullptr)
         , m_sourceEventCallbackState(nullptr)
         , m_breakEventCallback(nullptr)
         , m_breakEventCallbackState(nullptr)
+        , m_resumeEventCallback(nullptr)
+        , m_resumeEventCallbackState(nullptr)
+        , m_sampleEventCallback(nullptr)
+        , m_sampleEventCallbackState(nullptr)
+        , m_isSampling(false)
+        , m_asyncStacks(c_AsyncStackCapacity, &m_statistics->retainedValueCount)
+        , m_sourceHandles(&m_statistics->retainedValueCount)
+        , m_breakHandles(&m_statistics->retainedValueCount)
+        , m_shouldRetainSources(true)
+        , m_retainedSourceBytes(0)
     {
         IfJsErrorThrow(JsDiagStartDebugging(m_runtime, &Debugger::DebugEventCallback, this));
     }
@@ -35,6 +72,8 @@ namespace JsDebug
     {
         try
         {
+            StopSampling();
+
             // The API requires that a state param be provided, even though we don't use it.
             void* state = nullptr;
             IfJsErrorThrow(JsDiagStopDebugging(m_runtime, &state));
@@ -70,7 +109,11 @@ namespace JsDebug
         }
 
         m_isEnabled = false;
+        m_isStepping = false;
         ClearBreakpoints();
+
+        ReleaseScriptSources();
+        m_shouldRetainSources = true;
     }
 
     void Debugger::SetSourceEventHandler(DebuggerSourceEventHandler callback, void* callbackState)
@@ -93,7 +136,7 @@ namespace JsDebug
 
     void Debugger::RequestAsyncBreak()
     {
-        IfJsErrorThrow(JsDiagRequestAsyncBreak(m_runtime));
+        IfJsErrorThrow(RequestBreak());
     }
 
     void Debugger::PauseOnNextStatement()
@@ -102,6 +145,65 @@ namespace JsDebug
         RequestAsyncBreak();
     }
 
+    void Debugger::StartSampling(std::chrono::microseconds interval, DebuggerSampleEventHandler callback, void* callbackState)
+    {
+        StopSampling();
+
+        m_sampleEventCallback = callback;
+        m_sampleEventCallbackState = callbackState;
+        m_isSampling = true;
+        m_samplerThread = std::thread(&Debugger::SamplerThreadProc, this, interval);
+    }
+
+    void Debugger::RunAtBreak(DebuggerBreakTaskHandler callback, void* callbackState)
+    {
+        if (m_isPaused)
+        {
+            DebuggerContext::Scope debuggerScope(m_debugContext);
+            callback(callbackState);
+            return;
+        }
+
+        m_breakTasks.emplace_back(callback, callbackState);
+
+        // Tasks queued while commands are processed for a stop event run
+        // before that event completes, so no further break is needed.
+        if (!m_isHandlingStopEvent)
+        {
+            RequestAsyncBreak();
+        }
+    }
+
+    void Debugger::CancelBreakTasks(void* callbackState)
+    {
+        m_breakTasks.erase(
+            std::remove_if(m_breakTasks.begin(), m_breakTasks.end(), [callbackState](const std::pair<DebuggerBreakTaskHandler, void*>& task)
+            {
+                return task.second == callbackState;
+            }),
+            m_breakTasks.end());
+    }
+
+    void Debugger::StopSampling()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_samplerLock);
+
+            if (!m_isSampling)
+            {
+                return;
+            }
+
+            m_isSampling = false;
+        }
+
+        m_samplerWake.notify_all();
+        m_samplerThread.join();
+
+        m_sampleEventCallback = nullptr;
+        m_sampleEventCallbackState = nullptr;
+    }
+
     std::vector<DebuggerScript> Debugger::GetScripts()
     {
         std::vector<DebuggerScript> scripts;
@@ -135,7 +237,7 @@ namespace JsDebug
             throw std::runtime_error(c_ErrorInvalidOrdinal);
         }
 
-        return DebuggerCallFrame(PropertyHelpers::GetIndexedProperty(stackTrace, ordinal));
+        return DebuggerCallFrame(&m_breakHandles, PropertyHelpers::GetIndexedProperty(stackTrace, ordinal));
     }
 
     std::vector<DebuggerCallFrame> Debugger::GetCallFrames(int limit)
@@ -154,7 +256,7 @@ namespace JsDebug
         for (int index = 0; index < length; ++index) {
             JsValueRef callFrameValue = PropertyHelpers::GetIndexedProperty(stackTrace, index);
 
-            callFrames.emplace_back(callFrameValue);
+            callFrames.emplace_back(&m_breakHandles, callFrameValue);
         }
 
         return callFrames;
@@ -165,7 +267,75 @@ namespace JsDebug
         JsValueRef obj = JS_INVALID_REFERENCE;
         IfJsErrorThrow(JsDiagGetObjectFromHandle(handle, &obj));
 
-        return DebuggerObject(obj);
+        return DebuggerObject(&m_breakHandles, obj);
+    }
+
+    JsValueRef Debugger::GetScriptSource(int scriptId)
+    {
+        auto retained = m_retainedSources.find(scriptId);
+
+        if (retained != m_retainedSources.end())
+        {
+            return m_sourceHandles.Get(retained->second.source);
+        }
+
+        JsValueRef scriptSource = JS_INVALID_REFERENCE;
+        if (scriptId == 0 || JsDiagGetSource(scriptId, &scriptSource) != JsNoError)
+        {
+            return JS_INVALID_REFERENCE;
+        }
+
+        if (m_shouldRetainSources)
+        {
+            RetainScriptSource(scriptId, scriptSource);
+        }
+
+        return scriptSource;
+    }
+
+    void Debugger::EvictScriptSources()
+    {
+        // Sources are read from the engine each time from here on.
+        ReleaseScriptSources();
+        m_shouldRetainSources = false;
+    }
+
+    void Debugger::RetainScriptSource(int scriptId, JsValueRef scriptSource)
+    {
+        int length = 0;
+        IfJsErrorThrow(JsGetStringLength(
+            PropertyHelpers::GetProperty(scriptSource, PropertyHelpers::Names::Source),
+            &length));
+
+        size_t bytes = length * sizeof(uint16_t);
+        if (bytes > c_MaxRetainedSourceBytes)
+        {
+            return;
+        }
+
+        while (m_retainedSourceBytes + bytes > c_MaxRetainedSourceBytes && !m_retainedSourceOrder.empty())
+        {
+            auto oldest = m_retainedSources.find(m_retainedSourceOrder.front());
+            m_retainedSourceOrder.pop_front();
+
+            m_sourceHandles.Remove(oldest->second.source);
+            m_retainedSourceBytes -= oldest->second.bytes;
+            m_retainedSources.erase(oldest);
+        }
+
+        m_retainedSources.emplace(scriptId, RetainedSource { m_sourceHandles.Add(scriptSource), bytes });
+        m_retainedSourceOrder.push_back(scriptId);
+        m_retainedSourceBytes += bytes;
+        m_statistics->scriptSourceBytes = m_retainedSourceBytes;
+    }
+
+    void Debugger::ReleaseScriptSources()
+    {
+        m_sourceHandles.Release();
+        m_retainedSources.clear();
+        m_retainedSourceOrder.clear();
+        m_retainedSourceBytes = 0;
+        m_statistics->scriptSourceBytes = 0;
     }
 
     void Debugger::SetBreakpoint(DebuggerBreakpoint& breakpoint)
@@ -175,8 +345,14 @@ namespace JsDebug
         JsValueRef bp = JS_INVALID_REFERENCE;
         IfJsErrorThrow(JsDiagSetBreakpoint(scriptId, breakpoint.GetLineNumber(), breakpoint.GetColumnNumber(), &bp));
 
+        // A user breakpoint on a counted statement takes precedence, so the
+        // counter must stop swallowing its hits.
+        int actualId = PropertyHelpers::GetPropertyInt(bp, PropertyHelpers::Names::BreakpointId);
+        m_lineHitCounter.Release(actualId);
+        m_coverage.Release(actualId);
+
         breakpoint.OnBreakpointResolved(
-            PropertyHelpers::GetPropertyInt(bp, PropertyHelpers::Names::BreakpointId),
+            actualId,
             PropertyHelpers::GetPropertyInt(bp, PropertyHelpers::Names::Line),
             PropertyHelpers::GetPropertyInt(bp, PropertyHelpers::Names::Column));
     }
@@ -186,6 +362,88 @@ namespace JsDebug
         JsDiagRemoveBreakpoint(breakpoint.GetActualId());
     }
 
+    void Debugger::StartLineHitCounting(const std::vector<DebuggerScript>& scripts, int maxHits)
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+
+        m_lineHitCounter.Start(maxHits);
+
+        for (const auto& script : scripts)
+        {
+            m_lineHitCounter.AddScript(script.ScriptId().toInteger(), script.EndLine());
+        }
+    }
+
+    void Debugger::StopLineHitCounting()
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+        m_lineHitCounter.Stop();
+    }
+
+    std::vector<DebuggerHitCounter::Location> Debugger::GetLineHitCounts()
+    {
+        return m_lineHitCounter.GetLocations();
+    }
+
+    void Debugger::StartCoverage(const std::vector<DebuggerScript>& scripts)
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+
+        m_coverage.Start();
+
+        for (const auto& script : scripts)
+        {
+            m_coverage.AddScript(script.ScriptId().toInteger(), script.EndLine());
+        }
+    }
+
+    void Debugger::StopCoverage()
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+        m_coverage.Stop();
+    }
+
+    bool Debugger::IsCoverageStarted()
+    {
+        return m_coverage.IsStarted();
+    }
+
+    std::vector<DebuggerCoverage::Script> Debugger::TakeCoverage()
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+        return m_coverage.Take();
+    }
+
+    void Debugger::SetAsyncCallStackDepth(int maxDepth)
+    {
+        m_asyncStacks.SetMaxDepth(maxDepth);
+    }
+
+    void Debugger::AsyncTaskScheduled(JsValueRef task)
+    {
+        // The stack can only be read at a break, and the next one comes at
+        // the scheduling script's following statement.
+        if (m_asyncStacks.TaskScheduled(task))
+        {
+            RunAtBreak(&Debugger::AsyncStackBreakTask, this);
+        }
+    }
+
+    void Debugger::AsyncTaskStarted(JsValueRef task)
+    {
+        m_asyncStacks.TaskStarted(task);
+    }
+
+    void Debugger::AsyncTaskFinished(JsValueRef task)
+    {
+        m_asyncStacks.TaskFinished(task);
+    }
+
+    void Debugger::AsyncStackBreakTask(void* callbackState)
+    {
+        static_cast<Debugger*>(callbackState)->m_asyncStacks.CaptureStack();
+    }
+
     JsDiagBreakOnExceptionAttributes Debugger::GetBreakOnException()
     {
         JsDiagBreakOnExceptionAttributes attributes = JsDiagBreakOnExceptionAttributeNone;
@@ -204,15 +462,22 @@ namespace JsDebug
         return m_isPaused;
     }
 
+    bool Debugger::IsHandlingDebugEvent()
+    {
+        return m_debugEventDepth != 0;
+    }
+
     void Debugger::Continue()
     {
+        m_isStepping = false;
+        m_isResumingStep = false;
         m_handler->Continue();
     }
 
     void Debugger::Go()
     {
         m_shouldPauseOnNextStatement = false;
-        m_handler->Continue();
+        Continue();
     }
 
     static void IfSeriousJsErrorThrow(JsErrorCode err)
@@ -225,18 +490,33 @@ namespace JsDebug
     {
         IfSeriousJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepIn));
         Continue();
+        RememberStep(JsDiagStepTypeStepIn);
     }
 
     void Debugger::StepOut()
     {
         IfSeriousJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepOut));
         Continue();
+        RememberStep(JsDiagStepTypeStepOut);
     }
 
     void Debugger::StepOver()
     {
         IfSeriousJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepOver));
         Continue();
+        RememberStep(JsDiagStepTypeStepOver);
+    }
+
+    void Debugger::StepBack()
+    {
+        IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepBack));
+        Continue();
+    }
+
+    void Debugger::ReverseContinue()
+    {
+        IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeReverseContinue));
+        Continue();
     }
 
     void Debugger::DebugEventCallback(JsDiagDebugEvent debugEvent, JsValueRef eventData, void* callbackState)
@@ -247,7 +527,88 @@ namespace JsDebug
 
     void Debugger::HandleDebugEvent(JsDiagDebugEvent debugEvent, JsValueRef eventData)
     {
+        // The engine takes any debug event as the answer to a break request.
+        m_statistics->isBreakPending = false;
+
+        // Script run while handling an event, such as an evaluation during a
+        // pause, can raise events of its own. The outer event is still current
+        // when those return.
+        ++m_debugEventDepth;
+        DispatchDebugEvent(debugEvent, eventData);
+
+        if (--m_debugEventDepth != 0)
+        {
+            return;
+        }
+
+        // Nothing taken from the engine during the event can be used after it,
+        // so the references go in one pass rather than one object at a time.
+        // Commands still queued with ids from this event are now stale.
+        m_breakHandles.Release();
+        m_handler->ExpirePauseState();
+    }
+
+    void Debugger::DispatchDebugEvent(JsDiagDebugEvent debugEvent, JsValueRef eventData)
+    {
+        bool isStopEvent = IsStopEvent(debugEvent);
+
+        m_isHandlingStopEvent = isStopEvent;
         m_handler->ProcessCommandQueue();
+        m_isHandlingStopEvent = false;
+
+        // Deferred break tasks inspect the stack, so they only get their turn
+        // when the engine is stopped at a statement. A source event consumes
+        // any pending break request, so it has to be made again for them.
+        if (isStopEvent)
+        {
+            RunBreakTasks();
+        }
+        else if (!m_breakTasks.empty())
+        {
+            RequestAsyncBreak();
+        }
+
+        // Sampling doesn't depend on the Debugger domain being enabled. Any
+        // debug event satisfies the pending sampler request, so take the
+        // sample whenever one arrives and let the event proceed as usual.
+        if (debugEvent == JsDiagDebugEventAsyncBreak && m_sampleEventCallback != nullptr)
+        {
+            DebuggerContext::Scope debuggerScope(m_debugContext);
+            m_sampleEventCallback(m_sampleEventCallbackState);
+        }
+
+        // Coverage follows every script as it is compiled, whether or not
+        // the Debugger domain is listening.
+        if (debugEvent == JsDiagDebugEventSourceCompile && m_coverage.IsStarted())
+        {
+            DebuggerContext::Scope debuggerScope(m_debugContext);
+            m_coverage.AddScript(
+                PropertyHelpers::GetPropertyInt(eventData, PropertyHelpers::Names::ScriptId),
+                PropertyHelpers::GetPropertyInt(eventData, PropertyHelpers::Names::LineCount));
+        }
+
+        bool isStepComplete = false;
+
+        if (debugEvent == JsDiagDebugEventBreakpoint && HandleTransientBreak(eventData))
+        {
+            // The engine ends a step at any breakpoint, including those only
+            // counting hits, so the step is either over here or made again.
+            isStepComplete = m_isStepping && m_isEnabled && !ResumeStep(false);
+
+            if (!isStepComplete)
+            {
+                // As with source events, a pending break-on-next-statement
+                // request was consumed by this event and has to be made again.
+                if (m_shouldPauseOnNextStatement)
+                    RequestBreak();
+                return;
+            }
+        }
+        else if (debugEvent == JsDiagDebugEventStepComplete && m_isStepping && m_isResumingStep && ResumeStep(true))
+        {
+            // Still on the way back to the frame the client stepped in.
+            return;
+        }
 
         if (!m_isEnabled)
         {
@@ -268,26 +629,47 @@ namespace JsDebug
             // to be satisified on *any* debug event, even a source event that
             // never enters the debugger UI.
             if (m_shouldPauseOnNextStatement)
-                JsDiagRequestAsyncBreak(m_runtime);
+                RequestBreak();
             break;
 
         case JsDiagDebugEventBreakpoint:
         case JsDiagDebugEventStepComplete:
         case JsDiagDebugEventDebuggerStatement:
         case JsDiagDebugEventRuntimeException:
-            HandleBreak(eventData);
+            // A step that ended at a transient breakpoint stops as the step
+            // would have, without reporting a breakpoint the client never set.
+            HandleBreak(eventData, !isStepComplete);
             break;
 
         case JsDiagDebugEventAsyncBreak:
             if (m_shouldPauseOnNextStatement)
             {
                 m_shouldPauseOnNextStatement = false;
-                HandleBreak(eventData);
+                HandleBreak(eventData, true);
             }
             break;
         }
     }
 
+    void Debugger::RunBreakTasks()
+    {
+        if (m_breakTasks.empty())
+        {
+            return;
+        }
+
+        // A task may queue another, which waits for the next break.
+        std::vector<std::pair<DebuggerBreakTaskHandler, void*>> tasks;
+        tasks.swap(m_breakTasks);
+
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+
+        for (const auto& task : tasks)
+        {
+            task.first(task.second);
+        }
+    }
+
     void Debugger::HandleSourceEvent(JsValueRef eventData, bool success)
     {
         if (m_sourceEventCallback != nullptr)
@@ -297,7 +679,7 @@ namespace JsDebug
         }
     }
 
-    void Debugger::HandleBreak(JsValueRef eventData)
+    void Debugger::HandleBreak(JsValueRef eventData, bool hasHitBreakpoint)
     {
         if (m_isRunningNestedMessageLoop)
         {
@@ -305,11 +687,24 @@ namespace JsDebug
             return;
         }
 
+        // Whatever step was under way has ended here.
+        m_isStepping = false;
+        m_isResumingStep = false;
+
         if (m_breakEventCallback != nullptr)
         {
             m_isPaused = true;
 
-            DebuggerBreak breakInfo(eventData);
+            int64_t pauseStartTime = HandlerStatistics::Now();
+            m_statistics->pauseStartTime = pauseStartTime;
+
+            std::unique_ptr<protocol::Runtime::StackTrace> asyncStackTrace;
+            if (m_asyncStacks.HasStackTrace())
+            {
+                asyncStackTrace = m_asyncStacks.GetStackTrace(GetScripts());
+            }
+
+            DebuggerBreak breakInfo(&m_breakHandles, eventData, std::move(asyncStackTrace), hasHitBreakpoint);
             SkipPauseRequest request = m_breakEventCallback(breakInfo, m_breakEventCallbackState);
 
             if (request == SkipPauseRequest::RequestNoSkip)
@@ -322,14 +717,19 @@ namespace JsDebug
 
             m_isPaused = false;
 
+            m_statistics->pausedMicroseconds += HandlerStatistics::Now() - pauseStartTime;
+            m_statistics->pauseStartTime = 0;
+
             if (request == SkipPauseRequest::RequestStepFrame ||
                 request == SkipPauseRequest::RequestStepInto)
             {
                 IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepIn));
+                RememberStep(JsDiagStepTypeStepIn);
             }
             else if (request == SkipPauseRequest::RequestStepOut)
             {
                 IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepOut));
+                RememberStep(JsDiagStepTypeStepOut);
             }
   
             if (m_resumeEventCallback != nullptr)
@@ -337,6 +737,109 @@ namespace JsDebug
         }
     }
 
+    void Debugger::SamplerThreadProc(std::chrono::microseconds interval)
+    {
+        std::unique_lock<std::mutex> lock(m_samplerLock);
+
+        while (!m_samplerWake.wait_for(lock, interval, [this]() { return !m_isSampling; }))
+        {
+            // Safe to call from any thread; the engine takes the break at the
+            // next statement boundary on its own thread.
+            RequestBreak();
+        }
+    }
+
+    bool Debugger::HandleTransientBreak(JsValueRef eventData)
+    {
+        int breakpointId = 0;
+        if (!PropertyHelpers::TryGetProperty(eventData, PropertyHelpers::Names::BreakpointId, &breakpointId))
+        {
+            return false;
+        }
+
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+
+        // Coverage sees every breakpoint hit, including ones it doesn't own.
+        bool isHandled = m_coverage.IsStarted() && m_coverage.HandleBreakpoint(
+            breakpointId,
+            PropertyHelpers::GetPropertyInt(eventData, PropertyHelpers::Names::ScriptId),
+            PropertyHelpers::GetPropertyInt(eventData, PropertyHelpers::Names::Line),
+            PropertyHelpers::GetPropertyInt(eventData, PropertyHelpers::Names::Column));
+
+        return m_lineHitCounter.HandleBreakpoint(breakpointId) || isHandled;
+    }
+
+    bool Debugger::TryGetStackDepth(int* depth)
+    {
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        if (JsDiagGetStackTrace(&stackTrace) != JsNoError)
+        {
+            return false;
+        }
+
+        *depth = PropertyHelpers::GetPropertyInt(stackTrace, PropertyHelpers::Names::Length);
+        return true;
+    }
+
+    void Debugger::RememberStep(JsDiagStepType stepType)
+    {
+        int depth = 0;
+        if (!TryGetStackDepth(&depth))
+        {
+            // Not at a break, so the engine took no step.
+            return;
+        }
+
+        // The step is over at the first statement no deeper than this. A step
+        // in stops anywhere.
+        m_isStepping = true;
+        m_isResumingStep = false;
+        m_stepType = stepType;
+        m_stepDepth =
+            stepType == JsDiagStepTypeStepIn ? INT_MAX :
+            stepType == JsDiagStepTypeStepOut ? depth - 1 :
+            depth;
+    }
+
+    bool Debugger::ResumeStep(bool isReturning)
+    {
+        DebuggerContext::Scope debuggerScope(m_debugContext);
+
+        int depth = 0;
+        if (!TryGetStackDepth(&depth))
+        {
+            m_isStepping = false;
+            return false;
+        }
+
+        if (depth > m_stepDepth)
+        {
+            // Deeper than the step stops, such as inside a call being stepped
+            // over, so return to the frame that was stepped in first.
+            IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepOut));
+            m_isResumingStep = true;
+            return true;
+        }
+
+        if (isReturning && m_stepType == JsDiagStepTypeStepOver)
+        {
+            // Back in the frame part way through the statement that was being
+            // stepped over, so finish the step from here.
+            IfJsErrorThrow(JsDiagSetStepType(JsDiagStepTypeStepOver));
+            m_isResumingStep = false;
+            return true;
+        }
+
+        m_isResumingStep = false;
+        return false;
+    }
+
+    JsErrorCode Debugger::RequestBreak()
+    {
+        m_statistics->isBreakPending = true;
+        return JsDiagRequestAsyncBreak(m_runtime);
+    }
+
     void Debugger::ClearBreakpoints()
     {
         // Ensure that there's an active context before trying to remove breakpoints.
@@ -351,7 +854,12 @@ namespace JsDebug
             {
                 JsValueRef breakpoint = PropertyHelpers::GetIndexedProperty(breakpoints, index);
                 int breakpointId = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId);
-                JsDiagRemoveBreakpoint(breakpointId);
+
+                // Counting and coverage breakpoints outlive the Debugger domain.
+                if (!m_lineHitCounter.OwnsBreakpoint(breakpointId) && !m_coverage.OwnsBreakpoint(breakpointId))
+                {
+                    JsDiagRemoveBreakpoint(breakpointId);
+                }
             }
         }
     }
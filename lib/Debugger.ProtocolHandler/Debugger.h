@@ -3,14 +3,25 @@
 
 #pragma once
 
+#include "DebuggerAsyncStacks.h"
 #include "DebuggerBreak.h"
 #include "DebuggerBreakpoint.h"
 #include "DebuggerCallFrame.h"
 #include "DebuggerContext.h"
+#include "DebuggerCoverage.h"
+#include "DebuggerHitCounter.h"
 #include "DebuggerObject.h"
 #include "DebuggerScript.h"
+#include "HandlerStatistics.h"
+#include "JsHandleTable.h"
 
 #include <ChakraCore.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace JsDebug
@@ -28,6 +39,8 @@ namespace JsDebug
     typedef void (*DebuggerSourceEventHandler)(const DebuggerScript& scriptInfo, bool success, void* callbackState);
     typedef SkipPauseRequest (*DebuggerBreakEventHandler)(const DebuggerBreak& breakInfo, void* callbackState);
     typedef void (*DebuggerResumeEventHandler)(void* callbackState);
+    typedef void (*DebuggerSampleEventHandler)(void* callbackState);
+    typedef void (*DebuggerBreakTaskHandler)(void* callbackState);
 
     class Debugger
     {
@@ -49,23 +62,76 @@ namespace JsDebug
         void RequestAsyncBreak();
         void PauseOnNextStatement();
 
+        // Start a sampler thread that requests an async break every interval.
+        // The callback runs on the engine thread at each break, while the
+        // stack is inspectable, and execution continues without pausing.
+        void StartSampling(std::chrono::microseconds interval, DebuggerSampleEventHandler callback, void* callbackState);
+        void StopSampling();
+
+        // Run the callback on the engine thread while it is stopped at a
+        // statement, either now if it is paused or at the next breakpoint,
+        // step, exception, debugger statement or async break. Source events
+        // don't count, as the stack can't be inspected during them.
+        void RunAtBreak(DebuggerBreakTaskHandler callback, void* callbackState);
+        void CancelBreakTasks(void* callbackState);
+
         std::vector<DebuggerScript> GetScripts();
         DebuggerCallFrame GetCallFrame(int ordinal);
         std::vector<DebuggerCallFrame> GetCallFrames(int limit = 0);
         DebuggerObject GetObjectFromHandle(int handle);
 
+        // Reads a script's source from the engine, holding the most recently
+        // read ones for later calls while sources are retained. Call frames and
+        // objects are only valid at the break that produced them, so their
+        // references are all dropped when it ends.
+        JsValueRef GetScriptSource(int scriptId);
+
+        // Drops the sources held for every script and stops holding them for
+        // new ones until the debugger is next enabled. Sources are then read
+        // from the engine each time they are asked for.
+        void EvictScriptSources();
+
         void SetBreakpoint(DebuggerBreakpoint& breakpoint);
         void RemoveBreakpoint(DebuggerBreakpoint& breakpoint);
 
+        // Count hits on every line of the given scripts without pausing. Each
+        // location stops being counted once it reaches maxHits.
+        void StartLineHitCounting(const std::vector<DebuggerScript>& scripts, int maxHits);
+        void StopLineHitCounting();
+        std::vector<DebuggerHitCounter::Location> GetLineHitCounts();
+
+        // Record statement coverage for the given scripts and any loaded later.
+        void StartCoverage(const std::vector<DebuggerScript>& scripts);
+        void StopCoverage();
+        bool IsCoverageStarted();
+        std::vector<DebuggerCoverage::Script> TakeCoverage();
+
+        // Record the stacks that schedule promise continuations, up to the given
+        // depth of nesting, so pauses can report them. Zero turns this off.
+        void SetAsyncCallStackDepth(int maxDepth);
+        void AsyncTaskScheduled(JsValueRef task);
+        void AsyncTaskStarted(JsValueRef task);
+        void AsyncTaskFinished(JsValueRef task);
+
         JsDiagBreakOnExceptionAttributes GetBreakOnException();
         void SetBreakOnException(JsDiagBreakOnExceptionAttributes attributes);
 
         bool IsPaused();
+
+        // True while the engine is in a debug event of any kind, which is the
+        // only time script can be running when a command is handled.
+        bool IsHandlingDebugEvent();
+
         void Continue();
         void StepIn();
         void StepOut();
         void StepOver();
 
+        // Only supported when the runtime is replaying a time travel log.
+        // Errors are thrown rather than ignored so the caller can report them.
+        void StepBack();
+        void ReverseContinue();
+
         // Go - clear any pending break flag and resume execution
         void Go();
 
@@ -76,20 +142,44 @@ namespace JsDebug
             void* callbackState);
 
         void HandleDebugEvent(JsDiagDebugEvent debugEvent, JsValueRef eventData);
+        void DispatchDebugEvent(JsDiagDebugEvent debugEvent, JsValueRef eventData);
         void HandleSourceEvent(JsValueRef eventData, bool success);
-        void HandleBreak(JsValueRef eventData);
-
+        void HandleBreak(JsValueRef eventData, bool hasHitBreakpoint);
+        void RunBreakTasks();
+        static void AsyncStackBreakTask(void* callbackState);
+        bool HandleTransientBreak(JsValueRef eventData);
+        bool TryGetStackDepth(int* depth);
+        void RememberStep(JsDiagStepType stepType);
+
+        // Called at a transient breakpoint or a step made by the debugger
+        // itself. Returns false if the step is over, and otherwise sets the
+        // step that continues it.
+        bool ResumeStep(bool isReturning);
+
+        JsErrorCode RequestBreak();
         void ClearBreakpoints();
+        void SamplerThreadProc(std::chrono::microseconds interval);
 
         ProtocolHandler* m_handler;
+        HandlerStatistics* m_statistics;
         JsRuntimeHandle m_runtime;
         DebuggerContext m_debugContext;
 
         bool m_isEnabled;
         bool m_isPaused;
+        unsigned int m_debugEventDepth;
+        bool m_isHandlingStopEvent;
         bool m_isRunningNestedMessageLoop;
         bool m_shouldPauseOnNextStatement;
 
+        // The step the client last asked for, until the engine stops for it.
+        // Transient breakpoints end the engine's step early, so it is made
+        // again from there until the stack is no deeper than the step depth.
+        bool m_isStepping;
+        bool m_isResumingStep;
+        JsDiagStepType m_stepType;
+        int m_stepDepth;
+
         DebuggerSourceEventHandler m_sourceEventCallback;
         void* m_sourceEventCallbackState;
 
@@ -98,5 +188,37 @@ namespace JsDebug
 
         DebuggerResumeEventHandler m_resumeEventCallback;
         void* m_resumeEventCallbackState;
+
+        DebuggerSampleEventHandler m_sampleEventCallback;
+        void* m_sampleEventCallbackState;
+
+        std::thread m_samplerThread;
+        std::mutex m_samplerLock;
+        std::condition_variable m_samplerWake;
+        bool m_isSampling;
+
+        std::vector<std::pair<DebuggerBreakTaskHandler, void*>> m_breakTasks;
+
+        DebuggerHitCounter m_lineHitCounter;
+        DebuggerCoverage m_coverage;
+        DebuggerAsyncStacks m_asyncStacks;
+
+        struct RetainedSource
+        {
+            JsHandleTable::Handle source;
+            size_t bytes;
+        };
+
+        void RetainScriptSource(int scriptId, JsValueRef scriptSource);
+        void ReleaseScriptSources();
+
+        JsHandleTable m_sourceHandles;
+        JsHandleTable m_breakHandles;
+        bool m_shouldRetainSources;
+
+        // Sources held, and the order they were read in so the oldest go first.
+        std::unordered_map<int, RetainedSource> m_retainedSources;
+        std::deque<int> m_retainedSourceOrder;
+        size_t m_retainedSourceBytes;
     };
 }
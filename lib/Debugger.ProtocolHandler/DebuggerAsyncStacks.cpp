@@ -0,0 +1,346 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "DebuggerAsyncStacks.h"
+
+#include "PropertyHelpers.h"
+
+#include <algorithm>
+#include <map>
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::Runtime::CallFrame;
+    using protocol::Runtime::StackTrace;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_AsyncDescription[] = "async";
+
+        // Running tasks deeper than this are taken to be a host that never
+        // reports them finished, and are forgotten.
+        const size_t c_MaxRunningTasks = 64;
+
+        // Frames kept per scheduling stack; the outermost are dropped.
+        const int c_MaxStackFrames = 64;
+    }
+
+    DebuggerAsyncStacks::DebuggerAsyncStacks(size_t capacity, std::atomic<uint32_t>* retainedValues)
+        : m_maxDepth(0)
+        , m_fragments(capacity)
+        , m_nextId(1)
+        , m_nextSequence(1)
+        , m_pendingParent(0)
+        , m_retainedValues(retainedValues)
+    {
+    }
+
+    void DebuggerAsyncStacks::SetMaxDepth(int maxDepth)
+    {
+        m_maxDepth = maxDepth > 0 ? maxDepth : 0;
+
+        if (m_maxDepth == 0)
+        {
+            Clear();
+        }
+    }
+
+    bool DebuggerAsyncStacks::TaskScheduled(JsValueRef task)
+    {
+        if (m_maxDepth == 0)
+        {
+            return false;
+        }
+
+        // Tasks the host dropped without running would otherwise accumulate,
+        // so the oldest still waiting is forgotten first.
+        while (m_scheduledTasks.size() >= m_fragments.size() && !m_scheduleOrder.empty())
+        {
+            auto oldest = m_scheduledTasks.find(m_scheduleOrder.front().first);
+            if (oldest != m_scheduledTasks.end() && oldest->second.sequence == m_scheduleOrder.front().second)
+            {
+                ForgetTask(oldest);
+            }
+
+            m_scheduleOrder.pop_front();
+        }
+
+        // Started tasks leave stale entries behind; drop them once they
+        // outnumber the live ones.
+        if (m_scheduleOrder.size() >= 2 * m_fragments.size())
+        {
+            m_scheduleOrder.erase(
+                std::remove_if(m_scheduleOrder.begin(), m_scheduleOrder.end(), [this](const std::pair<JsValueRef, uint64_t>& entry)
+                {
+                    auto scheduled = m_scheduledTasks.find(entry.first);
+                    return scheduled == m_scheduledTasks.end() || scheduled->second.sequence != entry.second;
+                }),
+                m_scheduleOrder.end());
+        }
+
+        uint64_t sequence = m_nextSequence++;
+        auto inserted = m_scheduledTasks.emplace(task, ScheduledTask());
+        ScheduledTask& scheduled = inserted.first->second;
+        scheduled.fragment = 0;
+        scheduled.sequence = sequence;
+
+        if (inserted.second)
+        {
+            scheduled.task = task;
+
+            if (m_retainedValues != nullptr)
+            {
+                m_retainedValues->fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        m_scheduleOrder.emplace_back(task, sequence);
+
+        if (m_pendingTasks.size() >= m_fragments.size())
+        {
+            m_pendingTasks.clear();
+        }
+
+        m_pendingParent = m_runningTasks.empty() ? 0 : m_runningTasks.back();
+        m_pendingTasks.emplace_back(task, sequence);
+
+        return m_pendingTasks.size() == 1;
+    }
+
+    void DebuggerAsyncStacks::TaskStarted(JsValueRef task)
+    {
+        if (m_maxDepth == 0)
+        {
+            return;
+        }
+
+        // Any later break is no longer on the scheduling stack.
+        m_pendingTasks.clear();
+
+        uint32_t id = 0;
+        auto scheduled = m_scheduledTasks.find(task);
+        if (scheduled != m_scheduledTasks.end())
+        {
+            id = scheduled->second.fragment;
+            ForgetTask(scheduled);
+        }
+
+        if (m_runningTasks.size() == c_MaxRunningTasks)
+        {
+            m_runningTasks.clear();
+        }
+
+        m_runningTasks.push_back(id);
+    }
+
+    void DebuggerAsyncStacks::TaskFinished(JsValueRef /*task*/)
+    {
+        m_pendingTasks.clear();
+
+        if (!m_runningTasks.empty())
+        {
+            m_runningTasks.pop_back();
+        }
+    }
+
+    void DebuggerAsyncStacks::CaptureStack()
+    {
+        if (m_pendingTasks.empty())
+        {
+            return;
+        }
+
+        std::vector<std::pair<JsValueRef, uint64_t>> pendingTasks;
+        pendingTasks.swap(m_pendingTasks);
+
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        if (JsDiagGetStackTrace(&stackTrace) != JsNoError)
+        {
+            return;
+        }
+
+        int length = std::min(PropertyHelpers::GetPropertyInt(stackTrace, PropertyHelpers::Names::Length), c_MaxStackFrames);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        // Frames are told apart by position alone, so names are only looked
+        // up for a stack not seen before.
+        std::string key = std::to_string(m_pendingParent);
+        for (int index = 0; index < length; ++index)
+        {
+            JsValueRef callFrame = PropertyHelpers::GetIndexedProperty(stackTrace, index);
+
+            key += ':';
+            key += std::to_string(PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::ScriptId));
+            key += ',';
+            key += std::to_string(PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Line));
+            key += ',';
+            key += std::to_string(PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Column));
+        }
+
+        uint32_t id = Intern(key, m_pendingParent, stackTrace, length);
+
+        for (const auto& pending : pendingTasks)
+        {
+            auto scheduled = m_scheduledTasks.find(pending.first);
+            if (scheduled != m_scheduledTasks.end() && scheduled->second.sequence == pending.second)
+            {
+                scheduled->second.fragment = id;
+            }
+        }
+    }
+
+    bool DebuggerAsyncStacks::HasStackTrace() const
+    {
+        return m_maxDepth > 0 && !m_runningTasks.empty() && GetFragment(m_runningTasks.back()) != nullptr;
+    }
+
+    std::unique_ptr<StackTrace> DebuggerAsyncStacks::GetStackTrace(const std::vector<DebuggerScript>& scripts) const
+    {
+        if (!HasStackTrace())
+        {
+            return nullptr;
+        }
+
+        std::map<int, String> scriptUrls;
+        for (const DebuggerScript& script : scripts)
+        {
+            scriptUrls[script.ScriptId().toInteger()] = script.Url();
+        }
+
+        // Collect the chain first, as each parent is built into its child.
+        std::vector<const Fragment*> chain;
+        for (const Fragment* fragment = GetFragment(m_runningTasks.back());
+            fragment != nullptr && static_cast<int>(chain.size()) < m_maxDepth;
+            fragment = GetFragment(fragment->parent))
+        {
+            chain.push_back(fragment);
+        }
+
+        std::unique_ptr<StackTrace> stackTrace;
+
+        for (auto fragment = chain.rbegin(); fragment != chain.rend(); ++fragment)
+        {
+            auto callFrames = Array<CallFrame>::create();
+
+            for (const Frame& frame : (*fragment)->frames)
+            {
+                auto url = scriptUrls.find(frame.scriptId);
+
+                callFrames->addItem(CallFrame::create()
+                    .setFunctionName(frame.functionName)
+                    .setScriptId(String::fromInteger(frame.scriptId))
+                    .setUrl(url != scriptUrls.end() ? url->second : String())
+                    .setLineNumber(frame.line)
+                    .setColumnNumber(frame.column)
+                    .build());
+            }
+
+            auto current = StackTrace::create()
+                .setDescription(c_AsyncDescription)
+                .setCallFrames(std::move(callFrames))
+                .build();
+
+            if (stackTrace != nullptr)
+            {
+                current->setParent(std::move(stackTrace));
+            }
+
+            stackTrace = std::move(current);
+        }
+
+        return stackTrace;
+    }
+
+    void DebuggerAsyncStacks::ForgetTask(std::unordered_map<JsValueRef, ScheduledTask>::iterator scheduled)
+    {
+        m_scheduledTasks.erase(scheduled);
+
+        if (m_retainedValues != nullptr)
+        {
+            m_retainedValues->fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t DebuggerAsyncStacks::Intern(const std::string& key, uint32_t parent, JsValueRef stackTrace, int length)
+    {
+        auto existing = m_fragmentIds.find(key);
+        if (existing != m_fragmentIds.end() && GetFragment(existing->second) != nullptr)
+        {
+            return existing->second;
+        }
+
+        std::vector<Frame> frames;
+        frames.reserve(length);
+
+        for (int index = 0; index < length; ++index)
+        {
+            JsValueRef callFrame = PropertyHelpers::GetIndexedProperty(stackTrace, index);
+
+            String functionName;
+            JsValueRef functionObj = JS_INVALID_REFERENCE;
+            if (JsDiagGetObjectFromHandle(PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::FunctionHandle), &functionObj) == JsNoError)
+            {
+                PropertyHelpers::TryGetProperty(functionObj, PropertyHelpers::Names::Name, &functionName);
+            }
+
+            frames.push_back(Frame {
+                PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::ScriptId),
+                PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Line),
+                PropertyHelpers::GetPropertyInt(callFrame, PropertyHelpers::Names::Column),
+                functionName });
+        }
+
+        uint32_t id = m_nextId++;
+        Fragment& fragment = m_fragments[id % m_fragments.size()];
+
+        if (fragment.id != 0)
+        {
+            m_fragmentIds.erase(fragment.key);
+        }
+
+        fragment.id = id;
+        fragment.parent = parent;
+        fragment.key = key;
+        fragment.frames = std::move(frames);
+
+        m_fragmentIds[key] = id;
+        return id;
+    }
+
+    const DebuggerAsyncStacks::Fragment* DebuggerAsyncStacks::GetFragment(uint32_t id) const
+    {
+        if (id == 0)
+        {
+            return nullptr;
+        }
+
+        const Fragment& fragment = m_fragments[id % m_fragments.size()];
+        return fragment.id == id ? &fragment : nullptr;
+    }
+
+    void DebuggerAsyncStacks::Clear()
+    {
+        for (Fragment& fragment : m_fragments)
+        {
+            fragment = Fragment();
+        }
+
+        m_fragmentIds.clear();
+
+        if (m_retainedValues != nullptr)
+        {
+            m_retainedValues->fetch_sub(static_cast<uint32_t>(m_scheduledTasks.size()), std::memory_order_relaxed);
+        }
+
+        m_scheduledTasks.clear();
+        m_scheduleOrder.clear();
+        m_pendingTasks.clear();
+        m_runningTasks.clear();
+    }
+}
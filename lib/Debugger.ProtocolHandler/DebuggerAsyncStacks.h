@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Runtime.h>
+
+#include <ChakraCore.h>
+
+#include "DebuggerScript.h"
+#include "JsPersistent.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace JsDebug
+{
+    /// <summary>
+    /// Stacks that scheduled the promise continuations still to run, kept so a
+    /// pause can show how the running continuation came about. Each stack is
+    /// stored once per parent in a fixed-size ring, so repeated scheduling from
+    /// the same place costs a lookup, and the oldest stacks are simply
+    /// forgotten.
+    /// </summary>
+    class DebuggerAsyncStacks
+    {
+    public:
+        // Pinned tasks are added to the optional counter.
+        DebuggerAsyncStacks(size_t capacity, std::atomic<uint32_t>* retainedValues = nullptr);
+        DebuggerAsyncStacks(const DebuggerAsyncStacks&) = delete;
+        DebuggerAsyncStacks& operator=(const DebuggerAsyncStacks&) = delete;
+
+        // Nothing is captured while the depth is zero.
+        void SetMaxDepth(int maxDepth);
+
+        // Must be called on the engine thread while script can run, such as
+        // from the host's promise continuation callback. Returns true when the
+        // task is the first waiting for CaptureStack.
+        bool TaskScheduled(JsValueRef task);
+        void TaskStarted(JsValueRef task);
+        void TaskFinished(JsValueRef task);
+
+        // Must be called while the engine is at a break. The stack is given to
+        // the tasks scheduled since the last capture, provided no task has
+        // started or finished since, as the break is then elsewhere.
+        void CaptureStack();
+
+        bool HasStackTrace() const;
+
+        // The stacks that led to the running task, innermost first.
+        std::unique_ptr<protocol::Runtime::StackTrace> GetStackTrace(const std::vector<DebuggerScript>& scripts) const;
+
+    private:
+        struct Frame
+        {
+            int scriptId;
+            int line;
+            int column;
+            protocol::String functionName;
+        };
+
+        struct Fragment
+        {
+            uint32_t id;
+            uint32_t parent;
+            std::string key;
+            std::vector<Frame> frames;
+        };
+
+        struct ScheduledTask
+        {
+            // Pinned so the address can't be reused for another task while
+            // this one waits.
+            JsPersistent task;
+            uint32_t fragment;
+            uint64_t sequence;
+        };
+
+        void ForgetTask(std::unordered_map<JsValueRef, ScheduledTask>::iterator scheduled);
+        uint32_t Intern(const std::string& key, uint32_t parent, JsValueRef stackTrace, int length);
+        const Fragment* GetFragment(uint32_t id) const;
+        void Clear();
+
+        int m_maxDepth;
+
+        // Ids are never reused; zero means none. A fragment is still held if
+        // its slot in the ring carries the same id.
+        std::vector<Fragment> m_fragments;
+        uint32_t m_nextId;
+        std::unordered_map<std::string, uint32_t> m_fragmentIds;
+
+        // Tasks in the order they were scheduled, so the oldest is dropped
+        // first. Entries whose sequence no longer matches the map were started
+        // or rescheduled, and are skipped.
+        std::unordered_map<JsValueRef, ScheduledTask> m_scheduledTasks;
+        std::deque<std::pair<JsValueRef, uint64_t>> m_scheduleOrder;
+        uint64_t m_nextSequence;
+
+        std::vector<std::pair<JsValueRef, uint64_t>> m_pendingTasks;
+        uint32_t m_pendingParent;
+
+        std::vector<uint32_t> m_runningTasks;
+        std::atomic<uint32_t>* m_retainedValues;
+    };
+}
@@ -18,8 +18,14 @@ namespace JsDebug
     using protocol::Runtime::StackTrace;
     using protocol::String;
 
-    DebuggerBreak::DebuggerBreak(JsValueRef breakInfo)
-        : m_breakInfo(breakInfo)
+    DebuggerBreak::DebuggerBreak(
+        JsHandleTable* handles,
+        JsValueRef breakInfo,
+        std::unique_ptr<StackTrace> asyncStackTrace,
+        bool hasHitBreakpoint)
+        : m_breakInfo(handles, breakInfo)
+        , m_asyncStackTrace(std::move(asyncStackTrace))
+        , m_hasHitBreakpoint(hasHitBreakpoint)
     {
     }
 
@@ -56,7 +62,8 @@ namespace JsDebug
         auto breakpointIds = Array<String>::create();
 
         int breakpointId = 0;
-        if (PropertyHelpers::TryGetProperty(m_breakInfo.Get(), PropertyHelpers::Names::BreakpointId, &breakpointId))
+        if (m_hasHitBreakpoint &&
+            PropertyHelpers::TryGetProperty(m_breakInfo.Get(), PropertyHelpers::Names::BreakpointId, &breakpointId))
         {
             breakpointIds->addItem(String16::fromInteger(breakpointId));
         }
@@ -66,7 +73,12 @@ namespace JsDebug
 
     Maybe<StackTrace> DebuggerBreak::GetAsyncStackTrace() const
     {
-        return Maybe<StackTrace>();
+        if (m_asyncStackTrace == nullptr)
+        {
+            return Maybe<StackTrace>();
+        }
+
+        return m_asyncStackTrace->clone();
     }
 
     std::unique_ptr<RemoteObject> DebuggerBreak::GetException() const
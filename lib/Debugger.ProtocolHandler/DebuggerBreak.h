@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include "JsPersistent.h"
+#include "JsHandleTable.h"
 #include <ChakraCore.h>
 
 #include <protocol/Debugger.h>
@@ -16,7 +16,13 @@ namespace JsDebug
     class DebuggerBreak
     {
     public:
-        explicit DebuggerBreak(JsValueRef breakInfo);
+        // A break at a breakpoint the client didn't set, such as the end of a
+        // step the debugger resumed, doesn't report it as hit.
+        DebuggerBreak(
+            JsHandleTable* handles,
+            JsValueRef breakInfo,
+            std::unique_ptr<protocol::Runtime::StackTrace> asyncStackTrace,
+            bool hasHitBreakpoint);
 
         protocol::String GetReason() const;
         protocol::Maybe<protocol::DictionaryValue> GetData() const;
@@ -26,6 +32,8 @@ namespace JsDebug
     private:
         std::unique_ptr<protocol::Runtime::RemoteObject> GetException() const;
 
-        JsPersistent m_breakInfo;
+        JsHandle m_breakInfo;
+        std::unique_ptr<protocol::Runtime::StackTrace> m_asyncStackTrace;
+        bool m_hasHitBreakpoint;
     };
 }
@@ -18,9 +18,10 @@ namespace JsDebug
     using protocol::Runtime::RemoteObject;
     using protocol::String;
 
-    DebuggerCallFrame::DebuggerCallFrame(JsValueRef callFrameInfo)
-        : m_callFrameInfo(callFrameInfo)
-        , m_callFrameIndex(PropertyHelpers::GetPropertyInt(m_callFrameInfo.Get(), PropertyHelpers::Names::Index))
+    DebuggerCallFrame::DebuggerCallFrame(JsHandleTable* handles, JsValueRef callFrameInfo)
+        : m_handles(handles)
+        , m_callFrameInfo(handles, callFrameInfo)
+        , m_callFrameIndex(PropertyHelpers::GetPropertyInt(callFrameInfo, PropertyHelpers::Names::Index))
     {
     }
 
@@ -63,7 +64,7 @@ namespace JsDebug
         JsValueRef properties = JS_INVALID_REFERENCE;
         IfJsErrorThrow(JsDiagGetStackProperties(m_callFrameIndex, &properties));
 
-        return DebuggerLocalScope(properties);
+        return DebuggerLocalScope(m_handles, properties);
     }
 
     DebuggerObject DebuggerCallFrame::GetGlobals() const
@@ -71,7 +72,7 @@ namespace JsDebug
         JsValueRef properties = JS_INVALID_REFERENCE;
         IfJsErrorThrow(JsDiagGetStackProperties(m_callFrameIndex, &properties));
 
-        return DebuggerObject(PropertyHelpers::GetProperty(properties, PropertyHelpers::Names::Globals));
+        return DebuggerObject(m_handles, PropertyHelpers::GetProperty(properties, PropertyHelpers::Names::Globals));
     }
 
     std::unique_ptr<RemoteObject> DebuggerCallFrame::Evaluate(
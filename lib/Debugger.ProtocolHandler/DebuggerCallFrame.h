@@ -5,7 +5,7 @@
 
 #include "DebuggerLocalScope.h"
 #include "DebuggerObject.h"
-#include "JsPersistent.h"
+#include "JsHandleTable.h"
 
 #include <ChakraCore.h>
 #include <protocol/Debugger.h>
@@ -15,7 +15,7 @@ namespace JsDebug
     class DebuggerCallFrame
     {
     public:
-        explicit DebuggerCallFrame(JsValueRef callFrameInfo);
+        DebuggerCallFrame(JsHandleTable* handles, JsValueRef callFrameInfo);
 
         int SourceId() const;
         int Line() const;
@@ -45,7 +45,8 @@ namespace JsDebug
         std::unique_ptr<protocol::Debugger::Scope> GetClosureScope(JsValueRef scopeObj) const;
         std::unique_ptr<protocol::Debugger::Scope> GetGlobalScope() const;
 
-        JsPersistent m_callFrameInfo;
+        JsHandleTable* m_handles;
+        JsHandle m_callFrameInfo;
         int m_callFrameIndex;
     };
 }
@@ -10,32 +10,41 @@
 namespace JsDebug
 {
     DebuggerContext::Scope::Scope(const DebuggerContext& context)
+        : m_currentContext(context.m_context.Get())
+        , m_previousContext(JS_INVALID_REFERENCE)
     {
-        JsContextRef currentContext = JS_INVALID_REFERENCE;
-        IfJsErrorThrow(JsGetCurrentContext(&currentContext));
-        m_previousContext = currentContext;
+        IfJsErrorThrow(JsGetCurrentContext(&m_previousContext));
 
-        JsContextRef newContext = context.m_context.Get();
-        IfJsErrorThrow(JsSetCurrentContext(newContext));
-        m_currentContext = newContext;
+        if (m_previousContext != m_currentContext)
+        {
+            IfJsErrorThrow(JsSetCurrentContext(m_currentContext));
+        }
     }
 
     DebuggerContext::Scope::~Scope()
     {
+        if (m_previousContext == m_currentContext)
+        {
+            // Nested inside another scope, which restores the context.
+            return;
+        }
+
+#ifndef NDEBUG
         try
         {
             JsContextRef currentContext = JS_INVALID_REFERENCE;
             IfJsErrorThrow(JsGetCurrentContext(&currentContext));
-            assert(currentContext == m_currentContext.Get());
+            assert(currentContext == m_currentContext);
         }
         catch (const JsErrorException&)
         {
             // Consider this best effort, if it fails still continue and set the previous context.
         }
+#endif
 
         try
         {
-            IfJsErrorThrow(JsSetCurrentContext(m_previousContext.Get()));
+            IfJsErrorThrow(JsSetCurrentContext(m_previousContext));
         }
         catch (const JsErrorException&)
         {
@@ -11,15 +11,21 @@ namespace JsDebug
     class DebuggerContext
     {
     public:
+        // Makes the debugger context current for its lifetime. Scopes are
+        // entered on every debug event and regex call, so they hold raw
+        // references, which the owning DebuggerContext and the host keep
+        // alive, and skip the switch when the context is already current.
         class Scope
         {
         public:
             explicit Scope(const DebuggerContext& context);
             ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
 
         private:
-            JsPersistent m_currentContext;
-            JsPersistent m_previousContext;
+            JsContextRef m_currentContext;
+            JsContextRef m_previousContext;
         };
 
         explicit DebuggerContext(JsRuntimeHandle runtime);
@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "DebuggerCoverage.h"
+
+#include "PropertyHelpers.h"
+
+#include <unordered_set>
+
+namespace JsDebug
+{
+    namespace
+    {
+        // Guards against a line that never resolves past itself.
+        const int c_MaxStatementsPerLine = 1024;
+
+        std::unordered_set<int> GetBreakpointIds()
+        {
+            std::unordered_set<int> ids;
+
+            JsValueRef breakpoints = JS_INVALID_REFERENCE;
+            if (JsDiagGetBreakpoints(&breakpoints) == JsNoError)
+            {
+                int length = PropertyHelpers::GetPropertyInt(breakpoints, PropertyHelpers::Names::Length);
+
+                for (int index = 0; index < length; index++)
+                {
+                    JsValueRef breakpoint = PropertyHelpers::GetIndexedProperty(breakpoints, index);
+                    ids.insert(PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId));
+                }
+            }
+
+            return ids;
+        }
+    }
+
+    DebuggerCoverage::DebuggerCoverage()
+        : m_isStarted(false)
+    {
+    }
+
+    void DebuggerCoverage::Start()
+    {
+        Stop();
+        m_isStarted = true;
+    }
+
+    void DebuggerCoverage::Stop()
+    {
+        for (const auto& breakpoint : m_breakpoints)
+        {
+            JsDiagRemoveBreakpoint(breakpoint.first);
+        }
+
+        m_breakpoints.clear();
+        m_scripts.clear();
+        m_scriptIndex.clear();
+        m_positionIndex.clear();
+        m_isStarted = false;
+    }
+
+    bool DebuggerCoverage::IsStarted() const
+    {
+        return m_isStarted;
+    }
+
+    void DebuggerCoverage::AddScript(int scriptId, int lineCount)
+    {
+        if (!m_isStarted || m_scriptIndex.find(scriptId) != m_scriptIndex.end())
+        {
+            return;
+        }
+
+        size_t scriptIndex = m_scripts.size();
+        m_scripts.push_back(Script { scriptId });
+        m_scriptIndex.emplace(scriptId, scriptIndex);
+        m_positionIndex.emplace_back();
+
+        Script& script = m_scripts.back();
+        std::unordered_map<int64_t, uint32_t>& positions = m_positionIndex.back();
+
+        // Breakpoints that already exist are still recorded as positions, but
+        // hits on them are reported by their owner through HandleBreakpoint.
+        std::unordered_set<int> existing = GetBreakpointIds();
+
+        // The engine resolves a requested position to the next statement, so
+        // walk each line by asking again just past the last statement found.
+        for (int line = 0; line < lineCount; line++)
+        {
+            int column = 0;
+
+            for (int count = 0; count < c_MaxStatementsPerLine; count++)
+            {
+                JsValueRef breakpoint = JS_INVALID_REFERENCE;
+                if (JsDiagSetBreakpoint(scriptId, line, column, &breakpoint) != JsNoError)
+                {
+                    break;
+                }
+
+                int breakpointId = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId);
+                int actualLine = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::Line);
+                int actualColumn = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::Column);
+
+                auto inserted = positions.emplace(
+                    GetPositionKey(actualLine, actualColumn),
+                    static_cast<uint32_t>(script.positions.size()));
+
+                if (!inserted.second)
+                {
+                    break;
+                }
+
+                script.positions.push_back(Position { actualLine, actualColumn });
+                script.hits.push_back(false);
+
+                if (existing.insert(breakpointId).second)
+                {
+                    m_breakpoints.emplace(breakpointId, BreakpointTarget { scriptIndex, inserted.first->second });
+                }
+
+                if (actualLine != line || actualColumn < column)
+                {
+                    break;
+                }
+
+                column = actualColumn + 1;
+            }
+        }
+    }
+
+    bool DebuggerCoverage::HandleBreakpoint(int breakpointId, int scriptId, int line, int column)
+    {
+        if (!m_isStarted)
+        {
+            return false;
+        }
+
+        auto breakpoint = m_breakpoints.find(breakpointId);
+        if (breakpoint != m_breakpoints.end())
+        {
+            m_scripts[breakpoint->second.script].hits[breakpoint->second.position] = true;
+            JsDiagRemoveBreakpoint(breakpointId);
+            m_breakpoints.erase(breakpoint);
+
+            return true;
+        }
+
+        // Someone else's breakpoint on a recorded statement still counts.
+        auto scriptIndex = m_scriptIndex.find(scriptId);
+        if (scriptIndex != m_scriptIndex.end())
+        {
+            const auto& positions = m_positionIndex[scriptIndex->second];
+            auto position = positions.find(GetPositionKey(line, column));
+
+            if (position != positions.end())
+            {
+                m_scripts[scriptIndex->second].hits[position->second] = true;
+            }
+        }
+
+        return false;
+    }
+
+    bool DebuggerCoverage::OwnsBreakpoint(int breakpointId) const
+    {
+        return m_breakpoints.find(breakpointId) != m_breakpoints.end();
+    }
+
+    void DebuggerCoverage::Release(int breakpointId)
+    {
+        m_breakpoints.erase(breakpointId);
+    }
+
+    std::vector<DebuggerCoverage::Script> DebuggerCoverage::Take()
+    {
+        std::vector<Script> result = m_scripts;
+        std::unordered_set<int> existing = GetBreakpointIds();
+
+        for (size_t scriptIndex = 0; scriptIndex < m_scripts.size(); ++scriptIndex)
+        {
+            Script& script = m_scripts[scriptIndex];
+
+            for (uint32_t position = 0; position < script.positions.size(); ++position)
+            {
+                if (!script.hits[position])
+                {
+                    continue;
+                }
+
+                script.hits[position] = false;
+
+                JsValueRef breakpoint = JS_INVALID_REFERENCE;
+                if (JsDiagSetBreakpoint(
+                    script.scriptId,
+                    script.positions[position].line,
+                    script.positions[position].column,
+                    &breakpoint) == JsNoError)
+                {
+                    int breakpointId = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId);
+
+                    if (existing.insert(breakpointId).second)
+                    {
+                        m_breakpoints.emplace(breakpointId, BreakpointTarget { scriptIndex, position });
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    int64_t DebuggerCoverage::GetPositionKey(int line, int column)
+    {
+        return (static_cast<int64_t>(line) << 32) | static_cast<uint32_t>(column);
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <ChakraCore.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace JsDebug
+{
+    /// <summary>
+    /// Records which statements have run, using one-shot engine breakpoints.
+    /// Each breakpoint is removed on its first hit, so code that has already
+    /// been covered runs at full speed.
+    /// </summary>
+    class DebuggerCoverage
+    {
+    public:
+        struct Position
+        {
+            int line;
+            int column;
+        };
+
+        struct Script
+        {
+            int scriptId;
+            std::vector<Position> positions;
+            std::vector<bool> hits;
+        };
+
+        DebuggerCoverage();
+        DebuggerCoverage(const DebuggerCoverage&) = delete;
+        DebuggerCoverage& operator=(const DebuggerCoverage&) = delete;
+
+        void Start();
+        void Stop();
+        bool IsStarted() const;
+
+        // Place a breakpoint at every statement of the script.
+        void AddScript(int scriptId, int lineCount);
+
+        // Record a hit at the given location, whoever owns the breakpoint.
+        // Returns true if the breakpoint belongs to the coverage recorder.
+        bool HandleBreakpoint(int breakpointId, int scriptId, int line, int column);
+        bool OwnsBreakpoint(int breakpointId) const;
+
+        // Stop tracking a breakpoint that was claimed for another purpose.
+        void Release(int breakpointId);
+
+        // Return the hits so far, clear them, and re-arm the covered statements.
+        std::vector<Script> Take();
+
+    private:
+        struct BreakpointTarget
+        {
+            size_t script;
+            uint32_t position;
+        };
+
+        static int64_t GetPositionKey(int line, int column);
+
+        bool m_isStarted;
+        std::vector<Script> m_scripts;
+        std::unordered_map<int, size_t> m_scriptIndex;
+        std::vector<std::unordered_map<int64_t, uint32_t>> m_positionIndex;
+        std::unordered_map<int, BreakpointTarget> m_breakpoints;
+    };
+}
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "DebuggerHitCounter.h"
+
+#include "PropertyHelpers.h"
+
+namespace JsDebug
+{
+    DebuggerHitCounter::DebuggerHitCounter()
+        : m_maxHits(0)
+    {
+    }
+
+    void DebuggerHitCounter::Start(int maxHits)
+    {
+        Reset();
+        m_maxHits = maxHits;
+    }
+
+    void DebuggerHitCounter::Stop()
+    {
+        for (const auto& breakpoint : m_breakpoints)
+        {
+            JsDiagRemoveBreakpoint(breakpoint.first);
+        }
+
+        m_breakpoints.clear();
+        m_scripts.clear();
+    }
+
+    void DebuggerHitCounter::Reset()
+    {
+        Stop();
+        m_locations.clear();
+    }
+
+    void DebuggerHitCounter::AddScript(int scriptId, int lineCount)
+    {
+        if (m_maxHits <= 0 || !m_scripts.insert(scriptId).second)
+        {
+            return;
+        }
+
+        // Breakpoints that already exist belong to someone else. The engine
+        // hands back the existing breakpoint when a request snaps onto a
+        // statement that already has one, so this also skips duplicates.
+        std::unordered_set<int> existing;
+
+        JsValueRef breakpoints = JS_INVALID_REFERENCE;
+        if (JsDiagGetBreakpoints(&breakpoints) == JsNoError)
+        {
+            int length = PropertyHelpers::GetPropertyInt(breakpoints, PropertyHelpers::Names::Length);
+
+            for (int index = 0; index < length; index++)
+            {
+                JsValueRef breakpoint = PropertyHelpers::GetIndexedProperty(breakpoints, index);
+                existing.insert(PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId));
+            }
+        }
+
+        for (int line = 0; line < lineCount; line++)
+        {
+            JsValueRef breakpoint = JS_INVALID_REFERENCE;
+            if (JsDiagSetBreakpoint(scriptId, line, 0, &breakpoint) != JsNoError)
+            {
+                continue;
+            }
+
+            int breakpointId = PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::BreakpointId);
+            if (!existing.insert(breakpointId).second)
+            {
+                continue;
+            }
+
+            m_breakpoints.emplace(breakpointId, m_locations.size());
+            m_locations.push_back(Location {
+                scriptId,
+                PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::Line),
+                PropertyHelpers::GetPropertyInt(breakpoint, PropertyHelpers::Names::Column),
+                0 });
+        }
+    }
+
+    bool DebuggerHitCounter::HandleBreakpoint(int breakpointId)
+    {
+        auto breakpoint = m_breakpoints.find(breakpointId);
+        if (breakpoint == m_breakpoints.end())
+        {
+            return false;
+        }
+
+        if (++m_locations[breakpoint->second].hitCount >= m_maxHits)
+        {
+            JsDiagRemoveBreakpoint(breakpointId);
+            m_breakpoints.erase(breakpoint);
+        }
+
+        return true;
+    }
+
+    bool DebuggerHitCounter::OwnsBreakpoint(int breakpointId) const
+    {
+        return m_breakpoints.find(breakpointId) != m_breakpoints.end();
+    }
+
+    void DebuggerHitCounter::Release(int breakpointId)
+    {
+        m_breakpoints.erase(breakpointId);
+    }
+
+    const std::vector<DebuggerHitCounter::Location>& DebuggerHitCounter::GetLocations() const
+    {
+        return m_locations;
+    }
+}
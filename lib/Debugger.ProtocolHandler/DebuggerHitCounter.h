@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <ChakraCore.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace JsDebug
+{
+    /// <summary>
+    /// Counts statement hits using engine breakpoints that the debugger never
+    /// pauses on. Each breakpoint removes itself once it reaches the hit limit,
+    /// so the cost of a hot location is bounded.
+    /// </summary>
+    class DebuggerHitCounter
+    {
+    public:
+        struct Location
+        {
+            int scriptId;
+            int line;
+            int column;
+            int hitCount;
+        };
+
+        DebuggerHitCounter();
+        DebuggerHitCounter(const DebuggerHitCounter&) = delete;
+        DebuggerHitCounter& operator=(const DebuggerHitCounter&) = delete;
+
+        void Start(int maxHits);
+        void Stop();
+        void Reset();
+
+        // Place a breakpoint at the first statement of every line of the script.
+        void AddScript(int scriptId, int lineCount);
+
+        // Returns true if the breakpoint belongs to the counter.
+        bool HandleBreakpoint(int breakpointId);
+        bool OwnsBreakpoint(int breakpointId) const;
+
+        // Stop counting at a breakpoint that was claimed for another purpose.
+        void Release(int breakpointId);
+
+        const std::vector<Location>& GetLocations() const;
+
+    private:
+        int m_maxHits;
+        std::vector<Location> m_locations;
+        std::unordered_map<int, size_t> m_breakpoints;
+        std::unordered_set<int> m_scripts;
+    };
+}
@@ -17,6 +17,7 @@ namespace JsDebug
 {
     using protocol::Array;
     using protocol::Debugger::CallFrame;
+    using protocol::Debugger::EvaluateBatchResult;
     using protocol::Debugger::Location;
     using protocol::FrontendChannel;
     using protocol::Maybe;
@@ -33,6 +34,7 @@ namespace JsDebug
         const char c_ErrorBreakpointNotFound[] = "Breakpoint could not be found";
         const char c_ErrorCallFrameInvalidId[] = "Invalid call frame ID specified";
         const char c_ErrorInvalidColumnNumber[] = "Invalid column number specified";
+        const char c_ErrorInvalidDepth[] = "Depth must be non-negative";
         const char c_ErrorNotEnabled[] = "Debugger is not enabled";
         const char c_ErrorNotImplemented[] = "Debugger method not implemented";
         const char c_ErrorScriptMustBeLoaded[] = "Script must be loaded before resolving";
@@ -86,10 +88,12 @@ namespace JsDebug
         m_debugger->SetSourceEventHandler(nullptr, nullptr);
         m_debugger->SetBreakEventHandler(nullptr, nullptr);
         m_debugger->SetResumeEventHandler(nullptr, nullptr);
+        m_debugger->SetAsyncCallStackDepth(0);
 
         m_breakpointMap.clear();
         m_scriptMap.clear();
         m_shouldSkipAllPauses = false;
+        UpdateStatistics();
 
         return Response::OK();
     }
@@ -181,6 +185,7 @@ namespace JsDebug
         {
             *out_breakpointId = breakpointId;
             m_breakpointMap.emplace(breakpointId, breakpoint);
+            UpdateStatistics();
         }
 
         return Response::OK();
@@ -213,6 +218,7 @@ namespace JsDebug
             {
                 *out_breakpointId = breakpointId;
                 m_breakpointMap.emplace(breakpointId, breakpoint);
+                UpdateStatistics();
             }
 
             return Response::OK();
@@ -228,6 +234,7 @@ namespace JsDebug
         {
             m_debugger->RemoveBreakpoint(result->second);
             m_breakpointMap.erase(in_breakpointId);
+            UpdateStatistics();
             return Response::OK();
         }
 
@@ -378,6 +385,69 @@ namespace JsDebug
         return Response::Error(c_ErrorCallFrameInvalidId);
     }
 
+    Response DebuggerImpl::evaluateBatchOnCallFrame(
+        const String & in_callFrameId,
+        std::unique_ptr<Array<String>> in_expressions,
+        Maybe<String> /*in_objectGroup*/,
+        Maybe<bool> in_returnByValue,
+        std::unique_ptr<Array<EvaluateBatchResult>>* out_results)
+    {
+        // As for evaluateOnCallFrame, the group is ignored. Results are held
+        // by the break and released on resume.
+        auto parsedId = ProtocolHelpers::ParseObjectId(in_callFrameId);
+
+        int ordinal = 0;
+        if (!parsedId->getInteger(PropertyHelpers::Names::Ordinal, &ordinal))
+        {
+            return Response::Error(c_ErrorCallFrameInvalidId);
+        }
+
+        // Resolve the frame once for the whole batch rather than walking the
+        // stack for every expression.
+        auto callFrame = m_debugger->GetCallFrame(ordinal);
+        bool returnByValue = in_returnByValue.fromMaybe(false);
+
+        auto results = Array<EvaluateBatchResult>::create();
+        size_t length = in_expressions->length();
+
+        for (size_t index = 0; index < length; ++index)
+        {
+            std::unique_ptr<ExceptionDetails> exceptionDetails;
+            std::unique_ptr<protocol::Runtime::RemoteObject> result;
+
+            // A failure in one expression must not prevent the others from
+            // being evaluated, so engine errors are reported per entry.
+            try
+            {
+                result = callFrame.Evaluate(in_expressions->get(index), returnByValue, &exceptionDetails);
+            }
+            catch (const JsErrorException& e)
+            {
+                result = ProtocolHelpers::GetUndefinedObject();
+                exceptionDetails = ExceptionDetails::create()
+                    .setExceptionId(0)
+                    .setText(e.what())
+                    .setLineNumber(0)
+                    .setColumnNumber(0)
+                    .build();
+            }
+
+            auto entry = EvaluateBatchResult::create()
+                .setResult(std::move(result))
+                .build();
+
+            if (exceptionDetails != nullptr)
+            {
+                entry->setExceptionDetails(std::move(exceptionDetails));
+            }
+
+            results->addItem(std::move(entry));
+        }
+
+        *out_results = std::move(results);
+        return Response::OK();
+    }
+
     Response DebuggerImpl::setVariableValue(
         int /*in_scopeNumber*/,
         const String & /*in_variableName*/,
@@ -387,9 +457,15 @@ namespace JsDebug
         return Response::Error(c_ErrorNotImplemented);
     }
 
-    Response DebuggerImpl::setAsyncCallStackDepth(int /*in_maxDepth*/)
+    Response DebuggerImpl::setAsyncCallStackDepth(int in_maxDepth)
     {
-        return Response::Error(c_ErrorNotImplemented);
+        if (in_maxDepth < 0)
+        {
+            return Response::Error(c_ErrorInvalidDepth);
+        }
+
+        m_debugger->SetAsyncCallStackDepth(in_maxDepth);
+        return Response::OK();
     }
 
     Response DebuggerImpl::setBlackboxPatterns(std::unique_ptr<Array<String>> in_patterns)
@@ -428,6 +504,38 @@ namespace JsDebug
     }
 
     void DebuggerImpl::HandleSourceEvent(const DebuggerScript& script, bool success)
+    {
+        // The stored copy is the one used from here on, so the source URLs it
+        // may parse for the notification or breakpoints are kept with it.
+        const DebuggerScript& storedScript = m_scriptMap.emplace(script.ScriptId(), script).first->second;
+        UpdateStatistics();
+
+        bool isEventEnabled = m_handler->IsEventEnabled(
+            success ? SessionEvent::ScriptParsed : SessionEvent::ScriptFailedToParse);
+
+        if (isEventEnabled)
+        {
+            SendSourceEvent(storedScript, success);
+        }
+
+        // Breakpoints are still resolved when the notification is masked.
+        bool isResolvedEventEnabled = m_handler->IsEventEnabled(SessionEvent::BreakpointResolved);
+
+        for (auto& breakpoint : m_breakpointMap)
+        {
+            if (breakpoint.second.TryLoadScript(storedScript))
+            {
+                if (TryResolveBreakpoint(breakpoint.second) && isResolvedEventEnabled)
+                {
+                    m_frontend.breakpointResolved(
+                        breakpoint.first,
+                        breakpoint.second.GetActualLocation());
+                }
+            }
+        }
+    }
+
+    void DebuggerImpl::SendSourceEvent(const DebuggerScript& script, bool success)
     {
         String16 scriptId = script.ScriptId();
         String16 scriptUrl = script.SourceUrl();
@@ -470,21 +578,6 @@ namespace JsDebug
                 script.SourceMappingUrl(),
                 script.HasSourceUrl());
         }
-
-        m_scriptMap.emplace(scriptId, script);
-
-        for (auto& breakpoint : m_breakpointMap)
-        {
-            if (breakpoint.second.TryLoadScript(script))
-            {
-                if (TryResolveBreakpoint(breakpoint.second))
-                {
-                    m_frontend.breakpointResolved(
-                        breakpoint.first,
-                        breakpoint.second.GetActualLocation());
-                }
-            }
-        }
     }
 
     SkipPauseRequest DebuggerImpl::HandleBreakEvent(const DebuggerBreak& breakInfo)
@@ -546,6 +639,13 @@ namespace JsDebug
         return false;
     }
 
+    void DebuggerImpl::UpdateStatistics()
+    {
+        HandlerStatistics& statistics = m_handler->GetStatistics();
+        statistics.scriptCount = static_cast<uint32_t>(m_scriptMap.size());
+        statistics.breakpointCount = static_cast<uint32_t>(m_breakpointMap.size());
+    }
+
     bool DebuggerImpl::TryResolveBreakpoint(DebuggerBreakpoint& breakpoint)
     {
         if (!breakpoint.IsScriptLoaded())
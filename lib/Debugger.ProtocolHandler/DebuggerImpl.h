@@ -81,6 +81,12 @@ namespace JsDebug
             protocol::Maybe<bool> in_generatePreview,
             std::unique_ptr<protocol::Runtime::RemoteObject>* out_result,
             protocol::Maybe<protocol::Runtime::ExceptionDetails>* out_exceptionDetails) override;
+        protocol::Response evaluateBatchOnCallFrame(
+            const protocol::String& in_callFrameId,
+            std::unique_ptr<protocol::Array<protocol::String>> in_expressions,
+            protocol::Maybe<protocol::String> in_objectGroup,
+            protocol::Maybe<bool> in_returnByValue,
+            std::unique_ptr<protocol::Array<protocol::Debugger::EvaluateBatchResult>>* out_results) override;
         protocol::Response setVariableValue(
             int in_scopeNumber,
             const protocol::String& in_variableName,
@@ -100,6 +106,7 @@ namespace JsDebug
 
         bool IsEnabled();
         void HandleSourceEvent(const DebuggerScript& script, bool success);
+        void SendSourceEvent(const DebuggerScript& script, bool success);
         SkipPauseRequest HandleBreakEvent(const DebuggerBreak& breakInfo);
         void HandleResumeEvent();
 
@@ -113,6 +120,9 @@ namespace JsDebug
         // succeed.
         bool ActualBreakpointExists(DebuggerBreakpoint& breakpoint);
 
+        // Publishes the map sizes for the host to read.
+        void UpdateStatistics();
+
         ProtocolHandler* m_handler;
         protocol::Debugger::Frontend m_frontend;
         Debugger* m_debugger;
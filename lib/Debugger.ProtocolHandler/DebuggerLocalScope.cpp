@@ -13,8 +13,8 @@ namespace JsDebug
     using protocol::Runtime::InternalPropertyDescriptor;
     using protocol::Runtime::PropertyDescriptor;
 
-    DebuggerLocalScope::DebuggerLocalScope(JsValueRef stackProperties)
-        : DebuggerObject(stackProperties)
+    DebuggerLocalScope::DebuggerLocalScope(JsHandleTable* handles, JsValueRef stackProperties)
+        : DebuggerObject(handles, stackProperties)
     {
     }
 
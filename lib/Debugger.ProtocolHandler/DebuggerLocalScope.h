@@ -10,7 +10,7 @@ namespace JsDebug
     class DebuggerLocalScope : public DebuggerObject
     {
     public:
-        explicit DebuggerLocalScope(JsValueRef stackProperties);
+        DebuggerLocalScope(JsHandleTable* handles, JsValueRef stackProperties);
 
         std::unique_ptr<protocol::Array<protocol::Runtime::PropertyDescriptor>>
             GetPropertyDescriptors() const override;
@@ -4,6 +4,7 @@
 #include "stdafx.h"
 #include "DebuggerObject.h"
 
+#include "ErrorHelpers.h"
 #include "PropertyHelpers.h"
 #include "ProtocolHelpers.h"
 
@@ -18,8 +19,8 @@ namespace JsDebug
         const int c_MaxPropertyCount = 5000;
     }
 
-    DebuggerObject::DebuggerObject(JsValueRef obj)
-        : m_object(obj)
+    DebuggerObject::DebuggerObject(JsHandleTable* handles, JsValueRef obj)
+        : m_object(handles, obj)
         , m_handle(-1)
     {
         int handle = 0;
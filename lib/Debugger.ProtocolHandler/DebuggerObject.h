@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include "JsPersistent.h"
+#include "JsHandleTable.h"
 
 #include <protocol/Runtime.h>
 
@@ -12,7 +12,7 @@ namespace JsDebug
     class DebuggerObject
     {
     public:
-        explicit DebuggerObject(JsValueRef obj);
+        DebuggerObject(JsHandleTable* handles, JsValueRef obj);
 
         virtual std::unique_ptr<protocol::Array<protocol::Runtime::PropertyDescriptor>>
             GetPropertyDescriptors() const;
@@ -20,7 +20,7 @@ namespace JsDebug
             GetInternalPropertyDescriptors() const;
 
     protected:
-        JsPersistent m_object;
+        JsHandle m_object;
         int m_handle;
     };
 }
@@ -6,7 +6,6 @@
 
 #include "Debugger.h"
 #include "DebuggerRegExp.h"
-#include "ErrorHelpers.h"
 #include "PropertyHelpers.h"
 
 namespace JsDebug
@@ -31,21 +30,25 @@ namespace JsDebug
 
     DebuggerScript::DebuggerScript(Debugger* debugger, JsValueRef scriptInfo)
         : m_debugger(debugger)
-        , m_scriptInfo(scriptInfo)
         , m_scriptId(0)
+        , m_lineCount(0)
+        , m_isSourceParsed(false)
     {
-        if (!m_scriptInfo.IsEmpty())
+        if (scriptInfo != JS_INVALID_REFERENCE)
         {
-            if (PropertyHelpers::HasProperty(m_scriptInfo.Get(), PropertyHelpers::Names::ScriptId))
+            if (PropertyHelpers::HasProperty(scriptInfo, PropertyHelpers::Names::ScriptId))
             {
-                m_scriptId = PropertyHelpers::GetPropertyInt(m_scriptInfo.Get(), PropertyHelpers::Names::ScriptId);
+                m_scriptId = PropertyHelpers::GetPropertyInt(scriptInfo, PropertyHelpers::Names::ScriptId);
+                m_lineCount = PropertyHelpers::GetPropertyInt(scriptInfo, PropertyHelpers::Names::LineCount);
 
-                JsValueRef scriptSource = JS_INVALID_REFERENCE;
-                IfJsErrorThrow(JsDiagGetSource(m_scriptId, &scriptSource));
-                m_scriptSource = scriptSource;
+                // Check the fileName property first
+                if (!PropertyHelpers::TryGetProperty(scriptInfo, PropertyHelpers::Names::FileName, &m_url))
+                {
+                    // Fall back to the scriptType property
+                    PropertyHelpers::TryGetProperty(scriptInfo, PropertyHelpers::Names::ScriptType, &m_url);
+                }
 
                 // TODO: calculate file hash
-                ParseScriptSource();
             }
         }
     }
@@ -57,23 +60,12 @@ namespace JsDebug
 
     String DebuggerScript::Url() const
     {
-        String fileName;
-
-        if (!m_scriptInfo.IsEmpty())
-        {
-            // Check the fileName property first
-            if (!PropertyHelpers::TryGetProperty(m_scriptInfo.Get(), PropertyHelpers::Names::FileName, &fileName))
-            {
-                // Fall back to the scriptType property
-                PropertyHelpers::TryGetProperty(m_scriptInfo.Get(), PropertyHelpers::Names::ScriptType, &fileName);
-            }
-        }
-
-        return fileName;
+        return m_url;
     }
 
     bool DebuggerScript::HasSourceUrl() const
     {
+        ParseScriptSource();
         return !m_sourceUrl.empty();
     }
 
@@ -84,14 +76,17 @@ namespace JsDebug
 
     String DebuggerScript::SourceMappingUrl() const
     {
+        ParseScriptSource();
         return m_sourceMappingUrl;
     }
 
     String DebuggerScript::Source() const
     {
-        if (!m_scriptSource.IsEmpty())
+        JsValueRef scriptSource = m_debugger->GetScriptSource(m_scriptId);
+
+        if (scriptSource != JS_INVALID_REFERENCE)
         {
-            return PropertyHelpers::GetPropertyString(m_scriptSource.Get(), PropertyHelpers::Names::Source);
+            return PropertyHelpers::GetPropertyString(scriptSource, PropertyHelpers::Names::Source);
         }
 
         return String();
@@ -114,12 +109,7 @@ namespace JsDebug
 
     int DebuggerScript::EndLine() const
     {
-        if (!m_scriptInfo.IsEmpty())
-        {
-            return PropertyHelpers::GetPropertyInt(m_scriptInfo.Get(), PropertyHelpers::Names::LineCount);
-        }
-
-        return 0;
+        return m_lineCount;
     }
 
     int DebuggerScript::EndColumn() const
@@ -142,12 +132,25 @@ namespace JsDebug
         return false;
     }
 
-    void DebuggerScript::ParseScriptSource()
+    void DebuggerScript::ParseScriptSource() const
     {
+        if (m_isSourceParsed)
+        {
+            return;
+        }
+
+        m_isSourceParsed = true;
+
+        JsValueRef scriptSource = m_debugger->GetScriptSource(m_scriptId);
+        if (scriptSource == JS_INVALID_REFERENCE)
+        {
+            return;
+        }
+
         DebuggerRegExp regExp(m_debugger, c_SourceInfoCommentPattern, c_SourceInfoCommentFlags);
         std::vector<String> matchGroups;
 
-        JsValueRef sourceValue = PropertyHelpers::GetProperty(m_scriptSource.Get(), PropertyHelpers::Names::Source);
+        JsValueRef sourceValue = PropertyHelpers::GetProperty(scriptSource, PropertyHelpers::Names::Source);
 
         while (true)
         {
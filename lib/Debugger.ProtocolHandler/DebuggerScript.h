@@ -3,8 +3,6 @@
 
 #pragma once
 
-#include "JsPersistent.h"
-
 #include <StringUtil.h>
 #include <ChakraCore.h>
 
@@ -33,15 +31,18 @@ namespace JsDebug
         bool IsLiveEdit() const;
 
     private:
-        void ParseScriptSource();
+        // The source is only read and searched for its URL comments when one
+        // of them is asked for, so scripts no one looks at cost nothing.
+        void ParseScriptSource() const;
 
         Debugger* m_debugger;
-        JsPersistent m_scriptInfo;
-        JsPersistent m_scriptSource;
 
         int m_scriptId;
-        protocol::String m_sourceUrl;
-        protocol::String m_sourceMappingUrl;
+        protocol::String m_url;
+        int m_lineCount;
+        mutable bool m_isSourceParsed;
+        mutable protocol::String m_sourceUrl;
+        mutable protocol::String m_sourceMappingUrl;
         protocol::String m_hash;
     };
 }
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "FunctionTable.h"
+
+#include "Debugger.h"
+#include "ErrorHelpers.h"
+#include "PropertyHelpers.h"
+
+namespace JsDebug
+{
+    using protocol::Runtime::CallFrame;
+    using protocol::String;
+
+    FunctionTable::FunctionTable()
+    {
+    }
+
+    void FunctionTable::Clear()
+    {
+        m_functions.clear();
+        m_functionIds.clear();
+        m_builtInIds.clear();
+    }
+
+    uint32_t FunctionTable::Intern(int functionHandle)
+    {
+        JsValueRef functionObj = JS_INVALID_REFERENCE;
+        IfJsErrorThrow(JsDiagGetObjectFromHandle(functionHandle, &functionObj));
+
+        // Host and built-in functions don't carry a location; they are keyed
+        // on their name alone.
+        int scriptId = -1;
+        int line = -1;
+        int column = -1;
+        if (PropertyHelpers::HasProperty(functionObj, PropertyHelpers::Names::ScriptId))
+        {
+            scriptId = PropertyHelpers::GetPropertyIntConvert(functionObj, PropertyHelpers::Names::ScriptId);
+            line = PropertyHelpers::GetPropertyInt(functionObj, PropertyHelpers::Names::Line);
+            column = PropertyHelpers::GetPropertyInt(functionObj, PropertyHelpers::Names::Column);
+        }
+
+        String name;
+        PropertyHelpers::TryGetProperty(functionObj, PropertyHelpers::Names::Name, &name);
+
+        uint32_t id = static_cast<uint32_t>(m_functions.size());
+
+        if (scriptId >= 0)
+        {
+            auto existing = m_functionIds.emplace(std::make_tuple(scriptId, line, column), id);
+            if (!existing.second)
+            {
+                return existing.first->second;
+            }
+        }
+        else
+        {
+            auto existing = m_builtInIds.emplace(name.toUtf8(), id);
+            if (!existing.second)
+            {
+                return existing.first->second;
+            }
+        }
+
+        m_functions.push_back(Function { scriptId, line, column, name });
+        return id;
+    }
+
+    std::unique_ptr<CallFrame> FunctionTable::ToCallFrame(uint32_t function, const std::map<int, String>& scriptUrls) const
+    {
+        const Function& info = m_functions[function];
+        auto url = scriptUrls.find(info.scriptId);
+
+        return CallFrame::create()
+            .setFunctionName(info.name)
+            .setScriptId(String::fromInteger(info.scriptId))
+            .setUrl(url != scriptUrls.end() ? url->second : String())
+            .setLineNumber(info.line)
+            .setColumnNumber(info.column)
+            .build();
+    }
+
+    std::map<int, String> FunctionTable::GetScriptUrls(Debugger* debugger) const
+    {
+        std::map<int, String> scriptUrls;
+        if (!m_functions.empty())
+        {
+            for (const DebuggerScript& script : debugger->GetScripts())
+            {
+                scriptUrls[script.ScriptId().toInteger()] = script.Url();
+            }
+        }
+
+        return scriptUrls;
+    }
+
+    std::unique_ptr<CallFrame> FunctionTable::SyntheticCallFrame(const char* name)
+    {
+        return CallFrame::create()
+            .setFunctionName(name)
+            .setScriptId("0")
+            .setUrl("")
+            .setLineNumber(-1)
+            .setColumnNumber(-1)
+            .build();
+    }
+}
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Runtime.h>
+
+#include <ChakraCore.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace JsDebug
+{
+    class Debugger;
+
+    /// <summary>
+    /// Functions seen by a profiler, interned by location. Diagnostic handles
+    /// only last for a single break, so each function is resolved once and
+    /// referred to by its index from then on.
+    /// </summary>
+    class FunctionTable
+    {
+    public:
+        FunctionTable();
+        FunctionTable(const FunctionTable&) = delete;
+        FunctionTable& operator=(const FunctionTable&) = delete;
+
+        void Clear();
+
+        // Must be called while the engine is at a break.
+        uint32_t Intern(int functionHandle);
+
+        std::unique_ptr<protocol::Runtime::CallFrame> ToCallFrame(uint32_t function, const std::map<int, protocol::String>& scriptUrls) const;
+
+        // URLs of the scripts the interned functions may refer to.
+        std::map<int, protocol::String> GetScriptUrls(Debugger* debugger) const;
+
+        // Call frame for a node that doesn't correspond to a function.
+        static std::unique_ptr<protocol::Runtime::CallFrame> SyntheticCallFrame(const char* name);
+
+    private:
+        struct Function
+        {
+            int scriptId;
+            int line;
+            int column;
+            protocol::String name;
+        };
+
+        std::vector<Function> m_functions;
+        std::map<std::tuple<int, int, int>, uint32_t> m_functionIds;
+        std::map<std::string, uint32_t> m_builtInIds;
+    };
+}
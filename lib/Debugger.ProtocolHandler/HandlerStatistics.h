@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace JsDebug
+{
+    // Counters kept up to date by the protocol handler and its debugger as they
+    // work, so the host can read them from any thread without taking a lock or
+    // waiting for the engine. Each value is consistent on its own, but a set of
+    // them read together is not a snapshot.
+    struct HandlerStatistics
+    {
+        std::atomic<uint32_t> queuedCommands { 0 };
+        std::atomic<bool> isBreakPending { false };
+
+        // Zero when no commands are queued, otherwise when the script thread
+        // last took one, or when the first was queued if it has taken none.
+        std::atomic<int64_t> queueWaitStartTime { 0 };
+
+        // Zero while running, otherwise when the current pause began.
+        std::atomic<int64_t> pauseStartTime { 0 };
+        std::atomic<uint64_t> pausedMicroseconds { 0 };
+
+        std::atomic<uint32_t> scriptCount { 0 };
+        std::atomic<uint32_t> breakpointCount { 0 };
+        std::atomic<uint32_t> retainedValueCount { 0 };
+
+        std::atomic<uint64_t> bytesReceived { 0 };
+        std::atomic<uint64_t> bytesSent { 0 };
+
+        // Memory held on behalf of debugging sessions, by subsystem, which is
+        // what the memory budget is checked against.
+        std::atomic<uint64_t> queuedCommandBytes { 0 };
+        std::atomic<uint64_t> scriptSourceBytes { 0 };
+        std::atomic<uint64_t> consoleBytes { 0 };
+        std::atomic<uint64_t> compiledScriptBytes { 0 };
+        std::atomic<uint64_t> snapshotBytes { 0 };
+
+        uint64_t RetainedBytes() const
+        {
+            return queuedCommandBytes + scriptSourceBytes + consoleBytes + compiledScriptBytes + snapshotBytes;
+        }
+
+        static int64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    };
+}
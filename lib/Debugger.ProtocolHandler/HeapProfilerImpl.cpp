@@ -0,0 +1,225 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "HeapProfilerImpl.h"
+
+#include "ErrorHelpers.h"
+#include "HeapSnapshot.h"
+#include "ProtocolHandler.h"
+
+namespace JsDebug
+{
+    using protocol::FrontendChannel;
+    using protocol::HeapProfiler::SamplingHeapProfile;
+    using protocol::Maybe;
+    using protocol::Response;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_ErrorInvalidInterval[] = "Sampling interval must be positive";
+        const char c_ErrorNoScriptRunning[] = "No script is running or paused to take a snapshot of";
+        const char c_ErrorSamplingNotStarted[] = "Sampling heap profiler is not started";
+
+        const char c_AllocationSampleRequest[] = "HeapProfiler.allocationSample";
+
+        // The same default as other inspector backends.
+        const double c_DefaultSamplingInterval = 32768;
+
+        // Each chunk goes out as its own notification, so this also bounds the
+        // size of any single message the client has to take in.
+        const size_t c_SnapshotChunkSize = 64 * 1024;
+
+        // Nodes expanded between progress reports.
+        const uint32_t c_SnapshotNodesPerSlice = 1000;
+    }
+
+    HeapProfilerImpl::HeapProfilerImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel, Debugger* debugger, MemoryMonitor* memoryMonitor)
+        : m_handler(handler)
+        , m_frontend(frontendChannel)
+        , m_debugger(debugger)
+        , m_memoryMonitor(memoryMonitor)
+        , m_isEnabled(false)
+    {
+    }
+
+    HeapProfilerImpl::~HeapProfilerImpl()
+    {
+        disable();
+        m_debugger->CancelBreakTasks(this);
+    }
+
+    Response HeapProfilerImpl::enable()
+    {
+        m_isEnabled = true;
+        return Response::OK();
+    }
+
+    Response HeapProfilerImpl::disable()
+    {
+        if (m_allocationProfile.IsStarted())
+        {
+            m_memoryMonitor->StopAllocationSampling();
+            m_allocationProfile.Stop();
+        }
+
+        m_isEnabled = false;
+        return Response::OK();
+    }
+
+    void HeapProfilerImpl::takeHeapSnapshot(Maybe<bool> in_reportProgress, std::unique_ptr<TakeHeapSnapshotCallback> callback)
+    {
+        // Handled outside any debug event, the command came from the host's
+        // own loop with no script on the stack, so no break would arrive to
+        // answer it.
+        if (!m_debugger->IsPaused() && !m_debugger->IsHandlingDebugEvent())
+        {
+            callback->sendFailure(Response::Error(c_ErrorNoScriptRunning));
+            return;
+        }
+
+        m_snapshotRequests.push_back(SnapshotRequest { in_reportProgress.fromMaybe(false), std::move(callback) });
+
+        // The graph can only be walked while the engine is stopped. If it is
+        // running, the response is sent once the requested break arrives.
+        if (m_snapshotRequests.size() == 1)
+        {
+            m_debugger->RunAtBreak(&HeapProfilerImpl::SnapshotBreakTask, this);
+        }
+    }
+
+    Response HeapProfilerImpl::startSampling(Maybe<double> in_samplingInterval)
+    {
+        double samplingInterval = in_samplingInterval.fromMaybe(c_DefaultSamplingInterval);
+        if (samplingInterval < 1)
+        {
+            return Response::Error(c_ErrorInvalidInterval);
+        }
+
+        m_allocationProfile.Start();
+        m_memoryMonitor->StartAllocationSampling(
+            static_cast<size_t>(samplingInterval),
+            &HeapProfilerImpl::AllocationSampleHandler,
+            this);
+
+        return Response::OK();
+    }
+
+    Response HeapProfilerImpl::stopSampling(std::unique_ptr<SamplingHeapProfile>* out_profile)
+    {
+        if (!m_allocationProfile.IsStarted())
+        {
+            return Response::Error(c_ErrorSamplingNotStarted);
+        }
+
+        m_memoryMonitor->StopAllocationSampling();
+
+        // Charge what is still pending now, to the root unless paused.
+        if (m_debugger->IsPaused())
+        {
+            TakeAllocationSample();
+        }
+        else
+        {
+            AllocationSampleBreakTask(this);
+        }
+
+        m_allocationProfile.Stop();
+
+        *out_profile = m_allocationProfile.ToProtocolValue(m_debugger);
+        return Response::OK();
+    }
+
+    Response HeapProfilerImpl::getSamplingProfile(std::unique_ptr<SamplingHeapProfile>* out_profile)
+    {
+        if (!m_allocationProfile.IsStarted())
+        {
+            return Response::Error(c_ErrorSamplingNotStarted);
+        }
+
+        *out_profile = m_allocationProfile.ToProtocolValue(m_debugger);
+        return Response::OK();
+    }
+
+    void HeapProfilerImpl::TakeAllocationSample()
+    {
+        // The stack can only be read at a break. During a debug event that is
+        // the one in progress; otherwise the next one.
+        m_debugger->RunAtBreak(&HeapProfilerImpl::AllocationSampleBreakTask, this);
+    }
+
+    void HeapProfilerImpl::SnapshotBreakTask(void* callbackState)
+    {
+        const auto heapProfilerImpl = static_cast<HeapProfilerImpl*>(callbackState);
+
+        std::vector<SnapshotRequest> requests;
+        requests.swap(heapProfilerImpl->m_snapshotRequests);
+
+        for (SnapshotRequest& request : requests)
+        {
+            try
+            {
+                // Diagnostic handles are the walk's visited set and only last
+                // for this debug event, so every slice runs within it.
+                HeapSnapshot snapshot;
+                snapshot.Start();
+
+                while (!snapshot.Step(c_SnapshotNodesPerSlice))
+                {
+                    if (request.reportProgress)
+                    {
+                        heapProfilerImpl->m_frontend.reportHeapSnapshotProgress(snapshot.ExpandedNodeCount(), snapshot.NodeCount());
+                    }
+                }
+
+                snapshot.Write(c_SnapshotChunkSize, &HeapProfilerImpl::SnapshotChunkHandler, heapProfilerImpl);
+
+                if (request.reportProgress)
+                {
+                    heapProfilerImpl->m_frontend.reportHeapSnapshotProgress(snapshot.NodeCount(), snapshot.NodeCount(), true);
+                }
+
+                request.callback->sendSuccess();
+            }
+            catch (const JsErrorException& e)
+            {
+                request.callback->sendFailure(Response::Error(e.what()));
+            }
+        }
+    }
+
+    void HeapProfilerImpl::SnapshotChunkHandler(const String& chunk, void* callbackState)
+    {
+        const auto heapProfilerImpl = static_cast<HeapProfilerImpl*>(callbackState);
+        heapProfilerImpl->m_frontend.addHeapSnapshotChunk(chunk);
+    }
+
+    bool HeapProfilerImpl::AllocationSampleHandler(void* callbackState)
+    {
+        const auto heapProfilerImpl = static_cast<HeapProfilerImpl*>(callbackState);
+
+        try
+        {
+            heapProfilerImpl->m_handler->SendRequest(c_AllocationSampleRequest);
+            return true;
+        }
+        catch (...)
+        {
+            // Don't let the exception reach the allocator. The bytes stay
+            // pending and are charged with the next sample that gets through.
+            return false;
+        }
+    }
+
+    void HeapProfilerImpl::AllocationSampleBreakTask(void* callbackState)
+    {
+        const auto heapProfilerImpl = static_cast<HeapProfilerImpl*>(callbackState);
+        uint64_t sampledBytes = heapProfilerImpl->m_memoryMonitor->TakeSampledBytes();
+
+        if (sampledBytes != 0)
+        {
+            heapProfilerImpl->m_allocationProfile.AddSample(static_cast<size_t>(sampledBytes));
+        }
+    }
+}
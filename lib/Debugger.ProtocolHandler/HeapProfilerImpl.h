@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+#include <protocol\HeapProfiler.h>
+
+#include "AllocationProfile.h"
+#include "Debugger.h"
+#include "MemoryMonitor.h"
+
+#include <memory>
+#include <vector>
+
+namespace JsDebug
+{
+    class ProtocolHandler;
+
+    class HeapProfilerImpl : public protocol::HeapProfiler::Backend
+    {
+    public:
+        HeapProfilerImpl(ProtocolHandler* handler, protocol::FrontendChannel* frontendChannel, Debugger* debugger, MemoryMonitor* memoryMonitor);
+        ~HeapProfilerImpl() override;
+        HeapProfilerImpl(const HeapProfilerImpl&) = delete;
+        HeapProfilerImpl& operator=(const HeapProfilerImpl&) = delete;
+
+        // protocol::HeapProfiler::Backend implementation
+        protocol::Response enable() override;
+        protocol::Response disable() override;
+        void takeHeapSnapshot(
+            protocol::Maybe<bool> in_reportProgress,
+            std::unique_ptr<TakeHeapSnapshotCallback> callback) override;
+        protocol::Response startSampling(protocol::Maybe<double> in_samplingInterval) override;
+        protocol::Response stopSampling(std::unique_ptr<protocol::HeapProfiler::SamplingHeapProfile>* out_profile) override;
+        protocol::Response getSamplingProfile(std::unique_ptr<protocol::HeapProfiler::SamplingHeapProfile>* out_profile) override;
+
+        // Charge the bytes sampled since the last call to the current stack.
+        // Runs on the engine thread in response to the request made when the
+        // allocation was sampled.
+        void TakeAllocationSample();
+
+    private:
+        struct SnapshotRequest
+        {
+            bool reportProgress;
+            std::unique_ptr<TakeHeapSnapshotCallback> callback;
+        };
+
+        static void SnapshotBreakTask(void* callbackState);
+        static void SnapshotChunkHandler(const protocol::String& chunk, void* callbackState);
+        static bool AllocationSampleHandler(void* callbackState);
+        static void AllocationSampleBreakTask(void* callbackState);
+
+        ProtocolHandler* m_handler;
+        protocol::HeapProfiler::Frontend m_frontend;
+        Debugger* m_debugger;
+        MemoryMonitor* m_memoryMonitor;
+
+        bool m_isEnabled;
+        std::vector<SnapshotRequest> m_snapshotRequests;
+        AllocationProfile m_allocationProfile;
+    };
+}
@@ -0,0 +1,501 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "HeapSnapshot.h"
+
+#include "ErrorHelpers.h"
+#include "PropertyHelpers.h"
+
+#include <protocol\Protocol.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace JsDebug
+{
+    using protocol::String;
+
+    namespace
+    {
+        const char c_StackRootsName[] = "(Stack roots)";
+        const char c_ScopeName[] = "(Scope)";
+        const char c_AnonymousFunctionName[] = "(anonymous function)";
+
+        const char c_SnapshotMeta[] =
+            "{\"snapshot\":{\"meta\":{"
+            "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\"],"
+            "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\",\"bigint\"],"
+            "\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+            "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+            "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],"
+            "\"string_or_number\",\"node\"],"
+            "\"trace_function_info_fields\":[],\"trace_node_fields\":[],\"sample_fields\":[],\"location_fields\":[]},";
+
+        const int c_NodeFieldCount = 6;
+        const uint32_t c_NoNode = UINT32_MAX;
+
+        // The synthetic root comes first and the stack roots second.
+        const uint32_t c_StackRootsNode = 1;
+        const int c_NoHandle = -1;
+
+        // Bound on the work done per engine call.
+        const int c_PropertiesPerPage = 1000;
+
+        // Long string values are cut down, as they are only used as labels.
+        const size_t c_MaxNameLength = 1024;
+
+        // The diagnostics API doesn't expose allocation sizes, so these are
+        // rough estimates to give the retained size view something to sum.
+        const uint32_t c_ObjectSize = 32;
+        const uint32_t c_PropertySize = 8;
+        const uint32_t c_StringSize = 16;
+
+        class ChunkWriter
+        {
+        public:
+            ChunkWriter(size_t chunkSize, HeapSnapshot::ChunkHandler handler, void* callbackState)
+                : m_chunkSize(chunkSize)
+                , m_length(0)
+                , m_handler(handler)
+                , m_callbackState(callbackState)
+            {
+            }
+
+            void Append(const char* text)
+            {
+                size_t length = strlen(text);
+                m_builder.append(text, length);
+                Advance(length);
+            }
+
+            void Append(uint32_t value)
+            {
+                char buffer[16];
+                int length = snprintf(buffer, sizeof(buffer), "%u", value);
+                m_builder.append(buffer, length);
+                Advance(length);
+            }
+
+            void AppendString(const String& value)
+            {
+                m_builder.append('"');
+                protocol::escapeWideStringForJSON(value.characters16(), static_cast<unsigned>(value.length()), &m_builder);
+                m_builder.append('"');
+                Advance(value.length() + 2);
+            }
+
+            void Flush()
+            {
+                if (m_length > 0)
+                {
+                    m_handler(m_builder.toString(), m_callbackState);
+                    m_builder = protocol::StringBuilder();
+                    m_length = 0;
+                }
+            }
+
+        private:
+            void Advance(size_t length)
+            {
+                m_length += length;
+                if (m_length >= m_chunkSize)
+                {
+                    Flush();
+                }
+            }
+
+            size_t m_chunkSize;
+            size_t m_length;
+            protocol::StringBuilder m_builder;
+            HeapSnapshot::ChunkHandler m_handler;
+            void* m_callbackState;
+        };
+
+        String Truncate(const String& value)
+        {
+            return value.length() > c_MaxNameLength ? value.substring(0, c_MaxNameLength) : value;
+        }
+
+        String GetFunctionName(const String& display)
+        {
+            // Functions display as their source text, so keep what comes
+            // before the parameter list and drop the keyword.
+            const String keyword = "function";
+            size_t end = display.find("(");
+            String name = display.substring(0, end == String::kNotFound ? display.length() : end);
+
+            if (name.find(keyword) == 0)
+            {
+                name = name.substring(keyword.length(), name.length() - keyword.length());
+            }
+
+            size_t start = 0;
+            while (start < name.length() && name.characters16()[start] == ' ')
+            {
+                ++start;
+            }
+
+            size_t length = name.length() - start;
+            while (length > 0 && name.characters16()[start + length - 1] == ' ')
+            {
+                --length;
+            }
+
+            return length > 0 ? Truncate(name.substring(start, length)) : String(c_AnonymousFunctionName);
+        }
+
+        bool TryGetElementIndex(const String& name, uint32_t* index)
+        {
+            // Array elements may be reported either as "0" or "[0]".
+            size_t start = 0;
+            size_t end = name.length();
+            if (end >= 2 && name.characters16()[0] == '[' && name.characters16()[end - 1] == ']')
+            {
+                ++start;
+                --end;
+            }
+
+            if (start == end || end - start > 9)
+            {
+                return false;
+            }
+
+            uint32_t value = 0;
+            for (size_t i = start; i < end; ++i)
+            {
+                UChar c = name.characters16()[i];
+                if (c < '0' || c > '9')
+                {
+                    return false;
+                }
+
+                value = value * 10 + (c - '0');
+            }
+
+            *index = value;
+            return true;
+        }
+    }
+
+    HeapSnapshot::HeapSnapshot()
+        : m_nextNode(0)
+    {
+    }
+
+    void HeapSnapshot::Start()
+    {
+        m_nodes.clear();
+        m_edges.clear();
+        m_strings.clear();
+        m_stringIds.clear();
+        m_handleNodes.clear();
+
+        uint32_t root = AddNode(NodeType::Synthetic, "", c_NoHandle, false, 0);
+        uint32_t stackRoots = AddNode(NodeType::Synthetic, c_StackRootsName, c_NoHandle, false, 0);
+        m_edges.push_back(Edge { EdgeType::Element, 1, stackRoots });
+
+        // Every frame sees the same global object, so the top frame's will do.
+        JsValueRef stackProperties = JS_INVALID_REFERENCE;
+        JsValueRef globals = JS_INVALID_REFERENCE;
+        uint32_t global = c_NoNode;
+        if (JsDiagGetStackProperties(0, &stackProperties) == JsNoError &&
+            PropertyHelpers::TryGetProperty(stackProperties, PropertyHelpers::Names::Globals, &globals) &&
+            AddValue(globals, &global))
+        {
+            m_edges.push_back(Edge { EdgeType::Element, 2, global });
+        }
+
+        m_nodes[root].edgeCount = static_cast<uint32_t>(m_edges.size());
+        m_nextNode = stackRoots;
+    }
+
+    bool HeapSnapshot::Step(uint32_t nodeCount)
+    {
+        // Nodes are numbered as they are discovered and expanded in the same
+        // order, so each node's edges land next to each other in the table.
+        for (; nodeCount > 0 && m_nextNode < m_nodes.size(); --nodeCount, ++m_nextNode)
+        {
+            size_t edgeOffset = m_edges.size();
+
+            if (m_nextNode == c_StackRootsNode)
+            {
+                ExpandStackRoots(m_nextNode);
+            }
+            else if (m_nodes[m_nextNode].hasProperties)
+            {
+                ExpandObject(m_nextNode);
+            }
+
+            m_nodes[m_nextNode].edgeCount = static_cast<uint32_t>(m_edges.size() - edgeOffset);
+        }
+
+        return m_nextNode == m_nodes.size();
+    }
+
+    void HeapSnapshot::Write(size_t chunkSize, ChunkHandler chunkHandler, void* callbackState) const
+    {
+        ChunkWriter writer(chunkSize, chunkHandler, callbackState);
+
+        writer.Append(c_SnapshotMeta);
+        writer.Append("\"node_count\":");
+        writer.Append(static_cast<uint32_t>(m_nodes.size()));
+        writer.Append(",\"edge_count\":");
+        writer.Append(static_cast<uint32_t>(m_edges.size()));
+        writer.Append(",\"trace_function_count\":0},\n\"nodes\":[");
+
+        for (size_t index = 0; index < m_nodes.size(); ++index)
+        {
+            const Node& node = m_nodes[index];
+
+            writer.Append(index == 0 ? "" : ",\n");
+            writer.Append(static_cast<uint32_t>(node.type));
+            writer.Append(",");
+            writer.Append(node.name);
+            writer.Append(",");
+            writer.Append(static_cast<uint32_t>(index * 2 + 1));
+            writer.Append(",");
+            writer.Append(node.selfSize);
+            writer.Append(",");
+            writer.Append(node.edgeCount);
+            writer.Append(",0");
+        }
+
+        writer.Append("],\n\"edges\":[");
+
+        for (size_t index = 0; index < m_edges.size(); ++index)
+        {
+            const Edge& edge = m_edges[index];
+
+            writer.Append(index == 0 ? "" : ",\n");
+            writer.Append(static_cast<uint32_t>(edge.type));
+            writer.Append(",");
+            writer.Append(edge.nameOrIndex);
+            writer.Append(",");
+            writer.Append(edge.toNode * c_NodeFieldCount);
+        }
+
+        writer.Append("],\n\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],\"locations\":[],\n\"strings\":[");
+
+        for (size_t index = 0; index < m_strings.size(); ++index)
+        {
+            writer.Append(index == 0 ? "" : ",\n");
+            writer.AppendString(m_strings[index]);
+        }
+
+        writer.Append("]}");
+        writer.Flush();
+    }
+
+    int HeapSnapshot::NodeCount() const
+    {
+        return static_cast<int>(m_nodes.size());
+    }
+
+    int HeapSnapshot::ExpandedNodeCount() const
+    {
+        return static_cast<int>(m_nextNode);
+    }
+
+    uint32_t HeapSnapshot::AddNode(NodeType type, const String& name, int handle, bool hasProperties, uint32_t selfSize)
+    {
+        uint32_t index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node { type, hasProperties, InternString(name), selfSize, 0, handle });
+
+        if (handle != c_NoHandle)
+        {
+            m_handleNodes.emplace(handle, index);
+        }
+
+        return index;
+    }
+
+    bool HeapSnapshot::AddValue(JsValueRef descriptor, uint32_t* node)
+    {
+        int handle = c_NoHandle;
+        PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::Handle, &handle);
+
+        if (handle != c_NoHandle)
+        {
+            auto existing = m_handleNodes.find(handle);
+            if (existing != m_handleNodes.end())
+            {
+                *node = existing->second;
+                return true;
+            }
+        }
+
+        // Scope descriptors carry no type; they hold variables like objects.
+        String type = "object";
+        PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::Type, &type);
+
+        if (type == "string")
+        {
+            String value = PropertyHelpers::GetPropertyStringConvert(descriptor, PropertyHelpers::Names::Value);
+            *node = AddNode(NodeType::String, Truncate(value), handle, false, c_StringSize + static_cast<uint32_t>(value.length()) * 2);
+            return true;
+        }
+
+        if (type == "symbol")
+        {
+            String display;
+            PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::Display, &display);
+            *node = AddNode(NodeType::Symbol, Truncate(display), handle, false, c_ObjectSize);
+            return true;
+        }
+
+        if (type == "function")
+        {
+            String display;
+            PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::Display, &display);
+            *node = AddNode(NodeType::Closure, GetFunctionName(display), handle, handle != c_NoHandle, c_ObjectSize);
+            return true;
+        }
+
+        if (type == "object")
+        {
+            String className = c_ScopeName;
+            PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::ClassName, &className);
+
+            NodeType nodeType = className == PropertyHelpers::Names::RegExp ? NodeType::RegExp : NodeType::Object;
+            *node = AddNode(nodeType, className, handle, handle != c_NoHandle, c_ObjectSize);
+            return true;
+        }
+
+        // Numbers, booleans, null and undefined are stored inline and don't
+        // count as heap objects.
+        return false;
+    }
+
+    void HeapSnapshot::AddEdge(uint32_t fromNode, EdgeType type, const String& name, JsValueRef descriptor)
+    {
+        uint32_t toNode = c_NoNode;
+        if (!AddValue(descriptor, &toNode))
+        {
+            return;
+        }
+
+        uint32_t index = 0;
+        if (type == EdgeType::Property && TryGetElementIndex(name, &index))
+        {
+            m_edges.push_back(Edge { EdgeType::Element, index, toNode });
+        }
+        else
+        {
+            m_edges.push_back(Edge { type, InternString(name), toNode });
+        }
+
+        if (type == EdgeType::Property || type == EdgeType::Internal)
+        {
+            m_nodes[fromNode].selfSize += c_PropertySize;
+        }
+    }
+
+    void HeapSnapshot::AddPropertyEdge(uint32_t fromNode, EdgeType type, JsValueRef descriptor)
+    {
+        String name;
+        PropertyHelpers::TryGetProperty(descriptor, PropertyHelpers::Names::Name, &name);
+        AddEdge(fromNode, type, name, descriptor);
+    }
+
+    void HeapSnapshot::ExpandStackRoots(uint32_t node)
+    {
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        IfJsErrorThrow(JsDiagGetStackTrace(&stackTrace));
+
+        int length = PropertyHelpers::GetPropertyInt(stackTrace, PropertyHelpers::Names::Length);
+
+        for (int index = 0; index < length; ++index)
+        {
+            JsValueRef stackProperties = JS_INVALID_REFERENCE;
+            if (JsDiagGetStackProperties(index, &stackProperties) != JsNoError)
+            {
+                continue;
+            }
+
+            JsValueRef value = JS_INVALID_REFERENCE;
+            if (PropertyHelpers::TryGetProperty(stackProperties, PropertyHelpers::Names::ThisObject, &value))
+            {
+                AddEdge(node, EdgeType::Shortcut, "this", value);
+            }
+
+            if (PropertyHelpers::TryGetProperty(stackProperties, PropertyHelpers::Names::Arguments, &value))
+            {
+                AddEdge(node, EdgeType::Shortcut, PropertyHelpers::Names::Arguments, value);
+            }
+
+            if (PropertyHelpers::TryGetProperty(stackProperties, PropertyHelpers::Names::Locals, &value))
+            {
+                int count = PropertyHelpers::GetPropertyInt(value, PropertyHelpers::Names::Length);
+                for (int i = 0; i < count; ++i)
+                {
+                    AddPropertyEdge(node, EdgeType::Context, PropertyHelpers::GetIndexedProperty(value, i));
+                }
+            }
+
+            if (PropertyHelpers::TryGetProperty(stackProperties, PropertyHelpers::Names::Scopes, &value))
+            {
+                int count = PropertyHelpers::GetPropertyInt(value, PropertyHelpers::Names::Length);
+                for (int i = 0; i < count; ++i)
+                {
+                    AddEdge(node, EdgeType::Context, c_ScopeName, PropertyHelpers::GetIndexedProperty(value, i));
+                }
+            }
+        }
+    }
+
+    void HeapSnapshot::ExpandObject(uint32_t node)
+    {
+        int handle = m_nodes[node].handle;
+
+        for (int from = 0; ; from += c_PropertiesPerPage)
+        {
+            JsValueRef result = JS_INVALID_REFERENCE;
+            if (JsDiagGetProperties(handle, from, c_PropertiesPerPage, &result) != JsNoError)
+            {
+                return;
+            }
+
+            JsValueRef properties = JS_INVALID_REFERENCE;
+            int count = 0;
+            if (PropertyHelpers::TryGetProperty(result, PropertyHelpers::Names::Properties, &properties))
+            {
+                count = PropertyHelpers::GetPropertyInt(properties, PropertyHelpers::Names::Length);
+                for (int i = 0; i < count; ++i)
+                {
+                    AddPropertyEdge(node, EdgeType::Property, PropertyHelpers::GetIndexedProperty(properties, i));
+                }
+            }
+
+            // Internal slots such as [Prototype] only come with the first page.
+            JsValueRef internals = JS_INVALID_REFERENCE;
+            if (from == 0 && PropertyHelpers::TryGetProperty(result, PropertyHelpers::Names::DebuggerOnlyProperties, &internals))
+            {
+                int internalCount = PropertyHelpers::GetPropertyInt(internals, PropertyHelpers::Names::Length);
+                for (int i = 0; i < internalCount; ++i)
+                {
+                    AddPropertyEdge(node, EdgeType::Internal, PropertyHelpers::GetIndexedProperty(internals, i));
+                }
+            }
+
+            if (count < c_PropertiesPerPage)
+            {
+                return;
+            }
+        }
+    }
+
+    uint32_t HeapSnapshot::InternString(const String& value)
+    {
+        auto existing = m_stringIds.find(value);
+        if (existing != m_stringIds.end())
+        {
+            return existing->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(value);
+        m_stringIds.emplace(value, id);
+        return id;
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+
+#include <ChakraCore.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace JsDebug
+{
+    /// <summary>
+    /// Object graph reachable from the global object and the stack, recorded in
+    /// compact native tables and written out in the .heapsnapshot format. The
+    /// output is produced in bounded chunks so it never exists as one string.
+    /// </summary>
+    class HeapSnapshot
+    {
+    public:
+        typedef void (*ChunkHandler)(const protocol::String& chunk, void* callbackState);
+
+        HeapSnapshot();
+        HeapSnapshot(const HeapSnapshot&) = delete;
+        HeapSnapshot& operator=(const HeapSnapshot&) = delete;
+
+        // Must be called while the engine is stopped at a statement, and all
+        // within the same debug event. Start records the roots, and each step
+        // expands up to the given number of nodes, breadth first, returning
+        // true once the walk is complete.
+        void Start();
+        bool Step(uint32_t nodeCount);
+
+        void Write(size_t chunkSize, ChunkHandler chunkHandler, void* callbackState) const;
+
+        int NodeCount() const;
+        int ExpandedNodeCount() const;
+
+    private:
+        enum class NodeType : uint8_t
+        {
+            Hidden = 0,
+            Object = 3,
+            Closure = 5,
+            RegExp = 6,
+            String = 2,
+            Synthetic = 9,
+            Symbol = 12,
+        };
+
+        enum class EdgeType : uint8_t
+        {
+            Context = 0,
+            Element = 1,
+            Property = 2,
+            Internal = 3,
+            Shortcut = 5,
+        };
+
+        struct Node
+        {
+            NodeType type;
+            bool hasProperties;
+            uint32_t name;
+            uint32_t selfSize;
+            uint32_t edgeCount;
+            int handle;
+        };
+
+        struct Edge
+        {
+            EdgeType type;
+            uint32_t nameOrIndex;
+            uint32_t toNode;
+        };
+
+        uint32_t AddNode(NodeType type, const protocol::String& name, int handle, bool hasProperties, uint32_t selfSize);
+        bool AddValue(JsValueRef descriptor, uint32_t* node);
+        void AddEdge(uint32_t fromNode, EdgeType type, const protocol::String& name, JsValueRef descriptor);
+        void AddPropertyEdge(uint32_t fromNode, EdgeType type, JsValueRef descriptor);
+
+        void ExpandStackRoots(uint32_t node);
+        void ExpandObject(uint32_t node);
+        uint32_t InternString(const protocol::String& value);
+
+        uint32_t m_nextNode;
+        std::vector<Node> m_nodes;
+        std::vector<Edge> m_edges;
+        std::vector<protocol::String> m_strings;
+        std::unordered_map<protocol::String, uint32_t> m_stringIds;
+
+        // Diagnostic handles are unique per object for the duration of a
+        // break, so they double as the visited set.
+        std::unordered_map<int, uint32_t> m_handleNodes;
+    };
+}
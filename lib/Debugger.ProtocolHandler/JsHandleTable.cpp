@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "JsHandleTable.h"
+
+#include "ErrorHelpers.h"
+
+namespace JsDebug
+{
+    namespace
+    {
+        const char c_ErrorTableFull[] = "Handle table is full";
+
+        const int c_IndexBits = 32;
+        const uint64_t c_IndexMask = (uint64_t(1) << c_IndexBits) - 1;
+
+        // A slot that has been emptied this many times is retired, so no
+        // handle to it can ever match a later value.
+        const uint32_t c_MaxGeneration = UINT32_MAX;
+
+        // Release fails without a current context, in which case the context
+        // of the value is borrowed, once per call.
+        void ReleaseValue(JsValueRef value, JsContextRef* objContext)
+        {
+            if (JsRelease(value, nullptr) == JsErrorNoCurrentContext &&
+                *objContext == JS_INVALID_REFERENCE &&
+                JsGetContextOfObject(value, objContext) == JsNoError &&
+                JsSetCurrentContext(*objContext) == JsNoError)
+            {
+                JsRelease(value, nullptr);
+            }
+        }
+    }
+
+    JsHandleTable::JsHandleTable(std::atomic<uint32_t>* counter)
+        : m_size(0)
+        , m_counter(counter)
+    {
+    }
+
+    JsHandleTable::~JsHandleTable()
+    {
+        Release();
+    }
+
+    JsHandleTable::Handle JsHandleTable::Add(JsValueRef value)
+    {
+        if (value == JS_INVALID_REFERENCE)
+        {
+            return InvalidHandle;
+        }
+
+        // Slots are numbered from one so that no valid handle is zero.
+        if (m_freeSlots.empty() && m_slots.size() >= c_IndexMask)
+        {
+            throw std::runtime_error(c_ErrorTableFull);
+        }
+
+        IfJsErrorThrow(JsAddRef(value, nullptr));
+
+        uint32_t index;
+        if (!m_freeSlots.empty())
+        {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slots[index - 1].value = value;
+        }
+        else
+        {
+            m_slots.push_back(Slot { value, 0 });
+            index = static_cast<uint32_t>(m_slots.size());
+        }
+
+        ++m_size;
+
+        if (m_counter != nullptr)
+        {
+            m_counter->fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return (static_cast<uint64_t>(m_slots[index - 1].generation) << c_IndexBits) | index;
+    }
+
+    JsValueRef JsHandleTable::Get(Handle handle) const
+    {
+        uint64_t index = handle & c_IndexMask;
+
+        if (index == 0 || index > m_slots.size())
+        {
+            return JS_INVALID_REFERENCE;
+        }
+
+        const Slot& slot = m_slots[static_cast<size_t>(index - 1)];
+        if ((handle >> c_IndexBits) != slot.generation)
+        {
+            return JS_INVALID_REFERENCE;
+        }
+
+        return slot.value;
+    }
+
+    void JsHandleTable::Remove(Handle handle)
+    {
+        JsValueRef value = Get(handle);
+        if (value == JS_INVALID_REFERENCE)
+        {
+            return;
+        }
+
+        JsContextRef objContext = JS_INVALID_REFERENCE;
+        ReleaseValue(value, &objContext);
+
+        if (objContext != JS_INVALID_REFERENCE)
+        {
+            JsSetCurrentContext(JS_INVALID_REFERENCE);
+        }
+
+        FreeSlot(static_cast<uint32_t>(handle & c_IndexMask));
+
+        if (m_counter != nullptr)
+        {
+            m_counter->fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t JsHandleTable::Size() const
+    {
+        return m_size;
+    }
+
+    void JsHandleTable::Release()
+    {
+        // If the host has already cleared the context, release will fail. As with
+        // JsPersistent, borrow the context of the object, but only once for the
+        // whole table.
+        JsContextRef objContext = JS_INVALID_REFERENCE;
+        size_t released = m_size;
+
+        for (uint32_t index = 1; index <= m_slots.size(); ++index)
+        {
+            if (m_slots[index - 1].value != JS_INVALID_REFERENCE)
+            {
+                ReleaseValue(m_slots[index - 1].value, &objContext);
+                FreeSlot(index);
+            }
+        }
+
+        if (objContext != JS_INVALID_REFERENCE)
+        {
+            JsSetCurrentContext(JS_INVALID_REFERENCE);
+        }
+
+        if (m_counter != nullptr)
+        {
+            m_counter->fetch_sub(static_cast<uint32_t>(released), std::memory_order_relaxed);
+        }
+    }
+
+    void JsHandleTable::FreeSlot(uint32_t index)
+    {
+        Slot& slot = m_slots[index - 1];
+        slot.value = JS_INVALID_REFERENCE;
+        --m_size;
+
+        // A retired slot keeps its last generation, which no handle given
+        // out for it can hold any more.
+        if (slot.generation < c_MaxGeneration)
+        {
+            ++slot.generation;
+
+            if (slot.generation < c_MaxGeneration)
+            {
+                m_freeSlots.push_back(index);
+            }
+        }
+    }
+
+    JsHandle::JsHandle()
+        : m_table(nullptr)
+        , m_handle(JsHandleTable::InvalidHandle)
+    {
+    }
+
+    JsHandle::JsHandle(JsHandleTable* table, JsValueRef value)
+        : m_table(table)
+        , m_handle(table->Add(value))
+    {
+    }
+
+    bool JsHandle::IsEmpty() const
+    {
+        return Get() == JS_INVALID_REFERENCE;
+    }
+
+    JsValueRef JsHandle::Get() const
+    {
+        if (m_table == nullptr)
+        {
+            return JS_INVALID_REFERENCE;
+        }
+
+        return m_table->Get(m_handle);
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <ChakraCore.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace JsDebug
+{
+    // Owns one engine reference per value added, dropped one at a time by
+    // Remove or all together by Release. Handles are 64-bit: the low half is
+    // the slot and the high half the slot's generation, which moves on each
+    // time the slot is emptied. A handle kept past its value reads as empty
+    // instead of reaching a value the engine may have collected, and a slot
+    // whose generation runs out is never used again. The table's size is also
+    // added to an optional counter that other threads may read.
+    class JsHandleTable
+    {
+    public:
+        typedef uint64_t Handle;
+        static const Handle InvalidHandle = 0;
+
+        explicit JsHandleTable(std::atomic<uint32_t>* counter = nullptr);
+        ~JsHandleTable();
+        JsHandleTable(const JsHandleTable&) = delete;
+        JsHandleTable& operator=(const JsHandleTable&) = delete;
+
+        Handle Add(JsValueRef value);
+        JsValueRef Get(Handle handle) const;
+        void Remove(Handle handle);
+        size_t Size() const;
+        void Release();
+
+    private:
+        struct Slot
+        {
+            JsValueRef value;
+            uint32_t generation;
+        };
+
+        void FreeSlot(uint32_t index);
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        size_t m_size;
+        std::atomic<uint32_t>* m_counter;
+    };
+
+    // A value held by a handle table. Copies share the table's reference, so
+    // they are as cheap as copying the handle.
+    class JsHandle
+    {
+    public:
+        JsHandle();
+        JsHandle(JsHandleTable* table, JsValueRef value);
+
+        bool IsEmpty() const;
+        JsValueRef Get() const;
+
+    private:
+        const JsHandleTable* m_table;
+        JsHandleTable::Handle m_handle;
+    };
+}
@@ -0,0 +1,468 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "MemoryMonitor.h"
+
+#include "ErrorHelpers.h"
+
+#include <algorithm>
+
+namespace JsDebug
+{
+    namespace
+    {
+        std::atomic<uint32_t> s_nextMonitorId(1);
+
+        // The counters of the monitor this thread last allocated for. Monitors
+        // are matched by id rather than address, which may be reused.
+        struct ThreadCountersCache
+        {
+            uint32_t monitorId;
+            void* counters;
+        };
+
+        thread_local ThreadCountersCache t_countersCache = { 0, nullptr };
+
+        // Collections waiting for the engine thread, and those kept after it.
+        const size_t c_PendingCollections = 64;
+        const size_t c_CollectionHistory = 256;
+
+        int64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    MemoryMonitor::MemoryMonitor(JsRuntimeHandle runtime, size_t capacity)
+        : m_runtime(runtime)
+        , m_id(s_nextMonitorId++)
+        , m_isStarted(false)
+        , m_samples(capacity)
+        , m_sampleStart(0)
+        , m_sampleCount(0)
+        , m_sampleEventCallback(nullptr)
+        , m_sampleEventCallbackState(nullptr)
+        , m_isSampling(false)
+        , m_collectionTrackers(0)
+        , m_collectionStart(0)
+        , m_collectionActivity(0)
+        , m_collectionUsageBefore(0)
+        , m_pendingCollections(c_PendingCollections)
+        , m_allocationSampleInterval(0)
+        , m_bytesUntilSample(0)
+        , m_sampledBytes(0)
+        , m_isAllocationSamplePending(false)
+        , m_allocationSampleCallback(nullptr)
+        , m_allocationSampleCallbackState(nullptr)
+        , m_hostAllocationCallback(nullptr)
+        , m_hostBeforeCollectCallback(nullptr)
+        , m_hostCallbackState(nullptr)
+    {
+    }
+
+    MemoryMonitor::~MemoryMonitor()
+    {
+        try
+        {
+            StopSampling();
+            m_isStarted = false;
+            m_collectionTrackers = 0;
+            m_allocationSampleInterval = 0;
+            UpdateCallbacks();
+        }
+        catch (...)
+        {
+            // Don't allow the exception to propagate.
+        }
+    }
+
+    void MemoryMonitor::Start()
+    {
+        if (m_isStarted)
+        {
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_countersLock);
+
+            for (Counters& counters : m_counters)
+            {
+                counters.allocatedBytes = 0;
+                counters.freedBytes = 0;
+                counters.allocationCount = 0;
+                counters.failureCount = 0;
+            }
+        }
+
+        m_isStarted = true;
+        UpdateCallbacks();
+    }
+
+    void MemoryMonitor::Stop()
+    {
+        if (!m_isStarted)
+        {
+            return;
+        }
+
+        m_isStarted = false;
+        UpdateCallbacks();
+    }
+
+    bool MemoryMonitor::IsStarted() const
+    {
+        return m_isStarted;
+    }
+
+    void MemoryMonitor::StartSampling(std::chrono::milliseconds interval, SampleEventHandler callback, void* callbackState)
+    {
+        StopSampling();
+
+        {
+            std::unique_lock<std::mutex> lock(m_samplesLock);
+            m_sampleStart = 0;
+            m_sampleCount = 0;
+        }
+
+        m_sampleEventCallback = callback;
+        m_sampleEventCallbackState = callbackState;
+        m_isSampling = true;
+        m_samplerThread = std::thread(&MemoryMonitor::SamplerThreadProc, this, interval);
+    }
+
+    void MemoryMonitor::StopSampling()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_samplerLock);
+
+            if (!m_isSampling)
+            {
+                return;
+            }
+
+            m_isSampling = false;
+        }
+
+        m_samplerWake.notify_all();
+        m_samplerThread.join();
+
+        m_sampleEventCallback = nullptr;
+        m_sampleEventCallbackState = nullptr;
+    }
+
+    MemoryMonitor::Sample MemoryMonitor::GetSample() const
+    {
+        Sample sample = { Now(), 0, 0, 0, 0, 0 };
+
+        // The runtime's usage can be read even while it runs on another thread.
+        JsGetRuntimeMemoryUsage(m_runtime, &sample.memoryUsage);
+
+        std::unique_lock<std::mutex> lock(m_countersLock);
+
+        for (const Counters& counters : m_counters)
+        {
+            sample.allocatedBytes += counters.allocatedBytes.load(std::memory_order_relaxed);
+            sample.freedBytes += counters.freedBytes.load(std::memory_order_relaxed);
+            sample.allocationCount += counters.allocationCount.load(std::memory_order_relaxed);
+            sample.failureCount += counters.failureCount.load(std::memory_order_relaxed);
+        }
+
+        return sample;
+    }
+
+    std::vector<MemoryMonitor::Sample> MemoryMonitor::TakeSamples()
+    {
+        std::unique_lock<std::mutex> lock(m_samplesLock);
+
+        std::vector<Sample> samples;
+        samples.reserve(m_sampleCount);
+
+        for (size_t i = 0; i < m_sampleCount; ++i)
+        {
+            samples.push_back(m_samples[(m_sampleStart + i) % m_samples.size()]);
+        }
+
+        m_sampleStart = 0;
+        m_sampleCount = 0;
+        return samples;
+    }
+
+    void MemoryMonitor::SetHostCallbacks(JsMemoryAllocationCallback allocationCallback, JsBeforeCollectCallback beforeCollectCallback, void* callbackState)
+    {
+        m_hostAllocationCallback = allocationCallback;
+        m_hostBeforeCollectCallback = beforeCollectCallback;
+        m_hostCallbackState = callbackState;
+        UpdateCallbacks();
+    }
+
+    void MemoryMonitor::StartCollectionTracking()
+    {
+        if (m_collectionTrackers++ == 0)
+        {
+            UpdateCallbacks();
+        }
+    }
+
+    void MemoryMonitor::StopCollectionTracking()
+    {
+        if (m_collectionTrackers > 0 && --m_collectionTrackers == 0)
+        {
+            UpdateCallbacks();
+            EndCollection();
+        }
+    }
+
+    std::vector<MemoryMonitor::Collection> MemoryMonitor::GetCollections(int64_t since)
+    {
+        Collection collection;
+        while (m_pendingCollections.TryPop(&collection))
+        {
+            if (m_collections.size() == c_CollectionHistory)
+            {
+                m_collections.pop_front();
+            }
+
+            m_collections.push_back(collection);
+        }
+
+        std::vector<Collection> collections;
+        for (const Collection& existing : m_collections)
+        {
+            if (existing.startTime >= since)
+            {
+                collections.push_back(existing);
+            }
+        }
+
+        return collections;
+    }
+
+    void MemoryMonitor::StartAllocationSampling(size_t interval, AllocationSampleHandler callback, void* callbackState)
+    {
+        StopAllocationSampling();
+
+        m_bytesUntilSample = static_cast<int64_t>(interval);
+        m_sampledBytes = 0;
+        m_isAllocationSamplePending = false;
+        m_allocationSampleCallback = callback;
+        m_allocationSampleCallbackState = callbackState;
+
+        // Publishing the interval is what turns sampling on.
+        m_allocationSampleInterval.store(interval, std::memory_order_release);
+        UpdateCallbacks();
+    }
+
+    void MemoryMonitor::StopAllocationSampling()
+    {
+        if (m_allocationSampleInterval.exchange(0) != 0)
+        {
+            UpdateCallbacks();
+        }
+    }
+
+    uint64_t MemoryMonitor::TakeSampledBytes()
+    {
+        m_isAllocationSamplePending = false;
+        return m_sampledBytes.exchange(0);
+    }
+
+    bool CHAKRA_CALLBACK MemoryMonitor::AllocationCallback(void* callbackState, JsMemoryEventType allocationEvent, size_t allocationSize)
+    {
+        const auto memoryMonitor = static_cast<MemoryMonitor*>(callbackState);
+
+        // The host may veto an allocation, which then never happened.
+        JsMemoryAllocationCallback hostCallback = memoryMonitor->m_hostAllocationCallback;
+        if (hostCallback != nullptr && !hostCallback(memoryMonitor->m_hostCallbackState, allocationEvent, allocationSize))
+        {
+            return false;
+        }
+
+        Counters& counters = memoryMonitor->GetThreadCounters();
+        bool isCollecting = memoryMonitor->m_collectionStart.load(std::memory_order_acquire) != 0;
+
+        switch (allocationEvent)
+        {
+        case JsMemoryAllocate:
+            counters.allocatedBytes.fetch_add(allocationSize, std::memory_order_relaxed);
+            counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+            if (isCollecting)
+            {
+                memoryMonitor->EndCollection();
+            }
+
+            {
+                size_t interval = memoryMonitor->m_allocationSampleInterval.load(std::memory_order_acquire);
+                if (interval != 0)
+                {
+                    memoryMonitor->SampleAllocation(allocationSize, interval);
+                }
+            }
+            break;
+
+        case JsMemoryFree:
+            counters.freedBytes.fetch_add(allocationSize, std::memory_order_relaxed);
+
+            if (isCollecting)
+            {
+                memoryMonitor->m_collectionActivity.store(Now(), std::memory_order_relaxed);
+            }
+            break;
+
+        case JsMemoryFailure:
+            counters.failureCount.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+
+        // The monitor itself never vetoes an allocation.
+        return true;
+    }
+
+    void CHAKRA_CALLBACK MemoryMonitor::BeforeCollectCallback(void* callbackState)
+    {
+        const auto memoryMonitor = static_cast<MemoryMonitor*>(callbackState);
+
+        if (memoryMonitor->m_hostBeforeCollectCallback != nullptr)
+        {
+            memoryMonitor->m_hostBeforeCollectCallback(memoryMonitor->m_hostCallbackState);
+        }
+
+        // A collection that never allocated afterwards ends where this starts.
+        memoryMonitor->EndCollection();
+
+        size_t memoryUsage = 0;
+        JsGetRuntimeMemoryUsage(memoryMonitor->m_runtime, &memoryUsage);
+
+        int64_t startTime = Now();
+        memoryMonitor->m_collectionUsageBefore.store(memoryUsage, std::memory_order_relaxed);
+        memoryMonitor->m_collectionActivity.store(startTime, std::memory_order_relaxed);
+        memoryMonitor->m_collectionStart.store(startTime, std::memory_order_release);
+    }
+
+    MemoryMonitor::Counters& MemoryMonitor::GetThreadCounters()
+    {
+        if (t_countersCache.monitorId == m_id)
+        {
+            return *static_cast<Counters*>(t_countersCache.counters);
+        }
+
+        std::unique_lock<std::mutex> lock(m_countersLock);
+        std::thread::id threadId = std::this_thread::get_id();
+        Counters* counters = nullptr;
+
+        for (Counters& existing : m_counters)
+        {
+            if (existing.threadId == threadId)
+            {
+                counters = &existing;
+                break;
+            }
+        }
+
+        if (counters == nullptr)
+        {
+            m_counters.emplace_back();
+            counters = &m_counters.back();
+            counters->threadId = threadId;
+            counters->allocatedBytes = 0;
+            counters->freedBytes = 0;
+            counters->allocationCount = 0;
+            counters->failureCount = 0;
+        }
+
+        t_countersCache = { m_id, counters };
+        return *counters;
+    }
+
+    void MemoryMonitor::UpdateCallbacks()
+    {
+        // Collections are ended from the allocation callback, so it is needed
+        // for every purpose. When the monitor doesn't need a slot, the host's
+        // callback goes back in it, or nothing if it has none.
+        bool isTracking = m_collectionTrackers > 0;
+        bool isNeeded = m_isStarted || isTracking || m_allocationSampleInterval != 0;
+
+        IfJsErrorThrow(JsSetRuntimeMemoryAllocationCallback(
+            m_runtime,
+            isNeeded ? this : m_hostCallbackState,
+            isNeeded ? &MemoryMonitor::AllocationCallback : m_hostAllocationCallback));
+        IfJsErrorThrow(JsSetRuntimeBeforeCollectCallback(
+            m_runtime,
+            isTracking ? this : m_hostCallbackState,
+            isTracking ? &MemoryMonitor::BeforeCollectCallback : m_hostBeforeCollectCallback));
+    }
+
+    void MemoryMonitor::EndCollection()
+    {
+        // Whichever thread clears the start time owns the collection.
+        int64_t startTime = m_collectionStart.load(std::memory_order_acquire);
+        if (startTime == 0 || !m_collectionStart.compare_exchange_strong(startTime, 0, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        Collection collection = {
+            startTime,
+            std::max(startTime, m_collectionActivity.load(std::memory_order_relaxed)),
+            m_collectionUsageBefore.load(std::memory_order_relaxed),
+            0
+        };
+
+        JsGetRuntimeMemoryUsage(m_runtime, &collection.memoryUsageAfter);
+
+        // Dropped if the engine thread has fallen this far behind.
+        m_pendingCollections.TryPush(collection);
+    }
+
+    void MemoryMonitor::SampleAllocation(size_t allocationSize, size_t interval)
+    {
+        int64_t remaining = m_bytesUntilSample.fetch_sub(static_cast<int64_t>(allocationSize)) - static_cast<int64_t>(allocationSize);
+        if (remaining > 0)
+        {
+            return;
+        }
+
+        // A large allocation can cross several sample points at once.
+        uint64_t samples = 1 + static_cast<uint64_t>(-remaining) / interval;
+        m_bytesUntilSample.fetch_add(static_cast<int64_t>(samples * interval));
+        m_sampledBytes.fetch_add(samples * interval);
+
+        if (!m_isAllocationSamplePending.exchange(true) &&
+            !m_allocationSampleCallback(m_allocationSampleCallbackState))
+        {
+            // Nothing will take these bytes, so let the next sample try again.
+            m_isAllocationSamplePending = false;
+        }
+    }
+
+    void MemoryMonitor::SamplerThreadProc(std::chrono::milliseconds interval)
+    {
+        std::unique_lock<std::mutex> lock(m_samplerLock);
+
+        while (!m_samplerWake.wait_for(lock, interval, [this]() { return !m_isSampling; }))
+        {
+            Sample sample = GetSample();
+
+            {
+                std::unique_lock<std::mutex> samplesLock(m_samplesLock);
+
+                if (m_sampleCount < m_samples.size())
+                {
+                    m_samples[(m_sampleStart + m_sampleCount) % m_samples.size()] = sample;
+                    ++m_sampleCount;
+                }
+                else
+                {
+                    // Full, so the oldest sample makes room.
+                    m_samples[m_sampleStart] = sample;
+                    m_sampleStart = (m_sampleStart + 1) % m_samples.size();
+                }
+            }
+
+            m_sampleEventCallback(m_sampleEventCallbackState);
+        }
+    }
+}
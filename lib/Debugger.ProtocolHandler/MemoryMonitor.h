@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <ChakraCore.h>
+
+#include "BoundedQueue.h"
+#include "CollectionTracker.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace JsDebug
+{
+    /// <summary>
+    /// Tracks the memory use of a runtime. Allocation events are counted on the
+    /// allocating thread without taking a lock, and a background thread can
+    /// record periodic samples into a fixed-size ring for the engine thread to
+    /// collect later. Garbage collections can be timed the same way.
+    /// </summary>
+    /// <remarks>
+    /// The runtime has a single slot for its allocation callback and another for
+    /// its before-collect callback, and no way to read either back. A host that
+    /// uses them registers them here instead. While the monitor needs a slot it
+    /// installs its own callback and calls the host's from it; otherwise the
+    /// host's is installed directly, so stopping puts it back.
+    /// </remarks>
+    class MemoryMonitor : public CollectionTracker
+    {
+    public:
+        struct Sample
+        {
+            // Microseconds on the steady clock.
+            int64_t timestamp;
+            size_t memoryUsage;
+            uint64_t allocatedBytes;
+            uint64_t freedBytes;
+            uint64_t allocationCount;
+            uint64_t failureCount;
+        };
+
+        typedef GarbageCollection Collection;
+
+        typedef void (*SampleEventHandler)(void* callbackState);
+
+        // Returns false if the sample could not be delivered.
+        typedef bool (*AllocationSampleHandler)(void* callbackState);
+
+        MemoryMonitor(JsRuntimeHandle runtime, size_t capacity);
+        ~MemoryMonitor();
+        MemoryMonitor(const MemoryMonitor&) = delete;
+        MemoryMonitor& operator=(const MemoryMonitor&) = delete;
+
+        // Count allocation events from now on. Counters restart from zero.
+        void Start();
+        void Stop();
+        bool IsStarted() const;
+
+        // Record a sample every interval from a background thread. The
+        // callback runs on that thread after each sample is stored.
+        void StartSampling(std::chrono::milliseconds interval, SampleEventHandler callback, void* callbackState);
+        void StopSampling();
+
+        // May be called from any thread.
+        Sample GetSample() const;
+
+        // Remove and return the samples recorded since the last call, oldest
+        // first. Samples that were overwritten in the ring are lost.
+        std::vector<Sample> TakeSamples();
+
+        // Must be called on the engine thread. Either callback may be null.
+        void SetHostCallbacks(JsMemoryAllocationCallback allocationCallback, JsBeforeCollectCallback beforeCollectCallback, void* callbackState);
+
+        // CollectionTracker implementation
+        void StartCollectionTracking() override;
+        void StopCollectionTracking() override;
+        std::vector<Collection> GetCollections(int64_t since) override;
+
+        // Mark a sample every interval bytes allocated. The callback runs on
+        // the allocating thread, inside the allocation, when the first sample
+        // since the last call to TakeSampledBytes is marked. It must not call
+        // into the runtime. If it fails, the next sample marked calls it again.
+        void StartAllocationSampling(size_t interval, AllocationSampleHandler callback, void* callbackState);
+        void StopAllocationSampling();
+
+        // Bytes represented by the samples marked since the last call.
+        uint64_t TakeSampledBytes();
+
+    private:
+        struct Counters
+        {
+            std::thread::id threadId;
+            std::atomic<uint64_t> allocatedBytes;
+            std::atomic<uint64_t> freedBytes;
+            std::atomic<uint64_t> allocationCount;
+            std::atomic<uint64_t> failureCount;
+        };
+
+        static bool CHAKRA_CALLBACK AllocationCallback(void* callbackState, JsMemoryEventType allocationEvent, size_t allocationSize);
+        static void CHAKRA_CALLBACK BeforeCollectCallback(void* callbackState);
+
+        Counters& GetThreadCounters();
+        void UpdateCallbacks();
+        void EndCollection();
+        void SampleAllocation(size_t allocationSize, size_t interval);
+        void SamplerThreadProc(std::chrono::milliseconds interval);
+
+        JsRuntimeHandle m_runtime;
+        const uint32_t m_id;
+        std::atomic<bool> m_isStarted;
+
+        // One set of counters per thread that has allocated. The deque keeps
+        // their addresses stable, as each thread caches a pointer to its own.
+        mutable std::mutex m_countersLock;
+        std::deque<Counters> m_counters;
+
+        std::mutex m_samplesLock;
+        std::vector<Sample> m_samples;
+        size_t m_sampleStart;
+        size_t m_sampleCount;
+
+        SampleEventHandler m_sampleEventCallback;
+        void* m_sampleEventCallbackState;
+
+        std::thread m_samplerThread;
+        std::mutex m_samplerLock;
+        std::condition_variable m_samplerWake;
+        bool m_isSampling;
+
+        // The runtime has no callback for the end of a collection, so one is
+        // taken to have ended at the last page it released before it next
+        // allocates. A start time of zero means no collection is open.
+        int m_collectionTrackers;
+        std::atomic<int64_t> m_collectionStart;
+        std::atomic<int64_t> m_collectionActivity;
+        std::atomic<size_t> m_collectionUsageBefore;
+
+        // Filled from whichever thread ends a collection, and drained into
+        // the history on the engine thread.
+        BoundedQueue<Collection> m_pendingCollections;
+        std::deque<Collection> m_collections;
+
+        // Zero while allocations aren't sampled, which is all the allocation
+        // callback checks in that case.
+        std::atomic<size_t> m_allocationSampleInterval;
+        std::atomic<int64_t> m_bytesUntilSample;
+        std::atomic<uint64_t> m_sampledBytes;
+        std::atomic<bool> m_isAllocationSamplePending;
+        AllocationSampleHandler m_allocationSampleCallback;
+        void* m_allocationSampleCallbackState;
+
+        JsMemoryAllocationCallback m_hostAllocationCallback;
+        JsBeforeCollectCallback m_hostBeforeCollectCallback;
+        void* m_hostCallbackState;
+    };
+}
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "PerformanceImpl.h"
+
+#include "ProtocolHandler.h"
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::FrontendChannel;
+    using protocol::Maybe;
+    using protocol::Performance::Metric;
+    using protocol::Response;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_ErrorInvalidInterval[] = "Sampling interval must be positive";
+        const char c_ErrorNotEnabled[] = "Performance is not enabled";
+
+        const char c_MetricsTitle[] = "Sample";
+        const char c_FlushRequest[] = "Performance.metrics";
+
+        // Adds every metric, or with a previous sample only the ones that changed.
+        std::unique_ptr<Array<Metric>> GetMetrics(const MemoryMonitor::Sample& sample, const MemoryMonitor::Sample* lastSample)
+        {
+            auto metrics = Array<Metric>::create();
+            auto addMetric = [&metrics](const char* name, double value, bool isChanged)
+            {
+                if (isChanged)
+                {
+                    metrics->addItem(Metric::create()
+                        .setName(name)
+                        .setValue(value)
+                        .build());
+                }
+            };
+
+            addMetric("Timestamp", sample.timestamp / 1000000.0, true);
+            addMetric("JSHeapTotalSize", static_cast<double>(sample.memoryUsage),
+                lastSample == nullptr || lastSample->memoryUsage != sample.memoryUsage);
+            addMetric("AllocatedBytes", static_cast<double>(sample.allocatedBytes),
+                lastSample == nullptr || lastSample->allocatedBytes != sample.allocatedBytes);
+            addMetric("FreedBytes", static_cast<double>(sample.freedBytes),
+                lastSample == nullptr || lastSample->freedBytes != sample.freedBytes);
+            addMetric("AllocationCount", static_cast<double>(sample.allocationCount),
+                lastSample == nullptr || lastSample->allocationCount != sample.allocationCount);
+            addMetric("AllocationFailureCount", static_cast<double>(sample.failureCount),
+                lastSample == nullptr || lastSample->failureCount != sample.failureCount);
+
+            return metrics;
+        }
+    }
+
+    PerformanceImpl::PerformanceImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel, MemoryMonitor* memoryMonitor)
+        : m_handler(handler)
+        , m_frontend(frontendChannel)
+        , m_memoryMonitor(memoryMonitor)
+        , m_isEnabled(false)
+        , m_isFlushPending(false)
+        , m_hasLastSample(false)
+        , m_lastSample()
+        , m_collectionsSince(0)
+    {
+    }
+
+    PerformanceImpl::~PerformanceImpl()
+    {
+        disable();
+    }
+
+    Response PerformanceImpl::enable(Maybe<int> in_samplingInterval)
+    {
+        if (in_samplingInterval.isJust() && in_samplingInterval.fromJust() <= 0)
+        {
+            return Response::Error(c_ErrorInvalidInterval);
+        }
+
+        m_memoryMonitor->StopSampling();
+        m_memoryMonitor->Start();
+        m_hasLastSample = false;
+
+        if (!m_isEnabled)
+        {
+            m_memoryMonitor->StartCollectionTracking();
+        }
+
+        m_collectionsSince = m_memoryMonitor->GetSample().timestamp;
+
+        if (in_samplingInterval.isJust())
+        {
+            m_memoryMonitor->StartSampling(
+                std::chrono::milliseconds(in_samplingInterval.fromJust()),
+                &PerformanceImpl::SampleEventHandler,
+                this);
+        }
+
+        m_isEnabled = true;
+        return Response::OK();
+    }
+
+    Response PerformanceImpl::disable()
+    {
+        m_memoryMonitor->StopSampling();
+        m_memoryMonitor->Stop();
+
+        if (m_isEnabled)
+        {
+            m_memoryMonitor->StopCollectionTracking();
+        }
+
+        m_isEnabled = false;
+        return Response::OK();
+    }
+
+    Response PerformanceImpl::getMetrics(std::unique_ptr<Array<Metric>>* out_metrics)
+    {
+        if (!m_isEnabled)
+        {
+            return Response::Error(c_ErrorNotEnabled);
+        }
+
+        *out_metrics = GetMetrics(m_memoryMonitor->GetSample(), nullptr);
+        return Response::OK();
+    }
+
+    void PerformanceImpl::FlushMetrics()
+    {
+        m_isFlushPending = false;
+
+        if (!m_isEnabled)
+        {
+            return;
+        }
+
+        // Only what changed since the last event is sent, so an idle runtime
+        // costs little more than a timestamp per sample.
+        for (const MemoryMonitor::Sample& sample : m_memoryMonitor->TakeSamples())
+        {
+            m_frontend.metrics(GetMetrics(sample, m_hasLastSample ? &m_lastSample : nullptr), c_MetricsTitle);
+            m_lastSample = sample;
+            m_hasLastSample = true;
+        }
+
+        for (const MemoryMonitor::Collection& collection : m_memoryMonitor->GetCollections(m_collectionsSince))
+        {
+            m_frontend.garbageCollection(
+                collection.startTime / 1000000.0,
+                (collection.endTime - collection.startTime) / 1000000.0,
+                static_cast<double>(collection.memoryUsageBefore),
+                static_cast<double>(collection.memoryUsageAfter));
+
+            m_collectionsSince = collection.startTime + 1;
+        }
+    }
+
+    void PerformanceImpl::SampleEventHandler(void* callbackState)
+    {
+        const auto performanceImpl = static_cast<PerformanceImpl*>(callbackState);
+
+        // One queued request collects every sample recorded until it runs.
+        if (!performanceImpl->m_isFlushPending.exchange(true))
+        {
+            performanceImpl->m_handler->SendRequest(c_FlushRequest);
+        }
+    }
+}
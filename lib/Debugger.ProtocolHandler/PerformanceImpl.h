@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+#include <protocol\Performance.h>
+
+#include "MemoryMonitor.h"
+
+#include <atomic>
+
+namespace JsDebug
+{
+    class ProtocolHandler;
+
+    class PerformanceImpl : public protocol::Performance::Backend
+    {
+    public:
+        PerformanceImpl(ProtocolHandler* handler, protocol::FrontendChannel* frontendChannel, MemoryMonitor* memoryMonitor);
+        ~PerformanceImpl() override;
+        PerformanceImpl(const PerformanceImpl&) = delete;
+        PerformanceImpl& operator=(const PerformanceImpl&) = delete;
+
+        // protocol::Performance::Backend implementation
+        protocol::Response enable(protocol::Maybe<int> in_samplingInterval) override;
+        protocol::Response disable() override;
+        protocol::Response getMetrics(std::unique_ptr<protocol::Array<protocol::Performance::Metric>>* out_metrics) override;
+
+        // Send the samples and collections recorded since the last call. Runs on the engine
+        // thread in response to the request made by the sampler.
+        void FlushMetrics();
+
+    private:
+        static void SampleEventHandler(void* callbackState);
+
+        ProtocolHandler* m_handler;
+        protocol::Performance::Frontend m_frontend;
+        MemoryMonitor* m_memoryMonitor;
+
+        bool m_isEnabled;
+        std::atomic<bool> m_isFlushPending;
+        bool m_hasLastSample;
+        MemoryMonitor::Sample m_lastSample;
+        int64_t m_collectionsSince;
+    };
+}
@@ -0,0 +1,345 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "ProfilerImpl.h"
+
+#include "ProtocolHandler.h"
+
+#include <algorithm>
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::FrontendChannel;
+    using protocol::Maybe;
+    using protocol::Profiler::CoverageRange;
+    using protocol::Profiler::FunctionCoverage;
+    using protocol::Profiler::HotLine;
+    using protocol::Profiler::Profile;
+    using protocol::Profiler::ScriptCoverage;
+    using protocol::Response;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_ErrorCoverageNotStarted[] = "Precise coverage has not been started";
+        const char c_ErrorInvalidInterval[] = "Sampling interval must be positive";
+        const char c_ErrorInvalidMaxHits[] = "Hit limit must be positive";
+        const char c_ErrorInvalidScriptId[] = "Invalid script ID";
+        const char c_ErrorNotEnabled[] = "Profiler is not enabled";
+        const char c_ErrorNotStarted[] = "No recording profiles found";
+        const char c_ErrorProfileStarted[] = "Cannot change sampling interval when profiling";
+
+        // Default to the same 1 kHz rate as other inspector backends.
+        const int c_DefaultSamplingInterval = 1000;
+
+        // Enough to rank lines, while bounding the cost of the hottest ones.
+        const int c_DefaultMaxLineHits = 1000;
+
+        std::unique_ptr<FunctionCoverage> GetScriptRanges(const DebuggerCoverage::Script& coverage, const String& source)
+        {
+            int sourceLength = static_cast<int>(source.length());
+            std::vector<int> lineOffsets { 0 };
+
+            for (int index = 0; index < sourceLength; ++index)
+            {
+                if (source.characters16()[index] == '\n')
+                {
+                    lineOffsets.push_back(index + 1);
+                }
+            }
+
+            // Statements are only known by their start, so each one is taken to
+            // run up to the start of the next.
+            std::vector<std::pair<int, bool>> statements;
+            bool isCovered = false;
+
+            for (size_t index = 0; index < coverage.positions.size(); ++index)
+            {
+                const DebuggerCoverage::Position& position = coverage.positions[index];
+                int offset = position.line < static_cast<int>(lineOffsets.size())
+                    ? std::min(lineOffsets[position.line] + position.column, sourceLength)
+                    : sourceLength;
+
+                statements.emplace_back(offset, coverage.hits[index]);
+                isCovered = isCovered || coverage.hits[index];
+            }
+
+            std::sort(statements.begin(), statements.end());
+
+            auto ranges = Array<CoverageRange>::create();
+            ranges->addItem(CoverageRange::create()
+                .setStartOffset(0)
+                .setEndOffset(sourceLength)
+                .setCount(isCovered ? 1 : 0)
+                .build());
+
+            for (size_t index = 0; index < statements.size(); ++index)
+            {
+                int endOffset = index + 1 < statements.size() ? statements[index + 1].first : sourceLength;
+
+                ranges->addItem(CoverageRange::create()
+                    .setStartOffset(statements[index].first)
+                    .setEndOffset(endOffset)
+                    .setCount(statements[index].second ? 1 : 0)
+                    .build());
+            }
+
+            return FunctionCoverage::create()
+                .setFunctionName("")
+                .setRanges(std::move(ranges))
+                .setIsBlockCoverage(true)
+                .build();
+        }
+    }
+
+    ProfilerImpl::ProfilerImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel, Debugger* debugger, CollectionTracker* collectionTracker)
+        : m_handler(handler)
+        , m_frontend(frontendChannel)
+        , m_debugger(debugger)
+        , m_collectionTracker(collectionTracker)
+        , m_isEnabled(false)
+        , m_samplingInterval(c_DefaultSamplingInterval)
+    {
+    }
+
+    ProfilerImpl::~ProfilerImpl()
+    {
+        disable();
+    }
+
+    Response ProfilerImpl::enable()
+    {
+        m_isEnabled = true;
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::disable()
+    {
+        m_debugger->StopLineHitCounting();
+        m_debugger->StopCoverage();
+
+        if (m_profile.IsStarted())
+        {
+            m_debugger->StopSampling();
+            m_collectionTracker->StopCollectionTracking();
+            m_profile.Stop();
+        }
+
+        m_isEnabled = false;
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::setSamplingInterval(int in_interval)
+    {
+        if (m_profile.IsStarted())
+        {
+            return Response::Error(c_ErrorProfileStarted);
+        }
+
+        if (in_interval <= 0)
+        {
+            return Response::Error(c_ErrorInvalidInterval);
+        }
+
+        m_samplingInterval = in_interval;
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::start()
+    {
+        if (!m_isEnabled)
+        {
+            return Response::Error(c_ErrorNotEnabled);
+        }
+
+        if (m_profile.IsStarted())
+        {
+            return Response::OK();
+        }
+
+        m_profile.Start();
+        m_collectionTracker->StartCollectionTracking();
+        m_debugger->StartSampling(
+            std::chrono::microseconds(m_samplingInterval),
+            &ProfilerImpl::SampleEventHandler,
+            this);
+
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::stop(std::unique_ptr<Profile>* out_profile)
+    {
+        if (!m_profile.IsStarted())
+        {
+            return Response::Error(c_ErrorNotStarted);
+        }
+
+        m_debugger->StopSampling();
+        m_collectionTracker->StopCollectionTracking();
+        m_profile.Stop();
+
+        *out_profile = m_profile.ToProtocolValue(m_debugger, m_collectionTracker->GetCollections(m_profile.StartTime()));
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::startPreciseCoverage(Maybe<bool> /*in_callCount*/, Maybe<bool> /*in_detailed*/)
+    {
+        if (!m_isEnabled)
+        {
+            return Response::Error(c_ErrorNotEnabled);
+        }
+
+        // Breakpoints are removed on first hit, so counts are always 0 or 1
+        // and always at statement granularity.
+        m_debugger->StartCoverage(m_debugger->GetScripts());
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::stopPreciseCoverage()
+    {
+        m_debugger->StopCoverage();
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::takePreciseCoverage(std::unique_ptr<Array<ScriptCoverage>>* out_result)
+    {
+        if (!m_debugger->IsCoverageStarted())
+        {
+            return Response::Error(c_ErrorCoverageNotStarted);
+        }
+
+        std::vector<DebuggerCoverage::Script> coverage = m_debugger->TakeCoverage();
+        std::vector<DebuggerScript> scripts = m_debugger->GetScripts();
+
+        *out_result = Array<ScriptCoverage>::create();
+
+        for (const DebuggerCoverage::Script& scriptCoverage : coverage)
+        {
+            String scriptId = String::fromInteger(scriptCoverage.scriptId);
+            auto script = std::find_if(scripts.begin(), scripts.end(), [&scriptId](const DebuggerScript& candidate)
+            {
+                return candidate.ScriptId() == scriptId;
+            });
+
+            if (script == scripts.end())
+            {
+                continue;
+            }
+
+            auto functions = Array<FunctionCoverage>::create();
+            functions->addItem(GetScriptRanges(scriptCoverage, script->Source()));
+
+            (*out_result)->addItem(ScriptCoverage::create()
+                .setScriptId(scriptId)
+                .setUrl(script->Url())
+                .setFunctions(std::move(functions))
+                .build());
+        }
+
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::startHotLines(Maybe<String> in_scriptId, Maybe<int> in_maxHits)
+    {
+        if (!m_isEnabled)
+        {
+            return Response::Error(c_ErrorNotEnabled);
+        }
+
+        int maxHits = in_maxHits.fromMaybe(c_DefaultMaxLineHits);
+        if (maxHits <= 0)
+        {
+            return Response::Error(c_ErrorInvalidMaxHits);
+        }
+
+        std::vector<DebuggerScript> scripts = m_debugger->GetScripts();
+
+        if (in_scriptId.isJust())
+        {
+            String scriptId = in_scriptId.fromJust();
+
+            scripts.erase(
+                std::remove_if(scripts.begin(), scripts.end(), [&scriptId](const DebuggerScript& script)
+                {
+                    return script.ScriptId() != scriptId;
+                }),
+                scripts.end());
+
+            if (scripts.empty())
+            {
+                return Response::Error(c_ErrorInvalidScriptId);
+            }
+        }
+
+        m_debugger->StartLineHitCounting(scripts, maxHits);
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::stopHotLines()
+    {
+        m_debugger->StopLineHitCounting();
+        return Response::OK();
+    }
+
+    Response ProfilerImpl::getHotLines(Maybe<int> in_maxResults, std::unique_ptr<Array<HotLine>>* out_lines)
+    {
+        std::vector<DebuggerHitCounter::Location> locations = m_debugger->GetLineHitCounts();
+
+        locations.erase(
+            std::remove_if(locations.begin(), locations.end(), [](const DebuggerHitCounter::Location& location)
+            {
+                return location.hitCount == 0;
+            }),
+            locations.end());
+
+        std::stable_sort(locations.begin(), locations.end(), [](const DebuggerHitCounter::Location& a, const DebuggerHitCounter::Location& b)
+        {
+            return a.hitCount > b.hitCount;
+        });
+
+        size_t maxResults = locations.size();
+        if (in_maxResults.isJust() && in_maxResults.fromJust() >= 0)
+        {
+            maxResults = std::min(maxResults, static_cast<size_t>(in_maxResults.fromJust()));
+        }
+
+        *out_lines = Array<HotLine>::create();
+
+        for (size_t index = 0; index < maxResults; ++index)
+        {
+            const DebuggerHitCounter::Location& location = locations[index];
+
+            (*out_lines)->addItem(HotLine::create()
+                .setScriptId(String::fromInteger(location.scriptId))
+                .setLineNumber(location.line)
+                .setColumnNumber(location.column)
+                .setHitCount(location.hitCount)
+                .build());
+        }
+
+        return Response::OK();
+    }
+
+    void ProfilerImpl::SampleEventHandler(void* callbackState)
+    {
+        const auto profilerImpl = static_cast<ProfilerImpl*>(callbackState);
+
+        try
+        {
+            profilerImpl->m_profile.AddSample();
+        }
+        catch (...)
+        {
+            // A failed sample is dropped rather than disturbing the script.
+        }
+
+        if (profilerImpl->m_profile.IsFull())
+        {
+            // Nothing more will be kept, so stop breaking in for it. The
+            // recording stays open until the client stops it.
+            profilerImpl->m_debugger->StopSampling();
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+#include <protocol\Profiler.h>
+
+#include "CollectionTracker.h"
+#include "CpuProfile.h"
+#include "Debugger.h"
+
+namespace JsDebug
+{
+    class ProtocolHandler;
+
+    class ProfilerImpl : public protocol::Profiler::Backend
+    {
+    public:
+        ProfilerImpl(ProtocolHandler* handler, protocol::FrontendChannel* frontendChannel, Debugger* debugger, CollectionTracker* collectionTracker);
+        ~ProfilerImpl() override;
+        ProfilerImpl(const ProfilerImpl&) = delete;
+        ProfilerImpl& operator=(const ProfilerImpl&) = delete;
+
+        // protocol::Profiler::Backend implementation
+        protocol::Response enable() override;
+        protocol::Response disable() override;
+        protocol::Response setSamplingInterval(int in_interval) override;
+        protocol::Response start() override;
+        protocol::Response stop(std::unique_ptr<protocol::Profiler::Profile>* out_profile) override;
+        protocol::Response startPreciseCoverage(protocol::Maybe<bool> in_callCount, protocol::Maybe<bool> in_detailed) override;
+        protocol::Response stopPreciseCoverage() override;
+        protocol::Response takePreciseCoverage(std::unique_ptr<protocol::Array<protocol::Profiler::ScriptCoverage>>* out_result) override;
+        protocol::Response startHotLines(protocol::Maybe<protocol::String> in_scriptId, protocol::Maybe<int> in_maxHits) override;
+        protocol::Response stopHotLines() override;
+        protocol::Response getHotLines(
+            protocol::Maybe<int> in_maxResults,
+            std::unique_ptr<protocol::Array<protocol::Profiler::HotLine>>* out_lines) override;
+
+    private:
+        static void SampleEventHandler(void* callbackState);
+
+        ProtocolHandler* m_handler;
+        protocol::Profiler::Frontend m_frontend;
+        Debugger* m_debugger;
+        CollectionTracker* m_collectionTracker;
+
+        bool m_isEnabled;
+        int m_samplingInterval;
+        CpuProfile m_profile;
+    };
+}
@@ -4,11 +4,15 @@
 #include "stdafx.h"
 #include "ProtocolHandler.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace JsDebug
 {
     using protocol::Array;
     using protocol::Schema::Domain;
     using protocol::Serializable;
+    using protocol::Session::TargetBusyNotification;
 
     namespace
     {
@@ -18,20 +22,161 @@ namespace JsDebug
         const char c_ErrorHandlerAlreadyConnected[] = "Handler is already connected";
         const char c_ErrorInvalidCallbackState[] = "'callbackState' can only be provided with a valid callback";
         const char c_ErrorNoHandlerConnected[] = "No handler is currently connected";
+        const char c_ErrorObserverNotFound[] = "Observer is not connected";
+        const char c_ErrorObserverReadOnly[] = "Observers can only inspect state";
+        const char c_ErrorStaleRequest[] = "Request refers to a previous pause and was cancelled";
+        const char c_ErrorSessionDetached[] = "Debugging session was closed";
+
+        const char c_DetachedMethod[] = "Inspector.detached";
+        const char c_TargetBusyMethod[] = "Session.targetBusy";
+        const char c_DetachedMemoryBudget[] = "Debugging session exceeded its memory budget";
+
+        const size_t c_ConsoleBufferCapacity = 1024;
+
+        // Console messages are delivered in batches. Without a host to drive
+        // delivery, the handler breaks in once this many are pending or once
+        // the interval has passed since the last delivery.
+        const size_t c_ConsoleFlushCount = 64;
+        const int64_t c_ConsoleFlushIntervalMicroseconds = 100 * 1000;
+
+        // A few minutes of history at one sample per second.
+        const size_t c_MemorySampleCapacity = 256;
+
+        // Enough for the notifications of a few thousand scripts.
+        const size_t c_MaxScriptSnapshotBytes = 1024 * 1024;
+
+        // Pulls the method name out of a notification serialized by this
+        // handler, which always writes it first. Messages from clients are
+        // parsed instead, since they may be laid out any way.
+        std::string GetMethodName(const std::string& message)
+        {
+            size_t start = message.find("\"method\"");
+            if (start == std::string::npos)
+            {
+                return std::string();
+            }
+
+            start = message.find(':', start);
+            if (start == std::string::npos)
+            {
+                return std::string();
+            }
+
+            start = message.find('"', start);
+            if (start == std::string::npos)
+            {
+                return std::string();
+            }
+
+            size_t end = message.find('"', start + 1);
+            if (end == std::string::npos)
+            {
+                return std::string();
+            }
+
+            return message.substr(start + 1, end - start - 1);
+        }
+
+        // Pulls the script id out of a script notification in the same way.
+        std::string GetScriptId(const std::string& message)
+        {
+            const char key[] = "\"scriptId\":\"";
+
+            size_t start = message.find(key);
+            if (start == std::string::npos)
+            {
+                return std::string();
+            }
+
+            start += sizeof(key) - 1;
+
+            size_t end = message.find('"', start);
+            if (end == std::string::npos)
+            {
+                return std::string();
+            }
+
+            return message.substr(start, end - start);
+        }
+
+        bool IsControlMethod(const std::string& method)
+        {
+            return method == "Debugger.pause" ||
+                method == "Debugger.resume" ||
+                method == "Debugger.stepInto" ||
+                method == "Debugger.stepOut" ||
+                method == "Debugger.stepOver";
+        }
+
+        // Methods that leave the runtime as it was, which observers may use.
+        bool IsObserverMethod(const std::string& method)
+        {
+            return method == "Debugger.getPossibleBreakpoints" ||
+                method == "Debugger.getScriptSource" ||
+                method == "Runtime.getProperties" ||
+                method == "Schema.getDomains" ||
+                method == "Session.setEventMask";
+        }
+
+        // Object and call frame ids are handles that are only valid for the
+        // debug event in which they were handed out. Only property names are
+        // looked at, so an id quoted inside a string value doesn't count.
+        bool RefersToPauseState(protocol::Value* value)
+        {
+            if (protocol::DictionaryValue* object = protocol::DictionaryValue::cast(value))
+            {
+                for (size_t index = 0; index < object->size(); ++index)
+                {
+                    protocol::DictionaryValue::Entry entry = object->at(index);
+
+                    if (entry.first == "objectId" || entry.first == "callFrameId" || RefersToPauseState(entry.second))
+                    {
+                        return true;
+                    }
+                }
+            }
+            else if (protocol::ListValue* list = protocol::ListValue::cast(value))
+            {
+                for (size_t index = 0; index < list->size(); ++index)
+                {
+                    if (RefersToPauseState(list->at(index)))
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
     }
 
     ProtocolHandler::ProtocolHandler(JsRuntimeHandle runtime)
-        : m_sendResponseCallback(nullptr)
+        : m_memoryBudget(0)
+        , m_isMemoryBudgetEnforcementPending(false)
+        , m_sendResponseCallback(nullptr)
         , m_sendResponseCallbackState(nullptr)
         , m_commandQueueCallback(nullptr)
         , m_commandQueueCallbackState(nullptr)
+        , m_pauseEpoch(0)
         , m_isConnected(false)
+        , m_isDetached(false)
         , m_waitingForDebugger(false)
         , m_breakOnConnect(false)
         , m_dispatcher(this)
         , m_startupState(StartupState::Running)
         , m_deferredGo(false)
+        , m_nextSessionId(PrimarySessionId + 1)
+        , m_observerEventMask(0)
+        , m_isBusyStatusEnabled(false)
+        , m_scriptSnapshotBytes(0)
+        , m_eventMask(SessionImpl::AllEvents)
+        , m_responseSessionId(PrimarySessionId)
         , m_processingCommandQueue(false)
+        , m_consoleAggregator(&m_statistics.consoleBytes)
+        , m_consoleBuffer(c_ConsoleBufferCapacity, &m_statistics.consoleBytes, &m_statistics.retainedValueCount)
+        , m_isConsoleFlushRequested(false)
+        , m_consoleFlushTime(0)
+        , m_memoryMonitor(runtime, c_MemorySampleCapacity)
     {
         if (runtime == nullptr) {
             throw JsErrorException(JsErrorInvalidArgument, c_ErrorRuntimeRequired);
@@ -93,7 +238,66 @@ namespace JsDebug
         m_debugger->RequestAsyncBreak();
     }
 
+    unsigned int ProtocolHandler::ConnectObserver(ProtocolHandlerSendResponseCallback callback, void* callbackState)
+    {
+        if (callback == nullptr)
+        {
+            throw JsErrorException(JsErrorInvalidArgument, c_ErrorCallbackRequired);
+        }
+
+        std::unique_lock<std::mutex> lock(m_observerLock);
+
+        unsigned int sessionId = m_nextSessionId++;
+        m_observers.push_back(Observer { sessionId, callback, callbackState, SessionImpl::AllEvents });
+        m_observerEventMask = SessionImpl::AllEvents;
+
+        return sessionId;
+    }
+
+    void ProtocolHandler::DisconnectObserver(unsigned int sessionId)
+    {
+        std::unique_lock<std::mutex> lock(m_observerLock);
+
+        auto observer = std::find_if(m_observers.begin(), m_observers.end(),
+            [sessionId](const Observer& observer) { return observer.sessionId == sessionId; });
+
+        if (observer == m_observers.end())
+        {
+            throw JsErrorException(JsErrorInvalidArgument, c_ErrorObserverNotFound);
+        }
+
+        m_observers.erase(observer);
+
+        uint32_t eventMask = 0;
+        for (const Observer& remaining : m_observers)
+        {
+            eventMask |= remaining.eventMask;
+        }
+
+        m_observerEventMask = eventMask;
+    }
+
+    void ProtocolHandler::SendObserverCommand(unsigned int sessionId, const char* command)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_observerLock);
+
+            if (std::none_of(m_observers.begin(), m_observers.end(),
+                [sessionId](const Observer& observer) { return observer.sessionId == sessionId; }))
+            {
+                throw JsErrorException(JsErrorInvalidArgument, c_ErrorObserverNotFound);
+            }
+        }
+
+        EnqueueMessage(command, sessionId);
+    }
+
     void ProtocolHandler::SendCommand(const char* command)
+    {
+        EnqueueMessage(command, PrimarySessionId);
+    }
+
+    void ProtocolHandler::EnqueueMessage(const char* command, unsigned int sessionId)
     {
         if (command == nullptr)
         {
@@ -109,9 +313,33 @@ namespace JsDebug
         ProtocolHandlerCommandQueueCallback callback = nullptr;
         void* state = nullptr;
 
+        size_t size = strlen(command);
+        m_statistics.bytesReceived += size;
+
+        // Parsed here rather than on the script thread, and before taking the
+        // lock. The envelope decides the lane and whether the command can go
+        // stale, and the parsed value is what gets dispatched.
+        Command message { CommandType::MessageReceived };
+        message.parsedMessage = protocol::StringUtil::parseJSON(protocol::String::fromUtf8(command, size));
+        message.size = size;
+        message.sessionId = sessionId;
+
+        if (protocol::DictionaryValue* envelope = protocol::DictionaryValue::cast(message.parsedMessage.get()))
+        {
+            protocol::String method;
+            if (envelope->getString("method", &method))
+            {
+                message.method = method.toUtf8();
+            }
+
+            message.refersToPauseState = RefersToPauseState(envelope->get("params"));
+        }
+
+        message.isControl = IsControlMethod(message.method);
+
         {
             std::unique_lock<std::mutex> lock(m_lock);
-            EnqueueCommand(CommandType::MessageReceived, command);
+            InsertCommand(std::move(message));
 
             callback = m_commandQueueCallback;
             state = m_commandQueueCallbackState;
@@ -146,8 +374,93 @@ namespace JsDebug
 
     void ProtocolHandler::ConsoleAPIEvent(const char* type, const JsValueRef* argv, unsigned short argc)
     {
-        if (m_runtimeAgent != nullptr)
-            m_runtimeAgent->consoleAPIEvent(type, argv, argc);
+        if (!IsEventEnabled(SessionEvent::ConsoleAPICalled))
+        {
+            // Nothing is captured, so nothing is replayed if the mask changes.
+            return;
+        }
+
+        bool wasEmpty = m_consoleBuffer.IsEmpty();
+        bool isEnabled = IsConsoleEnabled();
+
+        std::vector<ConsoleAggregator::Summary> summaries;
+        if (m_consoleAggregator.HandleEvent(type, argv, argc, &summaries))
+        {
+            CaptureConsoleSummaries(summaries);
+        }
+        else
+        {
+            // Keep pending counts ahead of the message that follows them.
+            m_consoleAggregator.Flush(&summaries);
+            CaptureConsoleSummaries(summaries);
+
+            // Objects are only kept alive for a client that can ask about them.
+            m_consoleBuffer.Capture(type, argv, argc, isEnabled);
+        }
+
+        if (isEnabled && !m_consoleBuffer.IsEmpty())
+        {
+            RequestConsoleFlush(wasEmpty);
+        }
+        else if (IsOverMemoryBudget())
+        {
+            RequestMemoryBudgetEnforcement();
+        }
+    }
+
+    void ProtocolHandler::RequestConsoleFlush(bool isFirstPending)
+    {
+        ProtocolHandlerCommandQueueCallback callback = nullptr;
+        void* state = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            callback = m_commandQueueCallback;
+            state = m_commandQueueCallbackState;
+        }
+
+        if (callback != nullptr)
+        {
+            // The host processes the queue from its own loop, which delivers
+            // the messages without breaking into the script.
+            if (isFirstPending)
+            {
+                callback(state);
+            }
+
+            return;
+        }
+
+        // Otherwise break in at most once per batch. A message logged soon
+        // after a delivery waits for the next console call, command or debug
+        // event.
+        if (!m_isConsoleFlushRequested &&
+            (m_consoleBuffer.GetCount() >= c_ConsoleFlushCount ||
+                HandlerStatistics::Now() - m_consoleFlushTime >= c_ConsoleFlushIntervalMicroseconds))
+        {
+            m_isConsoleFlushRequested = true;
+            m_debugger->RequestAsyncBreak();
+        }
+    }
+
+    void ProtocolHandler::DiscardConsoleEntries()
+    {
+        m_consoleBuffer.Clear();
+    }
+
+    void ProtocolHandler::AsyncTaskScheduled(JsValueRef task)
+    {
+        m_debugger->AsyncTaskScheduled(task);
+    }
+
+    void ProtocolHandler::AsyncTaskStarted(JsValueRef task)
+    {
+        m_debugger->AsyncTaskStarted(task);
+    }
+
+    void ProtocolHandler::AsyncTaskFinished(JsValueRef task)
+    {
+        m_debugger->AsyncTaskFinished(task);
     }
 
 
@@ -169,10 +482,19 @@ namespace JsDebug
 
     void ProtocolHandler::Continue() 
     {
+        // Anything still queued against this pause is now stale, even though
+        // the rest of the queue is handled before the engine moves on.
+        ExpirePauseState();
+
         m_waitingForDebugger = false;
         m_startupState = StartupState::Running;
     }
 
+    void ProtocolHandler::ExpirePauseState()
+    {
+        ++m_pauseEpoch;
+    }
+
     std::unique_ptr<Array<Domain>> ProtocolHandler::GetSupportedDomains()
     {
         auto domains = Array<Domain>::create();
@@ -187,17 +509,168 @@ namespace JsDebug
             .setVersion(protocol::Debugger::Metainfo::version)
             .build());
 
+        domains->addItem(Domain::create()
+            .setName(protocol::HeapProfiler::Metainfo::domainName)
+            .setVersion(protocol::HeapProfiler::Metainfo::version)
+            .build());
+
+        domains->addItem(Domain::create()
+            .setName(protocol::Performance::Metainfo::domainName)
+            .setVersion(protocol::Performance::Metainfo::version)
+            .build());
+
+        domains->addItem(Domain::create()
+            .setName(protocol::Profiler::Metainfo::domainName)
+            .setVersion(protocol::Profiler::Metainfo::version)
+            .build());
+
         domains->addItem(Domain::create()
             .setName(protocol::Runtime::Metainfo::domainName)
             .setVersion(protocol::Runtime::Metainfo::version)
             .build());
 
+        domains->addItem(Domain::create()
+            .setName(protocol::Session::Metainfo::domainName)
+            .setVersion(protocol::Session::Metainfo::version)
+            .build());
+
+        domains->addItem(Domain::create()
+            .setName(protocol::TimeTravel::Metainfo::domainName)
+            .setVersion(protocol::TimeTravel::Metainfo::version)
+            .build());
+
         return domains;
     }
 
+    bool ProtocolHandler::IsEventEnabled(SessionEvent event)
+    {
+        // Until a client connects, everything is kept for it.
+        uint32_t eventMask = (m_isConnected ? m_eventMask : SessionImpl::AllEvents) | m_observerEventMask;
+        return (eventMask & static_cast<uint32_t>(event)) != 0;
+    }
+
+    void ProtocolHandler::SetEventMask(uint32_t eventMask)
+    {
+        if (m_responseSessionId == PrimarySessionId)
+        {
+            m_eventMask = eventMask;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_observerLock);
+
+        uint32_t observerEventMask = 0;
+        for (Observer& observer : m_observers)
+        {
+            if (observer.sessionId == m_responseSessionId)
+            {
+                observer.eventMask = eventMask;
+            }
+
+            observerEventMask |= observer.eventMask;
+        }
+
+        m_observerEventMask = observerEventMask;
+    }
+
+    HandlerStatistics& ProtocolHandler::GetStatistics()
+    {
+        return m_statistics;
+    }
+
+    void ProtocolHandler::SetMemoryBudget(uint64_t maxBytes)
+    {
+        m_memoryBudget = maxBytes;
+
+        if (IsOverMemoryBudget())
+        {
+            RequestMemoryBudgetEnforcement();
+        }
+    }
+
+    void ProtocolHandler::SetRuntimeMemoryCallbacks(JsMemoryAllocationCallback allocationCallback, JsBeforeCollectCallback beforeCollectCallback, void* callbackState)
+    {
+        m_memoryMonitor.SetHostCallbacks(allocationCallback, beforeCollectCallback, callbackState);
+    }
+
+    void ProtocolHandler::EnableBusyStatus(bool isEnabled)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_snapshotLock);
+            m_isBusyStatusEnabled = isEnabled;
+        }
+
+        if (!isEnabled)
+        {
+            ClearSnapshot();
+        }
+    }
+
+    void ProtocolHandler::GetBusyStatus(ProtocolHandlerSendResponseCallback callback, void* callbackState)
+    {
+        if (callback == nullptr)
+        {
+            throw JsErrorException(JsErrorInvalidArgument, c_ErrorCallbackRequired);
+        }
+
+        int64_t waitStartTime = m_statistics.queueWaitStartTime;
+        if (waitStartTime == 0)
+        {
+            // The script thread has caught up.
+            return;
+        }
+
+        auto events = Array<protocol::DictionaryValue>::create();
+        auto addEvent = [&events](const std::string& notification)
+        {
+            std::unique_ptr<protocol::DictionaryValue> event = protocol::DictionaryValue::cast(
+                protocol::StringUtil::parseJSON(protocol::String::fromUtf8(notification.c_str(), notification.length())));
+
+            if (event != nullptr)
+            {
+                events->addItem(std::move(event));
+            }
+        };
+
+        {
+            std::unique_lock<std::mutex> lock(m_snapshotLock);
+
+            for (const std::string& scriptId : m_scriptSnapshotOrder)
+            {
+                addEvent(m_scriptSnapshot[scriptId]);
+            }
+
+            if (!m_pauseSnapshot.empty())
+            {
+                addEvent(m_pauseSnapshot);
+            }
+        }
+
+        std::string notification = protocol::InternalResponse::createNotification(
+            c_TargetBusyMethod,
+            TargetBusyNotification::create()
+                .setBusyTime((HandlerStatistics::Now() - waitStartTime) / 1000.0)
+                .setQueuedCommands(static_cast<int>(m_statistics.queuedCommands.load()))
+                .setEvents(std::move(events))
+                .build())->serialize().toUtf8();
+
+        // Handed to the caller rather than sent, so every response a session
+        // gets still comes from the script thread.
+        callback(notification.c_str(), callbackState);
+    }
+
     void ProtocolHandler::sendProtocolResponse(int /*callId*/, std::unique_ptr<Serializable> message)
     {
-        sendProtocolNotification(std::move(message));
+        std::string response = message->serialize().toUtf8();
+
+        if (m_responseSessionId == PrimarySessionId)
+        {
+            SendResponse(response.c_str());
+        }
+        else
+        {
+            SendObserverResponse(m_responseSessionId, response.c_str());
+        }
     }
 
     void ProtocolHandler::sendProtocolNotification(std::unique_ptr<Serializable> message)
@@ -211,8 +684,48 @@ namespace JsDebug
         OutputDebugStringA("},\r\n");
 #endif
 
+        // Serialized once and handed to every session that wants it.
         std::string utf8Str = str.toUtf8();
-        SendResponse(utf8Str.c_str());
+
+        if (m_isBusyStatusEnabled)
+        {
+            RecordSnapshot(utf8Str);
+        }
+
+        // Only sessions with a mask pay to look up which event this is.
+        bool hasEvent = false;
+        uint32_t event = 0;
+        auto isWanted = [&](uint32_t eventMask)
+        {
+            if (eventMask == SessionImpl::AllEvents)
+            {
+                return true;
+            }
+
+            if (!hasEvent)
+            {
+                event = SessionImpl::GetEventMask(GetMethodName(utf8Str));
+                hasEvent = true;
+            }
+
+            return event == 0 || (eventMask & event) != 0;
+        };
+
+        if (isWanted(m_eventMask))
+        {
+            SendResponse(utf8Str.c_str());
+        }
+
+        std::unique_lock<std::mutex> lock(m_observerLock);
+
+        for (const Observer& observer : m_observers)
+        {
+            if (isWanted(observer.eventMask))
+            {
+                observer.callback(utf8Str.c_str(), observer.callbackState);
+                m_statistics.bytesSent += utf8Str.size();
+            }
+        }
     }
 
     void ProtocolHandler::flushProtocolNotifications()
@@ -235,54 +748,107 @@ namespace JsDebug
         // Ensure that there's an active context before trying to process the queue.
         DebuggerContext::Scope debuggerScope(*m_debugger->GetDebugContext());
 
-        std::vector<std::pair<CommandType, std::string>> current;
+        FlushConsole();
 
-        do
+        for (;;)
         {
-            current.clear();
+            Command command;
 
             {
                 std::unique_lock<std::mutex> lock(m_lock);
 
-                if (m_waitingForDebugger && m_commandQueue.empty())
+                if (m_commandQueue.empty())
                 {
+                    if (!m_waitingForDebugger)
+                    {
+                        break;
+                    }
+
                     m_commandWaiting.wait(lock);
+                    continue;
                 }
 
-                std::swap(m_commandQueue, current);
+                // Take one command at a time so that a control command arriving
+                // while a long batch is being handled can still jump ahead of it.
+                command = std::move(m_commandQueue.front());
+                m_commandQueue.pop_front();
+                --m_statistics.queuedCommands;
+                m_statistics.queuedCommandBytes -= command.size;
+                m_statistics.queueWaitStartTime = m_commandQueue.empty() ? 0 : HandlerStatistics::Now();
             }
 
-            for (const auto& command : current)
+            switch (command.type)
             {
-                switch (command.first)
-                {
-                case CommandType::Connect:
-                    HandleConnect();
-                    break;
+            case CommandType::Connect:
+                HandleConnect();
+                break;
 
-                case CommandType::Disconnect:
-                    HandleDisconnect();
-                    break;
+            case CommandType::Disconnect:
+                HandleDisconnect();
+                break;
 
-                case CommandType::MessageReceived:
-                    HandleMessageReceived(command.second);
-                    break;
+            case CommandType::MessageReceived:
+                HandleMessageReceived(command);
+                break;
 
-                case CommandType::HostRequest:
-                    HandleHostRequest(command.second);
-                    break;
+            case CommandType::HostRequest:
+                HandleHostRequest(command.message);
+                break;
 
-                default:
-                    throw std::runtime_error("Unknown command type");
-                }
+            default:
+                throw std::runtime_error("Unknown command type");
             }
 
-        } while (m_waitingForDebugger || !current.empty());
+            EnforceMemoryBudget();
+        }
+
+        // Deliver anything that became visible while handling the commands,
+        // such as history replayed after Runtime.enable.
+        FlushConsole();
+        EnforceMemoryBudget();
     }
 
     void ProtocolHandler::EnqueueCommand(ProtocolHandler::CommandType type, const std::string& message)
     {
-        m_commandQueue.emplace_back(type, message);
+        Command command { type, message };
+        command.size = message.size();
+        command.sessionId = PrimarySessionId;
+
+        InsertCommand(std::move(command));
+    }
+
+    void ProtocolHandler::InsertCommand(Command command)
+    {
+        auto position = m_commandQueue.end();
+
+        if (command.isControl)
+        {
+            // Skip back over ordinary messages, but never past another control
+            // command or a connect/disconnect/host request, so each lane stays
+            // in order and session boundaries are respected.
+            while (position != m_commandQueue.begin())
+            {
+                const Command& previous = *(position - 1);
+
+                if (previous.type != CommandType::MessageReceived || previous.isControl)
+                {
+                    break;
+                }
+
+                --position;
+            }
+        }
+
+        if (m_commandQueue.empty())
+        {
+            m_statistics.queueWaitStartTime = HandlerStatistics::Now();
+        }
+
+        command.pauseEpoch = m_pauseEpoch.load();
+        m_statistics.queuedCommandBytes += command.size;
+
+        m_commandQueue.insert(position, std::move(command));
+        ++m_statistics.queuedCommands;
         m_commandWaiting.notify_all();
     }
 
@@ -291,6 +857,22 @@ namespace JsDebug
         if (m_sendResponseCallback != nullptr)
         {
             m_sendResponseCallback(response, m_sendResponseCallbackState);
+            m_statistics.bytesSent += strlen(response);
+        }
+    }
+
+    void ProtocolHandler::SendObserverResponse(unsigned int sessionId, const char* response)
+    {
+        std::unique_lock<std::mutex> lock(m_observerLock);
+
+        for (const Observer& observer : m_observers)
+        {
+            if (observer.sessionId == sessionId)
+            {
+                observer.callback(response, observer.callbackState);
+                m_statistics.bytesSent += strlen(response);
+                break;
+            }
         }
     }
 
@@ -301,18 +883,39 @@ namespace JsDebug
             throw std::runtime_error("Already connected");
         }
 
+        m_isDetached = false;
+
         m_consoleAgent = std::make_unique<ConsoleImpl>(this, this);
         protocol::Console::Dispatcher::wire(&m_dispatcher, m_consoleAgent.get());
 
         m_debuggerAgent = std::make_unique<DebuggerImpl>(this, this, m_debugger.get());
         protocol::Debugger::Dispatcher::wire(&m_dispatcher, m_debuggerAgent.get());
 
+        m_heapProfilerAgent = std::make_unique<HeapProfilerImpl>(this, this, m_debugger.get(), &m_memoryMonitor);
+        protocol::HeapProfiler::Dispatcher::wire(&m_dispatcher, m_heapProfilerAgent.get());
+
+        m_performanceAgent = std::make_unique<PerformanceImpl>(this, this, &m_memoryMonitor);
+        protocol::Performance::Dispatcher::wire(&m_dispatcher, m_performanceAgent.get());
+
+        m_profilerAgent = std::make_unique<ProfilerImpl>(this, this, m_debugger.get(), &m_memoryMonitor);
+        protocol::Profiler::Dispatcher::wire(&m_dispatcher, m_profilerAgent.get());
+
         m_runtimeAgent = std::make_unique<RuntimeImpl>(this, this, m_debugger.get());
         protocol::Runtime::Dispatcher::wire(&m_dispatcher, m_runtimeAgent.get());
 
         m_schemaAgent = std::make_unique<SchemaImpl>(this, this);
         protocol::Schema::Dispatcher::wire(&m_dispatcher, m_schemaAgent.get());
 
+        m_sessionAgent = std::make_unique<SessionImpl>(this, this);
+        protocol::Session::Dispatcher::wire(&m_dispatcher, m_sessionAgent.get());
+
+        m_timeTravelAgent = std::make_unique<TimeTravelImpl>(this, this, m_debugger.get());
+        protocol::TimeTravel::Dispatcher::wire(&m_dispatcher, m_timeTravelAgent.get());
+
+        m_consoleAggregator.Reset();
+        m_eventMask = SessionImpl::AllEvents;
+        ClearSnapshot();
+
         m_debugger->PauseOnNextStatement();
 
         m_isConnected = true;
@@ -320,24 +923,87 @@ namespace JsDebug
 
     void ProtocolHandler::HandleDisconnect()
     {
+        if (m_isDetached)
+        {
+            // The session already ended when it was detached.
+            m_isDetached = false;
+            return;
+        }
+
         if (!m_isConnected)
         {
             throw std::runtime_error("Not currently connected");
         }
 
+        // Nobody is left to ask about pinned console objects.
+        m_consoleBuffer.ReleaseObjects();
+
         m_consoleAgent.reset();
         m_debuggerAgent.reset();
+        m_heapProfilerAgent.reset();
+        m_performanceAgent.reset();
+        m_profilerAgent.reset();
         m_runtimeAgent.reset();
         m_schemaAgent.reset();
+        m_sessionAgent.reset();
+        m_timeTravelAgent.reset();
+        ClearSnapshot();
 
         RunIfWaitingForDebugger();
         m_isConnected = false;
     }
 
-    void ProtocolHandler::HandleMessageReceived(const std::string& message)
+    void ProtocolHandler::HandleMessageReceived(Command& command)
     {
-        protocol::String messageStr = protocol::String::fromUtf8(message.c_str(), message.length());
-        m_dispatcher.dispatch(protocol::StringUtil::parseJSON(messageStr));
+        std::unique_ptr<protocol::Value> parsedMessage = std::move(command.parsedMessage);
+        unsigned int sessionId = command.sessionId;
+
+        const char* errorMessage = nullptr;
+        bool isRejected = false;
+
+        if (sessionId != PrimarySessionId && !IsObserverMethod(command.method))
+        {
+            errorMessage = c_ErrorObserverReadOnly;
+            isRejected = true;
+        }
+        else if (m_isDetached)
+        {
+            // The agents are gone, but the host has not disconnected yet.
+            errorMessage = c_ErrorSessionDetached;
+            isRejected = true;
+        }
+        else if (command.pauseEpoch != m_pauseEpoch.load() && command.refersToPauseState)
+        {
+            // The ids in this request were handed out during a pause that has
+            // since ended. Answer with an error rather than touching the engine.
+            errorMessage = c_ErrorStaleRequest;
+        }
+
+        // Responses go back to the session that sent the command, but
+        // notifications raised while handling it still go to everyone.
+        m_responseSessionId = sessionId;
+
+        protocol::DictionaryValue* messageObject = protocol::DictionaryValue::cast(parsedMessage.get());
+        int callId = 0;
+
+        if (errorMessage != nullptr && messageObject != nullptr && messageObject->getInteger("id", &callId))
+        {
+            auto error = protocol::DictionaryValue::create();
+            error->setInteger("code", protocol::DispatchResponse::kServerError);
+            error->setString("message", errorMessage);
+
+            auto response = protocol::DictionaryValue::create();
+            response->setObject("error", std::move(error));
+            response->setInteger("id", callId);
+
+            sendProtocolResponse(callId, std::move(response));
+        }
+        else if (!isRejected)
+        {
+            m_dispatcher.dispatch(std::move(parsedMessage));
+        }
+
+        m_responseSessionId = PrimarySessionId;
     }
 
     void ProtocolHandler::HandleHostRequest(const std::string& request)
@@ -356,7 +1022,204 @@ namespace JsDebug
         }
         else if (request == "Console.log")
         {
-            // to do
+            FlushConsole();
+        }
+        else if (request == "HeapProfiler.allocationSample")
+        {
+            if (m_heapProfilerAgent != nullptr)
+            {
+                m_heapProfilerAgent->TakeAllocationSample();
+            }
+        }
+        else if (request == "Performance.metrics")
+        {
+            if (m_performanceAgent != nullptr)
+            {
+                m_performanceAgent->FlushMetrics();
+            }
+        }
+    }
+
+    void ProtocolHandler::RecordSnapshot(const std::string& notification)
+    {
+        std::string method = GetMethodName(notification);
+
+        if (method == "Debugger.scriptParsed" || method == "Debugger.scriptFailedToParse")
+        {
+            std::string scriptId = GetScriptId(notification);
+
+            std::unique_lock<std::mutex> lock(m_snapshotLock);
+            if (!m_isBusyStatusEnabled)
+            {
+                return;
+            }
+
+            auto entry = m_scriptSnapshot.find(scriptId);
+            if (entry == m_scriptSnapshot.end())
+            {
+                m_scriptSnapshot.emplace(scriptId, notification);
+                m_scriptSnapshotOrder.push_back(scriptId);
+            }
+            else
+            {
+                m_scriptSnapshotBytes -= entry->second.size();
+                m_statistics.snapshotBytes -= entry->second.size();
+                entry->second = notification;
+            }
+
+            m_scriptSnapshotBytes += notification.size();
+            m_statistics.snapshotBytes += notification.size();
+
+            // Keep the most recent scripts, which are the likeliest to be busy.
+            while (m_scriptSnapshotBytes > c_MaxScriptSnapshotBytes && m_scriptSnapshotOrder.size() > 1)
+            {
+                auto oldest = m_scriptSnapshot.find(m_scriptSnapshotOrder.front());
+                m_scriptSnapshotOrder.pop_front();
+
+                m_scriptSnapshotBytes -= oldest->second.size();
+                m_statistics.snapshotBytes -= oldest->second.size();
+                m_scriptSnapshot.erase(oldest);
+            }
+        }
+        else if (method == "Debugger.paused" || method == "Debugger.resumed")
+        {
+            std::unique_lock<std::mutex> lock(m_snapshotLock);
+            if (!m_isBusyStatusEnabled)
+            {
+                return;
+            }
+
+            m_statistics.snapshotBytes -= m_pauseSnapshot.size();
+
+            if (method == "Debugger.paused")
+            {
+                m_pauseSnapshot = notification;
+                m_statistics.snapshotBytes += m_pauseSnapshot.size();
+            }
+            else
+            {
+                m_pauseSnapshot.clear();
+            }
+        }
+    }
+
+    void ProtocolHandler::ClearSnapshot()
+    {
+        std::unique_lock<std::mutex> lock(m_snapshotLock);
+        m_scriptSnapshot.clear();
+        m_scriptSnapshotOrder.clear();
+        m_scriptSnapshotBytes = 0;
+        m_pauseSnapshot.clear();
+        m_statistics.snapshotBytes = 0;
+    }
+
+    bool ProtocolHandler::IsOverMemoryBudget()
+    {
+        uint64_t budget = m_memoryBudget;
+        return budget != 0 && m_statistics.RetainedBytes() > budget;
+    }
+
+    void ProtocolHandler::RequestMemoryBudgetEnforcement()
+    {
+        // The budget can only be enforced between commands.
+        if (!m_isMemoryBudgetEnforcementPending.exchange(true))
+        {
+            m_debugger->RequestAsyncBreak();
+        }
+    }
+
+    void ProtocolHandler::EnforceMemoryBudget()
+    {
+        m_isMemoryBudgetEnforcementPending = false;
+
+        if (!IsOverMemoryBudget())
+        {
+            return;
+        }
+
+        // Give up what is cheapest to do without first. Sources can be read
+        // from the engine again when a client asks for them.
+        m_debugger->EvictScriptSources();
+        if (!IsOverMemoryBudget())
+        {
+            return;
+        }
+
+        // Clients already have the scripts, so only a busy status loses them.
+        ClearSnapshot();
+        if (!IsOverMemoryBudget())
+        {
+            return;
+        }
+
+        // Console history is lost to the client, but the session carries on.
+        // Open groups are forgotten along with the counters and timers.
+        m_consoleBuffer.Clear();
+        m_consoleAggregator.Reset();
+        if (!IsOverMemoryBudget())
+        {
+            return;
+        }
+
+        if (m_isConnected)
+        {
+            Detach(c_DetachedMemoryBudget);
+        }
+    }
+
+    void ProtocolHandler::Detach(const char* reason)
+    {
+        auto params = protocol::DictionaryValue::create();
+        params->setString("reason", reason);
+
+        auto notification = protocol::DictionaryValue::create();
+        notification->setString("method", c_DetachedMethod);
+        notification->setObject("params", std::move(params));
+
+        sendProtocolNotification(std::move(notification));
+
+        // Tearing the session down releases everything it held. The host's
+        // callback stays registered so later commands can be answered with an
+        // error until it disconnects.
+        HandleDisconnect();
+        m_isDetached = true;
+    }
+
+    bool ProtocolHandler::IsConsoleEnabled()
+    {
+        return m_runtimeAgent != nullptr && m_runtimeAgent->IsEnabled();
+    }
+
+    void ProtocolHandler::FlushConsole()
+    {
+        if (!IsConsoleEnabled())
+            return;
+
+        if (!IsEventEnabled(SessionEvent::ConsoleAPICalled))
+        {
+            // Entries captured before the mask was set are dropped unwrapped.
+            m_consoleBuffer.Clear();
+            return;
+        }
+
+        std::vector<ConsoleAggregator::Summary> summaries;
+        m_consoleAggregator.Flush(&summaries);
+        CaptureConsoleSummaries(summaries);
+
+        m_isConsoleFlushRequested = false;
+        m_consoleFlushTime = HandlerStatistics::Now();
+
+        m_consoleBuffer.Drain([this](const char* type, std::unique_ptr<Array<protocol::Runtime::RemoteObject>> args)
+        {
+            m_runtimeAgent->consoleAPIEvent(type, std::move(args));
+        });
+    }
+
+    void ProtocolHandler::CaptureConsoleSummaries(const std::vector<ConsoleAggregator::Summary>& summaries)
+    {
+        for (const auto& summary : summaries)
+        {
+            m_consoleBuffer.CaptureText(summary.type, summary.text);
         }
     }
 
@@ -8,13 +8,25 @@
 #include "protocol\Forward.h"
 #include "protocol\Protocol.h"
 
+#include "ConsoleAggregator.h"
+#include "ConsoleBuffer.h"
 #include "ConsoleImpl.h"
 #include "DebuggerImpl.h"
+#include "HandlerStatistics.h"
+#include "HeapProfilerImpl.h"
+#include "MemoryMonitor.h"
+#include "PerformanceImpl.h"
+#include "ProfilerImpl.h"
 #include "RuntimeImpl.h"
 #include "SchemaImpl.h"
+#include "SessionImpl.h"
+#include "TimeTravelImpl.h"
 
 #include <ChakraCore.h>
 
+#include <atomic>
+#include <deque>
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -35,18 +47,58 @@ namespace JsDebug
         void Connect(bool breakOnNextLine, ProtocolHandlerSendResponseCallback callback, void* callbackState);
         void Disconnect();
 
+        // Observers are sent every notification the primary connection gets,
+        // and may only send commands that inspect state. The returned id
+        // addresses the session.
+        unsigned int ConnectObserver(ProtocolHandlerSendResponseCallback callback, void* callbackState);
+        void DisconnectObserver(unsigned int sessionId);
+        void SendObserverCommand(unsigned int sessionId, const char* command);
+
         void SendCommand(const char* command);
         void SendRequest(const char* request);
         void ConsoleAPIEvent(const char* type, const JsValueRef* argv, unsigned short argc);
+        void DiscardConsoleEntries();
+        void AsyncTaskScheduled(JsValueRef task);
+        void AsyncTaskStarted(JsValueRef task);
+        void AsyncTaskFinished(JsValueRef task);
         void SetCommandQueueCallback(ProtocolHandlerCommandQueueCallback callback, void* callbackState);
         void ProcessCommandQueue();
         void WaitForDebugger();
         void RunIfWaitingForDebugger();
         void Continue();
 
+        // Marks ids handed out so far as stale. Called whenever the engine
+        // moves on from the debug event that issued them.
+        void ExpirePauseState();
+
         void ProcessDeferredGo();
 
         std::unique_ptr<protocol::Array<protocol::Schema::Domain>> GetSupportedDomains();
+        bool IsEventEnabled(SessionEvent event);
+        void SetEventMask(uint32_t eventMask);
+
+        // Safe to read from any thread, including while the engine is running.
+        HandlerStatistics& GetStatistics();
+
+        // Caps the memory held for debugging sessions. Zero means no limit.
+        // Once exceeded, script sources are evicted, then console history is
+        // dropped, and finally the session is detached.
+        void SetMemoryBudget(uint64_t maxBytes);
+
+        // The host's runtime memory callbacks, which the handler chains to
+        // while it needs the runtime's slots for its own.
+        void SetRuntimeMemoryCallbacks(JsMemoryAllocationCallback allocationCallback, JsBeforeCollectCallback beforeCollectCallback, void* callbackState);
+
+        // While enabled, the notifications that describe the scripts and pause
+        // state are kept so a busy status can include them.
+        void EnableBusyStatus(bool isEnabled);
+
+        // Builds a notification with the last known scripts and pause state,
+        // along with how long commands have been waiting, and passes it to the
+        // callback on the calling thread for the host to deliver. Nothing is
+        // sent to any session, and the callback isn't called if no commands
+        // are waiting.
+        void GetBusyStatus(ProtocolHandlerSendResponseCallback callback, void* callbackState);
 
         // protocol::FrontendChannel implementation
         void sendProtocolResponse(int callId, std::unique_ptr<protocol::Serializable> message) override;
@@ -63,6 +115,41 @@ namespace JsDebug
             HostRequest,
         };
 
+        struct Command
+        {
+            CommandType type;
+
+            // The text of a host request. Client messages are parsed when they
+            // are queued, and only the parsed value and its envelope are kept.
+            std::string message;
+            std::unique_ptr<protocol::Value> parsedMessage;
+            std::string method;
+            size_t size = 0;
+
+            // Control commands (pause, resume, stepping) are dispatched ahead of
+            // any ordinary messages queued since the last connection change.
+            bool isControl = false;
+
+            // Whether the parameters hold object or call frame ids, and the
+            // pause epoch when the command was queued. Such commands are
+            // cancelled if the epoch has moved on.
+            bool refersToPauseState = false;
+            unsigned int pauseEpoch = 0;
+
+            // The session that sent a message, which gets the response.
+            unsigned int sessionId = PrimarySessionId;
+        };
+
+        struct Observer
+        {
+            unsigned int sessionId;
+            ProtocolHandlerSendResponseCallback callback;
+            void* callbackState;
+            uint32_t eventMask;
+        };
+
+        static const unsigned int PrimarySessionId = 0;
+
         enum class StartupState
         {
             // stay paused in debugger at first break
@@ -76,11 +163,32 @@ namespace JsDebug
         };
 
         void SendResponse(const char* response);
+        void SendObserverResponse(unsigned int sessionId, const char* response);
+        void EnqueueMessage(const char* command, unsigned int sessionId);
         void EnqueueCommand(CommandType type, const std::string& message = "");
+        void InsertCommand(Command command);
         void HandleConnect();
         void HandleDisconnect();
-        void HandleMessageReceived(const std::string& message);
+        void HandleMessageReceived(Command& command);
         void HandleHostRequest(const std::string& request);
+        bool IsOverMemoryBudget();
+        void RequestMemoryBudgetEnforcement();
+        void EnforceMemoryBudget();
+        void Detach(const char* reason);
+        bool IsConsoleEnabled();
+        void FlushConsole();
+        void RequestConsoleFlush(bool isFirstPending);
+        void CaptureConsoleSummaries(const std::vector<ConsoleAggregator::Summary>& summaries);
+        void RecordSnapshot(const std::string& notification);
+        void ClearSnapshot();
+
+        // Declared ahead of the debugger, which updates it until destroyed.
+        HandlerStatistics m_statistics;
+        std::atomic<uint64_t> m_memoryBudget;
+
+        // Set once a break has been requested to enforce the budget, until it
+        // is enforced, so that repeated checks request only the one break.
+        std::atomic<bool> m_isMemoryBudgetEnforcementPending;
 
         std::unique_ptr<Debugger> m_debugger;
         ProtocolHandlerSendResponseCallback m_sendResponseCallback;
@@ -90,8 +198,13 @@ namespace JsDebug
 
         std::mutex m_lock;
         std::condition_variable m_commandWaiting;
-        std::vector<std::pair<CommandType, std::string>> m_commandQueue;
+        std::deque<Command> m_commandQueue;
+        std::atomic<unsigned int> m_pauseEpoch;
         bool m_isConnected;
+
+        // Set when the handler ends a session on its own, until the host
+        // disconnects it.
+        bool m_isDetached;
         bool m_waitingForDebugger;
         bool m_processingCommandQueue;
         bool m_breakOnConnect;
@@ -99,10 +212,43 @@ namespace JsDebug
 
         bool m_deferredGo;
 
+        // Observers are added and removed on the service thread and sent to
+        // from the engine thread. Their callbacks run under this lock, so none
+        // is called once DisconnectObserver returns.
+        std::mutex m_observerLock;
+        std::vector<Observer> m_observers;
+        unsigned int m_nextSessionId;
+        std::atomic<uint32_t> m_observerEventMask;
+
+        // The notifications that describe the current state, kept while busy
+        // status is enabled so they can be reported while the script thread is
+        // busy. Scripts are keyed by id and dropped oldest first past a cap,
+        // and the pause is cleared on resume.
+        std::mutex m_snapshotLock;
+        std::atomic<bool> m_isBusyStatusEnabled;
+        std::map<std::string, std::string> m_scriptSnapshot;
+        std::deque<std::string> m_scriptSnapshotOrder;
+        size_t m_scriptSnapshotBytes;
+        std::string m_pauseSnapshot;
+
+        uint32_t m_eventMask;
+        unsigned int m_responseSessionId;
+
+        ConsoleAggregator m_consoleAggregator;
+        ConsoleBuffer m_consoleBuffer;
+        bool m_isConsoleFlushRequested;
+        int64_t m_consoleFlushTime;
+        MemoryMonitor m_memoryMonitor;
+
         protocol::UberDispatcher m_dispatcher;
         std::unique_ptr<ConsoleImpl> m_consoleAgent;
         std::unique_ptr<DebuggerImpl> m_debuggerAgent;
+        std::unique_ptr<HeapProfilerImpl> m_heapProfilerAgent;
+        std::unique_ptr<PerformanceImpl> m_performanceAgent;
+        std::unique_ptr<ProfilerImpl> m_profilerAgent;
         std::unique_ptr<RuntimeImpl> m_runtimeAgent;
         std::unique_ptr<SchemaImpl> m_schemaAgent;
+        std::unique_ptr<SessionImpl> m_sessionAgent;
+        std::unique_ptr<TimeTravelImpl> m_timeTravelAgent;
     };
 }
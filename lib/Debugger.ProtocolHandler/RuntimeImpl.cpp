@@ -29,9 +29,32 @@ namespace JsDebug
     namespace
     {
         const char c_ErrorInvalidObjectId[] = "Invalid object ID";
+        const char c_ErrorInvalidScriptId[] = "Invalid script ID";
         const char c_ErrorNotEnabled[] = "Runtime is not enabled";
         const char c_ErrorNotImplemented[] = "Not implemented";
         const char c_ErrorScriptParse[] = "Script parse failed";
+        const char c_ErrorScriptRun[] = "Script execution failed";
+
+        const size_t c_MaxCompiledScripts = 64;
+        const char c_CompiledScriptIdPrefix[] = "compiled-";
+
+        std::unique_ptr<ExceptionDetails> GetAndClearExceptionDetails()
+        {
+            bool hasExc;
+            JsValueRef excval;
+            if (JsHasException(&hasExc) == JsNoError && hasExc && JsGetAndClearExceptionWithMetadata(&excval) == JsNoError)
+            {
+                return ExceptionDetails::create()
+                    .setColumnNumber(PropertyHelpers::GetPropertyInt(excval, "column"))
+                    .setLineNumber(PropertyHelpers::GetPropertyInt(excval, "line"))
+                    .setException(ProtocolHelpers::WrapValue(excval))
+                    .setExceptionId(0)
+                    .setText(PropertyHelpers::GetPropertyString(PropertyHelpers::GetProperty(excval, "exception"), "message"))
+                    .build();
+            }
+
+            return nullptr;
+        }
     }
 
     RuntimeImpl::RuntimeImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel, Debugger* debugger)
@@ -39,11 +62,14 @@ namespace JsDebug
         , m_frontend(frontendChannel)
         , m_debugger(debugger)
         , m_isEnabled(false)
+        , m_nextCompiledScriptId(1)
+        , m_retainedValueCount(0)
     {
     }
 
     RuntimeImpl::~RuntimeImpl()
     {
+        ClearCompiledScripts();
     }
 
     void RuntimeImpl::evaluate(
@@ -322,9 +348,35 @@ namespace JsDebug
         return Response::Error(c_ErrorNotImplemented);
     }
 
-    Response RuntimeImpl::releaseObjectGroup(const String& /*in_objectGroup*/)
+    Response RuntimeImpl::releaseObjectGroup(const String& in_objectGroup)
     {
-        return Response::Error(c_ErrorNotImplemented);
+        // Object handles are owned by the engine and expire with the break, so
+        // the only thing held on behalf of a group is the compiled scripts that
+        // were run under it. Scripts not run under a group belong to none, and
+        // are only dropped when evicted or when the domain is disabled.
+        if (in_objectGroup.empty())
+        {
+            return Response::OK();
+        }
+
+        for (auto it = m_compiledScriptOrder.begin(); it != m_compiledScriptOrder.end();)
+        {
+            auto script = m_compiledScripts.find(*it);
+
+            if (script != m_compiledScripts.end() && script->second.objectGroup == in_objectGroup)
+            {
+                m_compiledScripts.erase(script);
+                it = m_compiledScriptOrder.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        UpdateStatistics();
+
+        return Response::OK();
     }
 
     Response RuntimeImpl::runIfWaitingForDebugger()
@@ -365,6 +417,7 @@ namespace JsDebug
         }
 
         m_isEnabled = false;
+        ClearCompiledScripts();
         // TODO: Do other cleanup
 
         return Response::OK();
@@ -372,7 +425,8 @@ namespace JsDebug
 
     Response RuntimeImpl::discardConsoleEntries()
     {
-        return Response::Error(c_ErrorNotImplemented);
+        m_handler->DiscardConsoleEntries();
+        return Response::OK();
     }
 
     Response RuntimeImpl::setCustomObjectFormatterEnabled(bool /*in_enabled*/)
@@ -385,35 +439,57 @@ namespace JsDebug
         const String& sourceURL,
         bool persistScript,
         Maybe<int> /*in_executionContextId*/,
-        Maybe<String>* /*out_scriptId*/,
+        Maybe<String>* out_scriptId,
         Maybe<ExceptionDetails>* exceptionDetails)
     {
-        // we don't implement persisting the script (yet)
-        if (persistScript)
-            return Response::Error(c_ErrorNotImplemented);
-
         // parse the script
         JsValueRef func;
         JsErrorCode err = JsParseScript(expr.wchars(), 0, sourceURL.wchars(), &func);
 
-        // If that succeeded, return success.  We weren't asked to persist the script,
-        // so no additional details are required.
         if (err == JsNoError)
+        {
+            // If we weren't asked to persist the script, no additional details
+            // are required.
+            if (!persistScript)
+                return Response::OK();
+
+            // Evict the oldest entry once the cache is full.
+            if (m_compiledScriptOrder.size() >= c_MaxCompiledScripts)
+            {
+                m_compiledScripts.erase(m_compiledScriptOrder.front());
+                m_compiledScriptOrder.pop_front();
+            }
+
+            // Use the engine's id for the parsed script, which is the one the
+            // Debugger domain reports, so the two can't name different scripts.
+            // The prefixed fallback can't be mistaken for an engine id.
+            String scriptId;
+            JsValueRef position = JS_INVALID_REFERENCE;
+            int engineScriptId = 0;
+
+            if (JsDiagGetFunctionPosition(func, &position) == JsNoError &&
+                PropertyHelpers::TryGetProperty(position, PropertyHelpers::Names::ScriptId, &engineScriptId))
+            {
+                scriptId = String::fromInteger(engineScriptId);
+            }
+            else
+            {
+                scriptId = String(c_CompiledScriptIdPrefix) + String::fromInteger(m_nextCompiledScriptId++);
+            }
+
+            m_compiledScripts.emplace(scriptId, CompiledScript { JsPersistent(func), String(), expr.length() * sizeof(UChar) });
+            m_compiledScriptOrder.push_back(scriptId);
+            UpdateStatistics();
+
+            *out_scriptId = scriptId;
             return Response::OK();
+        }
 
         // if a script parsing error occurred, retrieve the exception data
-        bool hasExc;
-        JsValueRef excval;
-        if (JsHasException(&hasExc) == JsNoError && JsGetAndClearExceptionWithMetadata(&excval) == JsNoError)
+        std::unique_ptr<ExceptionDetails> details = GetAndClearExceptionDetails();
+        if (details != nullptr)
         {
-            auto details0 = ExceptionDetails::create();
-            auto details = &details0.setColumnNumber(PropertyHelpers::GetPropertyInt(excval, "column"))
-                .setLineNumber(PropertyHelpers::GetPropertyInt(excval, "line"))
-                .setException(ProtocolHelpers::WrapValue(excval))
-                .setExceptionId(0)
-                .setText(PropertyHelpers::GetPropertyString(PropertyHelpers::GetProperty(excval, "exception"), "message"));
-
-            *exceptionDetails = details->build();
+            *exceptionDetails = std::move(details);
             return Response::OK();
         }
 
@@ -422,17 +498,56 @@ namespace JsDebug
     }
 
     void RuntimeImpl::runScript(
-        const String& /*in_scriptId*/,
+        const String& in_scriptId,
         Maybe<int> /*in_executionContextId*/,
-        Maybe<String> /*in_objectGroup*/,
+        Maybe<String> in_objectGroup,
         Maybe<bool> /*in_silent*/,
         Maybe<bool> /*in_includeCommandLineAPI*/,
         Maybe<bool> /*in_returnByValue*/,
         Maybe<bool> /*in_generatePreview*/,
-        Maybe<bool> /*in_awaitPromise*/,
+        Maybe<bool> in_awaitPromise,
         std::unique_ptr<RunScriptCallback> callback)
     {
-        callback->sendFailure(Response::Error(c_ErrorNotImplemented));
+        // "await promise" isn't implemented yet
+        if (in_awaitPromise.fromMaybe(false))
+        {
+            callback->sendFailure(Response::Error(c_ErrorNotImplemented));
+            return;
+        }
+
+        auto script = m_compiledScripts.find(in_scriptId);
+        if (script == m_compiledScripts.end())
+        {
+            callback->sendFailure(Response::Error(c_ErrorInvalidScriptId));
+            return;
+        }
+
+        if (in_objectGroup.isJust())
+        {
+            script->second.objectGroup = in_objectGroup.fromJust();
+        }
+
+        // Run the already parsed function rather than the source text.
+        JsValueRef undefinedValue = JS_INVALID_REFERENCE;
+        IfJsErrorThrow(JsGetUndefinedValue(&undefinedValue));
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        JsErrorCode err = JsCallFunction(script->second.function.Get(), &undefinedValue, 1, &result);
+
+        if (err == JsNoError)
+        {
+            callback->sendSuccess(ProtocolHelpers::WrapValue(result), Maybe<ExceptionDetails>());
+            return;
+        }
+
+        std::unique_ptr<ExceptionDetails> details = GetAndClearExceptionDetails();
+        if (details != nullptr)
+        {
+            callback->sendSuccess(ProtocolHelpers::GetUndefinedObject(), std::move(details));
+            return;
+        }
+
+        callback->sendFailure(Response::Error(c_ErrorScriptRun));
     }
 
     bool RuntimeImpl::IsEnabled()
@@ -440,13 +555,33 @@ namespace JsDebug
         return m_isEnabled;
     }
 
-    void RuntimeImpl::consoleAPIEvent(const char* type, const JsValueRef* argv, unsigned short argc)
+    void RuntimeImpl::ClearCompiledScripts()
+    {
+        m_compiledScripts.clear();
+        m_compiledScriptOrder.clear();
+        UpdateStatistics();
+    }
+
+    void RuntimeImpl::UpdateStatistics()
+    {
+        size_t size = 0;
+        for (const auto& script : m_compiledScripts)
+        {
+            size += script.second.size;
+        }
+
+        HandlerStatistics& statistics = m_handler->GetStatistics();
+        statistics.compiledScriptBytes = size;
+
+        uint32_t count = static_cast<uint32_t>(m_compiledScripts.size());
+        statistics.retainedValueCount += count;
+        statistics.retainedValueCount -= m_retainedValueCount;
+        m_retainedValueCount = count;
+    }
+
+    void RuntimeImpl::consoleAPIEvent(const char* type, std::unique_ptr<Array<protocol::Runtime::RemoteObject>> args)
     {
-        auto argArray = protocol::Array<protocol::Runtime::RemoteObject>::create();
-        protocol::ErrorSupport es;
-        for (unsigned short i = 0; i < argc; ++i)
-            argArray->addItem(ProtocolHelpers::WrapValue(argv[i]));
-        m_frontend.consoleAPICalled(type, std::move(argArray), 0, 0);
+        m_frontend.consoleAPICalled(type, std::move(args), 0, 0);
     }
 
 }
@@ -4,10 +4,13 @@
 #pragma once
 
 #include "Debugger.h"
+#include "JsPersistent.h"
 
 #include <protocol\Runtime.h>
 #include <protocol\Forward.h>
 
+#include <deque>
+
 namespace JsDebug
 {
     class ProtocolHandler;
@@ -81,14 +84,42 @@ namespace JsDebug
             protocol::Maybe<bool> in_awaitPromise,
             std::unique_ptr<RunScriptCallback> callback) override;
 
-        void consoleAPIEvent(const char* type, const JsValueRef* argv, unsigned short argc);
+        void consoleAPIEvent(const char* type, std::unique_ptr<protocol::Array<protocol::Runtime::RemoteObject>> args);
 
-    private:
         bool IsEnabled();
 
+    private:
+        struct CompiledScript
+        {
+            JsPersistent function;
+            protocol::String objectGroup;
+
+            // Length of the source, in bytes, as an estimate of what the
+            // parsed function keeps alive.
+            size_t size;
+        };
+
+        void ClearCompiledScripts();
+
+        // Publishes the cache size for the host to read.
+        void UpdateStatistics();
+
         ProtocolHandler* m_handler;
         protocol::Runtime::Frontend m_frontend;
         Debugger* m_debugger;
         bool m_isEnabled;
+
+        // Scripts persisted by compileScript, kept as parsed functions so that
+        // runScript does not have to parse them again. The cache is bounded and
+        // evicts in insertion order.
+        protocol::HashMap<protocol::String, CompiledScript> m_compiledScripts;
+        std::deque<protocol::String> m_compiledScriptOrder;
+
+        // Numbers the scripts the engine gives no id for.
+        int m_nextCompiledScriptId;
+
+        // The number of cached functions last added to the retained value
+        // count, which the debugger's own values also go into.
+        uint32_t m_retainedValueCount;
     };
 }
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "SessionImpl.h"
+
+#include "ProtocolHandler.h"
+
+namespace JsDebug
+{
+    using protocol::Array;
+    using protocol::FrontendChannel;
+    using protocol::Maybe;
+    using protocol::Response;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_ErrorUnknownEvent[] = "Event cannot be masked: ";
+
+        struct EventName
+        {
+            const char* name;
+            SessionEvent event;
+        };
+
+        const EventName c_EventNames[] =
+        {
+            { "Debugger.scriptParsed", SessionEvent::ScriptParsed },
+            { "Debugger.scriptFailedToParse", SessionEvent::ScriptFailedToParse },
+            { "Debugger.breakpointResolved", SessionEvent::BreakpointResolved },
+            { "Runtime.consoleAPICalled", SessionEvent::ConsoleAPICalled },
+        };
+    }
+
+    SessionImpl::SessionImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel)
+        : m_handler(handler)
+        , m_frontend(frontendChannel)
+    {
+    }
+
+    SessionImpl::~SessionImpl()
+    {
+    }
+
+    Response SessionImpl::setEventMask(Maybe<Array<String>> in_events)
+    {
+        if (!in_events.isJust())
+        {
+            m_handler->SetEventMask(AllEvents);
+            return Response::OK();
+        }
+
+        // Validate everything before changing anything.
+        uint32_t eventMask = 0;
+        Array<String>* events = in_events.fromJust();
+
+        for (size_t index = 0; index < events->length(); ++index)
+        {
+            const String& name = events->get(index);
+            bool found = false;
+
+            for (const EventName& eventName : c_EventNames)
+            {
+                if (name == eventName.name)
+                {
+                    eventMask |= static_cast<uint32_t>(eventName.event);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                return Response::Error(c_ErrorUnknownEvent + name);
+            }
+        }
+
+        // The mask belongs to the session that sent the command.
+        m_handler->SetEventMask(eventMask);
+        return Response::OK();
+    }
+
+    uint32_t SessionImpl::GetEventMask(const std::string& method)
+    {
+        for (const EventName& eventName : c_EventNames)
+        {
+            if (method == eventName.name)
+            {
+                return static_cast<uint32_t>(eventName.event);
+            }
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+#include <protocol\Session.h>
+
+#include <cstdint>
+#include <string>
+
+namespace JsDebug
+{
+    class ProtocolHandler;
+
+    // Events a session can opt out of. Work to produce a masked event is
+    // skipped, not just the send.
+    enum class SessionEvent : uint32_t
+    {
+        ScriptParsed = 1 << 0,
+        ScriptFailedToParse = 1 << 1,
+        BreakpointResolved = 1 << 2,
+        ConsoleAPICalled = 1 << 3,
+    };
+
+    class SessionImpl : public protocol::Session::Backend
+    {
+    public:
+        SessionImpl(ProtocolHandler* handler, protocol::FrontendChannel* frontendChannel);
+        ~SessionImpl() override;
+        SessionImpl(const SessionImpl&) = delete;
+        SessionImpl& operator=(const SessionImpl&) = delete;
+
+        // protocol::Session::Backend implementation
+        protocol::Response setEventMask(protocol::Maybe<protocol::Array<protocol::String>> in_events) override;
+
+        static const uint32_t AllEvents = UINT32_MAX;
+
+        // The mask bit for a notification's method name, or zero when the
+        // notification cannot be masked.
+        static uint32_t GetEventMask(const std::string& method);
+
+    private:
+        ProtocolHandler* m_handler;
+        protocol::Session::Frontend m_frontend;
+    };
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include "TimeTravelImpl.h"
+
+#include "ErrorHelpers.h"
+#include "ProtocolHandler.h"
+
+namespace JsDebug
+{
+    using protocol::FrontendChannel;
+    using protocol::Response;
+    using protocol::String;
+
+    namespace
+    {
+        const char c_ErrorNotPaused[] = "Can only perform operation while paused";
+        const char c_ErrorScriptRunning[] = "Cannot write the log while script is running; pause first";
+        const char c_ErrorUriRequired[] = "A log location must be specified";
+    }
+
+    TimeTravelImpl::TimeTravelImpl(ProtocolHandler* handler, FrontendChannel* frontendChannel, Debugger* debugger)
+        : m_handler(handler)
+        , m_frontend(frontendChannel)
+        , m_debugger(debugger)
+    {
+    }
+
+    TimeTravelImpl::~TimeTravelImpl()
+    {
+    }
+
+    void TimeTravelImpl::writeTTDLog(const String& in_uri, std::unique_ptr<WriteTTDLogCallback> callback)
+    {
+        if (in_uri.length() == 0)
+        {
+            callback->sendFailure(Response::Error(c_ErrorUriRequired));
+            return;
+        }
+
+        // The log is only consistent when no script is part way through a
+        // statement: while paused, or when the host processes commands from
+        // its own loop. Anything else is a debug event raised while script
+        // runs, and waiting for a pause could take forever.
+        if (!m_debugger->IsPaused() && m_debugger->IsHandlingDebugEvent())
+        {
+            callback->sendFailure(Response::Error(c_ErrorScriptRunning));
+            return;
+        }
+
+        // The bytes go to the stream callbacks the host gave the record
+        // runtime, which may hand them to another thread, so the engine is
+        // held up no longer than it takes to serialize.
+        std::string uri = in_uri.toUtf8();
+        JsErrorCode result = JsTTDDiagWriteLog(uri.c_str(), uri.length());
+
+        if (result != JsNoError)
+        {
+            callback->sendFailure(Response::Error(JsErrorException(result).what()));
+            return;
+        }
+
+        callback->sendSuccess();
+    }
+
+    Response TimeTravelImpl::stepBack()
+    {
+        if (!m_debugger->IsPaused())
+        {
+            return Response::Error(c_ErrorNotPaused);
+        }
+
+        try
+        {
+            m_debugger->StepBack();
+        }
+        catch (const JsErrorException& e)
+        {
+            return Response::Error(e.what());
+        }
+
+        return Response::OK();
+    }
+
+    Response TimeTravelImpl::reverse()
+    {
+        if (!m_debugger->IsPaused())
+        {
+            return Response::Error(c_ErrorNotPaused);
+        }
+
+        try
+        {
+            m_debugger->ReverseContinue();
+        }
+        catch (const JsErrorException& e)
+        {
+            return Response::Error(e.what());
+        }
+
+        return Response::OK();
+    }
+}
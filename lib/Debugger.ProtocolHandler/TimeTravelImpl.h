@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <protocol\Forward.h>
+#include <protocol\TimeTravel.h>
+
+#include "Debugger.h"
+
+#include <memory>
+
+namespace JsDebug
+{
+    class ProtocolHandler;
+
+    class TimeTravelImpl : public protocol::TimeTravel::Backend
+    {
+    public:
+        TimeTravelImpl(ProtocolHandler* handler, protocol::FrontendChannel* frontendChannel, Debugger* debugger);
+        ~TimeTravelImpl() override;
+        TimeTravelImpl(const TimeTravelImpl&) = delete;
+        TimeTravelImpl& operator=(const TimeTravelImpl&) = delete;
+
+        // protocol::TimeTravel::Backend implementation
+        void writeTTDLog(const protocol::String& in_uri, std::unique_ptr<WriteTTDLogCallback> callback) override;
+        protocol::Response stepBack() override;
+        protocol::Response reverse() override;
+
+    private:
+        ProtocolHandler* m_handler;
+        protocol::TimeTravel::Frontend m_frontend;
+        Debugger* m_debugger;
+    };
+}
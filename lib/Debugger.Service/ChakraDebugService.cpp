@@ -60,6 +60,16 @@ CHAKRA_API JsDebugServiceUnregisterHandler(JsDebugService service, const char* i
         });
 }
 
+CHAKRA_API JsDebugServiceSetBusyThreshold(JsDebugService service, uint32_t milliseconds)
+{
+    return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::Service*>(
+        service,
+        [&](JsDebug::Service* instance) -> void
+        {
+            instance->SetBusyThreshold(milliseconds);
+        });
+}
+
 CHAKRA_API JsDebugServiceListen(JsDebugService service, uint16_t port)
 {
     return JsDebug::TranslateExceptionToJsErrorCode<JsDebug::Service*>(
@@ -34,11 +34,28 @@ CHAKRA_API JsDebugServiceRegisterHandler(
     _In_ bool breakOnNextLine);
 
 /// <summary>Unregister a handler instance from a given instance.</summary>
+/// <remarks>
+///     While the service is listening, the handler's connections are closed on the service thread and this waits for
+///     them, after which the handler instance can be destroyed.
+/// </remarks>
 /// <param name="service">The instance to unregister from.</param>
 /// <param name="id">The ID of the handler to unregister.</param>
 /// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
 CHAKRA_API JsDebugServiceUnregisterHandler(_In_ JsDebugService service, _In_z_ const char* id);
 
+/// <summary>Sets how long commands may wait on a busy runtime before its clients are sent a status.</summary>
+/// <remarks>
+///     Clients of a handler whose commands have waited at least this long are sent a <c>Session.targetBusy</c>
+///     notification with the scripts and pause state already known. The notification is sent from the service's own
+///     thread, and the commands are still answered once the runtime gets to them. While a threshold is set, registered
+///     handlers keep the notifications the status reports, which count against their memory budget. The default is
+///     1000 milliseconds.
+/// </remarks>
+/// <param name="service">The instance to configure.</param>
+/// <param name="milliseconds">The threshold in milliseconds, or zero to never report a busy runtime.</param>
+/// <returns>The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.</returns>
+CHAKRA_API JsDebugServiceSetBusyThreshold(_In_ JsDebugService service, _In_ uint32_t milliseconds);
+
 /// <summary>Start listening on a given port.</summary>
 /// <param name="service">The instance to listen with.</param>
 /// <param name="port">The port number to listen on.</param>
@@ -4,8 +4,13 @@
 #include "stdafx.h"
 #include "Service.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <regex>
+#include <thread>
+#include <vector>
 
 namespace JsDebug
 {
@@ -34,6 +39,8 @@ namespace JsDebug
         const char c_ResourceJsonProtocol[] = "/json/protocol";
         const char c_ResourceJsonVersion[] = "/json/version";
         const char c_ResourceIcon[] = "/resource/icon.ico";
+        const uint32_t c_DefaultBusyThreshold = 1000;
+        const long c_WatchdogInterval = 250;
     }
 
     static void GetChakraCoreVersion(std::string &version)
@@ -82,6 +89,8 @@ namespace JsDebug
 
     Service::Service()
         : m_port(0)
+        , m_isRunning(false)
+        , m_busyThreshold(c_DefaultBusyThreshold)
     {
         // TODO: Enable logging to a file
         m_server.set_error_channels(elevel::none);
@@ -123,16 +132,97 @@ namespace JsDebug
             m_favIcon.clear();
     }
 
-    void Service::RegisterHandler(const char* id, JsDebugProtocolHandler protocolHandler, bool breakOnNextLine)
+    void Service::SetBusyThreshold(uint32_t milliseconds)
     {
         unique_lock<mutex> lock(m_lock);
-        m_handlers.emplace(id, std::make_unique<ServiceHandler>(&m_server, id, protocolHandler, breakOnNextLine));
+
+        bool wasEnabled = m_busyThreshold.exchange(milliseconds) != 0;
+
+        if (wasEnabled == (milliseconds != 0))
+        {
+            return;
+        }
+
+        // Handlers only keep the state a busy status reports while there is a threshold to report against.
+        for (HandlerShard& shard : m_handlerShards)
+        {
+            unique_lock<mutex> shardLock(shard.lock);
+
+            for (const auto& handler : shard.handlers)
+            {
+                handler.second->EnableBusyStatus(milliseconds != 0);
+            }
+        }
+    }
+
+    void Service::RegisterHandler(const char* id, JsDebugProtocolHandler protocolHandler, bool breakOnNextLine)
+    {
+        // Build the handler before taking the lock so the lock is only held to insert it.
+        auto handler = std::make_unique<ServiceHandler>(&m_server, id, protocolHandler, breakOnNextLine);
+        HandlerShard& shard = GetShard(handler->Id());
+
+        // Read under the shard lock, so a threshold set meanwhile either is seen here or finds the handler.
+        unique_lock<mutex> lock(shard.lock);
+        handler->EnableBusyStatus(m_busyThreshold != 0);
+        shard.handlers.emplace(handler->Id(), std::move(handler));
     }
 
     void Service::UnregisterHandler(const char* id)
     {
-        unique_lock<mutex> lock(m_lock);
-        m_handlers.erase(id);
+        std::unique_ptr<ServiceHandler> handler;
+
+        {
+            HandlerShard& shard = GetShard(id);
+            unique_lock<mutex> lock(shard.lock);
+
+            auto entry = shard.handlers.find(id);
+            if (entry == shard.handlers.end())
+            {
+                return;
+            }
+
+            handler = std::move(entry->second);
+            shard.handlers.erase(entry);
+        }
+
+        DestroyHandler(std::move(handler));
+    }
+
+    Service::HandlerShard& Service::GetShard(const std::string& id)
+    {
+        return m_handlerShards[std::hash<std::string>()(id) % c_HandlerShardCount];
+    }
+
+    void Service::DestroyHandler(std::unique_ptr<ServiceHandler> handler)
+    {
+        std::promise<void> destroyed;
+        std::future<void> isDestroyed = destroyed.get_future();
+
+        {
+            unique_lock<mutex> lock(m_lock);
+
+            if (!m_isRunning || std::this_thread::get_id() == m_thread.get_id())
+            {
+                // Either there is no server thread to use it, or this is the server thread, which would never get to
+                // a posted delete while waiting for it.
+                lock.unlock();
+                handler.reset();
+                return;
+            }
+
+            // Destroying the handler closes its connections, which is done on the server thread so it can't race
+            // with their callbacks. Anything posted before Close clears the flag runs before the thread exits.
+            ServiceHandler* expired = handler.release();
+            m_server.get_io_service().post([expired, &destroyed]()
+            {
+                delete expired;
+                destroyed.set_value();
+            });
+        }
+
+        // The host may destroy the protocol handler once unregistering returns, so wait for the handler to be done
+        // with it. No locks are held, so other runtimes and connections carry on meanwhile.
+        isDestroyed.wait();
     }
 
     void Service::Listen(uint16_t port)
@@ -142,6 +232,13 @@ namespace JsDebug
         m_server.listen(c_LocalHostName, std::to_string(m_port));
         m_server.start_accept();
 
+        {
+            unique_lock<mutex> lock(m_lock);
+            m_isRunning = true;
+        }
+
+        StartWatchdog();
+
         m_thread = thread(&server::run, &m_server);
     }
 
@@ -153,8 +250,21 @@ namespace JsDebug
 
         {
             unique_lock<mutex> lock(m_lock);
+            m_isRunning = false;
 
-            for (const auto& handler : m_handlers)
+            // The server thread won't exit while the timer is pending.
+            if (m_watchdogTimer != nullptr)
+            {
+                m_watchdogTimer->cancel();
+                m_watchdogTimer.reset();
+            }
+        }
+
+        for (HandlerShard& shard : m_handlerShards)
+        {
+            unique_lock<mutex> lock(shard.lock);
+
+            for (const auto& handler : shard.handlers)
             {
                 handler.second->Disconnect();
             }
@@ -166,6 +276,58 @@ namespace JsDebug
         }
     }
 
+    void Service::StartWatchdog()
+    {
+        unique_lock<mutex> lock(m_lock);
+        m_watchdogTimer = m_server.set_timer(c_WatchdogInterval, bind(&Service::OnWatchdogTimer, this, _1));
+    }
+
+    void Service::OnWatchdogTimer(const websocketpp::lib::error_code& ec)
+    {
+        if (ec)
+        {
+            // Cancelled by Close.
+            return;
+        }
+
+        {
+            unique_lock<mutex> lock(m_lock);
+
+            if (m_watchdogTimer == nullptr)
+            {
+                return;
+            }
+        }
+
+        // Checked one shard at a time without the service lock, so registering and unregistering elsewhere carry on
+        // while clients are sent their status. Handlers are destroyed on this thread, or after leaving their shard
+        // once the server has stopped, so each is alive while its shard is locked.
+        uint64_t thresholdMicroseconds = static_cast<uint64_t>(m_busyThreshold) * 1000;
+
+        if (thresholdMicroseconds != 0)
+        {
+            for (HandlerShard& shard : m_handlerShards)
+            {
+                unique_lock<mutex> shardLock(shard.lock);
+
+                for (const auto& handler : shard.handlers)
+                {
+                    handler.second->CheckBusy(thresholdMicroseconds);
+                }
+            }
+        }
+
+        unique_lock<mutex> lock(m_lock);
+
+        if (m_watchdogTimer == nullptr)
+        {
+            // Closed while checking.
+            return;
+        }
+
+        m_watchdogTimer = m_server.set_timer(c_WatchdogInterval, bind(&Service::OnWatchdogTimer, this, _1));
+    }
+
     bool Service::OnValidate(connection_hdl hdl)
     {
         auto connection = m_server.get_con_from_hdl(hdl);
@@ -175,10 +337,11 @@ namespace JsDebug
             resource.erase(0, 1);
 
             {
-                unique_lock<mutex> lock(m_lock);
+                HandlerShard& shard = GetShard(resource);
+                unique_lock<mutex> lock(shard.lock);
 
-                auto handler = m_handlers.find(resource);
-                if (handler != m_handlers.end()) {
+                auto handler = shard.handlers.find(resource);
+                if (handler != shard.handlers.end()) {
                     return handler->second->Connect(hdl);
                 }
             }
@@ -219,6 +382,21 @@ namespace JsDebug
 
     void Service::HandleListRequest(connection_hdl hdl)
     {
+        // Take each shard's lock only long enough to copy its IDs, and list them in order as before.
+        std::vector<std::string> ids;
+
+        for (HandlerShard& shard : m_handlerShards)
+        {
+            unique_lock<mutex> lock(shard.lock);
+
+            for (const auto& handler : shard.handlers)
+            {
+                ids.push_back(handler.first);
+            }
+        }
+
+        std::sort(ids.begin(), ids.end());
+
         bool first = true;
         std::ostringstream json;
         json << "[";
@@ -226,7 +404,7 @@ namespace JsDebug
         {
             unique_lock<mutex> lock(m_lock);
 
-            for (const auto& handler : m_handlers) {
+            for (const std::string& id : ids) {
                 if (first)
                 {
                     first = false;
@@ -241,14 +419,14 @@ namespace JsDebug
                 json << "  \"description\": \"" << m_serviceDesc << "\",\n";
                 json << "  \"devtoolsFrontendUrl\": " <<
                     "\"chrome-devtools://devtools/bundled/inspector.html?experiments=true&v8only=true&ws=localhost:" <<
-                    m_port << "/" << handler.second->Id() << "\",\n";
+                    m_port << "/" << id << "\",\n";
                 if (m_favIcon.length() != 0)
                     json << "  \"faviconUrl\": \"http://localhost:" << m_port << c_ResourceIcon << "\",\n";
-                json << "  \"id\": \"" << handler.second->Id() << "\",\n";
+                json << "  \"id\": \"" << id << "\",\n";
                 json << "  \"title\": \"" << m_serviceName << "\",\n";
                 json << "  \"type\": \"node\",\n";
                 json << "  \"url\": \"file://\",\n";
-                json << "  \"webSocketDebuggerUrl\": \"ws://localhost:" << m_port << "/" << handler.second->Id() << "\"\n";
+                json << "  \"webSocketDebuggerUrl\": \"ws://localhost:" << m_port << "/" << id << "\"\n";
                 json << "}";
             }
         }
@@ -5,6 +5,9 @@
 
 #include "ServiceHandler.h"
 
+#include <array>
+#include <atomic>
+
 namespace JsDebug
 {
     class Service
@@ -18,6 +21,7 @@ namespace JsDebug
 
         void SetServiceName(const char* name, const char* description);
         void SetFavIcon(const BYTE* data, size_t size);
+        void SetBusyThreshold(uint32_t milliseconds);
 
         void Listen(uint16_t port);
         void Close();
@@ -33,16 +37,41 @@ namespace JsDebug
 
         void SendHttpJsonResponse(websocketpp::connection_hdl hdl, const std::string& jsonBody);
 
+        void StartWatchdog();
+        void OnWatchdogTimer(const websocketpp::lib::error_code& ec);
+
         typedef std::map<std::string, std::unique_ptr<ServiceHandler>> handler_map;
 
+        // Handlers are spread over shards by ID, each with its own lock, so registering one runtime doesn't wait on
+        // another or on connections to a third. Handlers are only destroyed on the server thread, which may use them
+        // while holding nothing but their shard's lock.
+        struct HandlerShard
+        {
+            websocketpp::lib::mutex lock;
+            handler_map handlers;
+        };
+
+        static const size_t c_HandlerShardCount = 32;
+
+        HandlerShard& GetShard(const std::string& id);
+        void DestroyHandler(std::unique_ptr<ServiceHandler> handler);
+
         // Although access to the server object is thread-safe, access to all other objects is not. The lock must be
-        // taken before accessing any class members from either thread.
+        // taken before accessing any class members other than the handlers from either thread, and before any shard
+        // lock when both are needed.
         websocketpp::server<websocketpp::config::asio> m_server;
         websocketpp::lib::thread m_thread;
         websocketpp::lib::mutex m_lock;
 
         uint16_t m_port;
-        handler_map m_handlers;
+        bool m_isRunning;
+        std::array<HandlerShard, c_HandlerShardCount> m_handlerShards;
+
+        // How long queued commands may wait on a runtime before its clients are
+        // told it is busy, checked periodically from the server thread. Read
+        // without the lock when registering a handler and by the watchdog.
+        std::atomic<uint32_t> m_busyThreshold;
+        websocketpp::server<websocketpp::config::asio>::timer_ptr m_watchdogTimer;
 
         std::string m_serviceName;
         std::string m_serviceDesc;
@@ -29,11 +29,38 @@ namespace JsDebug
         , m_id(id)
         , m_protocolHandler(protocolHandler)
         , m_breakOnNextLine(breakOnNextLine)
+        , m_isReportedBusy(false)
     {
     }
 
     ServiceHandler::~ServiceHandler()
     {
+        // Nobody is left to report to, so stop keeping state for it.
+        EnableBusyStatus(false);
+
+        for (const auto& observer : m_observers)
+        {
+            try
+            {
+                if (!observer->hdl.expired())
+                {
+                    auto connection = m_server->get_con_from_hdl(observer->hdl);
+                    connection->set_message_handler(nullptr);
+                    connection->set_close_handler(nullptr);
+                    connection->close(websocketpp::close::status::going_away, c_MessageServerShutdown);
+                }
+            }
+            catch (...)
+            {
+                // Don't allow the exception to propagate.
+            }
+
+            // Ignore any returned error codes
+            JsErrorCode err = JsDebugProtocolHandlerDisconnectObserver(m_protocolHandler, observer->sessionId);
+            UNREFERENCED_PARAMETER(err);
+            assert(err == JsNoError);
+        }
+
         try
         {
             if (!m_hdl.expired())
@@ -81,17 +108,64 @@ namespace JsDebug
             return true;
         }
 
-        return false;
+        return ConnectObserver(hdl);
     }
 
     void ServiceHandler::Disconnect()
     {
+        for (const auto& observer : m_observers)
+        {
+            if (!observer->hdl.expired())
+            {
+                m_server->close(observer->hdl, websocketpp::close::status::going_away, c_MessageServerShutdown);
+            }
+        }
+
         if (!m_hdl.expired())
         {
             m_server->close(m_hdl, websocketpp::close::status::going_away, c_MessageServerShutdown);
         }
     }
 
+    void ServiceHandler::EnableBusyStatus(bool isEnabled)
+    {
+        // Ignore any returned error codes
+        JsErrorCode err = JsDebugProtocolHandlerEnableBusyStatus(m_protocolHandler, isEnabled);
+        UNREFERENCED_PARAMETER(err);
+        assert(err == JsNoError);
+    }
+
+    void ServiceHandler::CheckBusy(uint64_t thresholdMicroseconds)
+    {
+        if (!m_connected)
+        {
+            m_isReportedBusy = false;
+            return;
+        }
+
+        JsDebugProtocolHandlerStatistics statistics = {};
+        if (JsDebugProtocolHandlerGetStatistics(m_protocolHandler, &statistics) != JsNoError)
+        {
+            return;
+        }
+
+        // Report each busy period once; the commands are answered when the
+        // runtime gets to them.
+        if (statistics.busyMicroseconds < thresholdMicroseconds)
+        {
+            m_isReportedBusy = false;
+        }
+        else if (!m_isReportedBusy)
+        {
+            m_isReportedBusy = true;
+
+            // The protocol handler only builds the status; it is sent from
+            // here so that it never enters the handler's own sending.
+            JsErrorCode err = JsDebugProtocolHandlerGetBusyStatus(m_protocolHandler, &ServiceHandler::SendBusyStatusCallback, this);
+            UNREFERENCED_PARAMETER(err);
+        }
+    }
+
     std::string ServiceHandler::Id()
     {
         return m_id;
@@ -111,6 +185,26 @@ namespace JsDebug
         }
     }
 
+    void ServiceHandler::SendBusyStatusCallback(const char* response, void* callbackState)
+    {
+        // Called on the server thread, which owns the connections.
+        auto serviceHandler = static_cast<ServiceHandler*>(callbackState);
+        std::string status(response);
+
+        if (!serviceHandler->m_hdl.expired())
+        {
+            serviceHandler->m_server->send(serviceHandler->m_hdl, status, websocketpp::frame::opcode::text);
+        }
+
+        for (const auto& observer : serviceHandler->m_observers)
+        {
+            if (!observer->hdl.expired())
+            {
+                serviceHandler->m_server->send(observer->hdl, status, websocketpp::frame::opcode::text);
+            }
+        }
+    }
+
     void ServiceHandler::OnMessage(connection_hdl hdl, server::message_ptr msg)
     {
         // Ignore any returned error codes
@@ -131,4 +225,55 @@ namespace JsDebug
             m_connected = false;
         }
     }
+
+    bool ServiceHandler::ConnectObserver(connection_hdl hdl)
+    {
+        auto observer = std::make_unique<Observer>(Observer { this, hdl, 0 });
+
+        if (JsDebugProtocolHandlerConnectObserver(
+            m_protocolHandler,
+            &ServiceHandler::SendObserverResponseCallback,
+            observer.get(),
+            &observer->sessionId) != JsNoError)
+        {
+            return false;
+        }
+
+        auto connection = m_server->get_con_from_hdl(hdl);
+        connection->set_message_handler(bind(&ServiceHandler::OnObserverMessage, this, observer.get(), _1, _2));
+        connection->set_close_handler(bind(&ServiceHandler::OnObserverClose, this, observer.get(), _1));
+
+        m_observers.push_back(std::move(observer));
+        return true;
+    }
+
+    void ServiceHandler::SendObserverResponseCallback(const char* response, void* callbackState)
+    {
+        auto observer = static_cast<Observer*>(callbackState);
+
+        // The same notification is sent to every observer, but each
+        // connection frames its own copy.
+        if (!observer->hdl.expired())
+        {
+            observer->handler->m_server->send(observer->hdl, std::string(response), websocketpp::frame::opcode::text);
+        }
+    }
+
+    void ServiceHandler::OnObserverMessage(Observer* observer, connection_hdl hdl, server::message_ptr msg)
+    {
+        // Ignore any returned error codes
+        JsErrorCode err = JsDebugProtocolHandlerSendObserverCommand(m_protocolHandler, observer->sessionId, msg->get_payload().c_str());
+        UNREFERENCED_PARAMETER(err);
+        assert(err == JsNoError);
+    }
+
+    void ServiceHandler::OnObserverClose(Observer* observer, connection_hdl hdl)
+    {
+        // Once this returns the handler no longer calls back with the observer.
+        JsErrorCode err = JsDebugProtocolHandlerDisconnectObserver(m_protocolHandler, observer->sessionId);
+        UNREFERENCED_PARAMETER(err);
+        assert(err == JsNoError);
+
+        m_observers.remove_if([observer](const std::unique_ptr<Observer>& item) { return item.get() == observer; });
+    }
 }
@@ -5,6 +5,8 @@
 
 #include <ChakraDebugProtocolHandler.h> 
 
+#include <list>
+
 namespace JsDebug
 {
     class ServiceHandler
@@ -19,22 +21,41 @@ namespace JsDebug
 
         bool Connect(websocketpp::connection_hdl hdl);
         void Disconnect();
+        void EnableBusyStatus(bool isEnabled);
+        void CheckBusy(uint64_t thresholdMicroseconds);
 
         std::string Id();
 
     private:
+        // A connection made while another is active, which can watch but not
+        // control the runtime.
+        struct Observer
+        {
+            ServiceHandler* handler;
+            websocketpp::connection_hdl hdl;
+            unsigned int sessionId;
+        };
+
         static void CHAKRA_CALLBACK SendResponseCallback(const char* response, void* callbackState);
         void SendResponse(const char* response);
+        static void CHAKRA_CALLBACK SendBusyStatusCallback(const char* response, void* callbackState);
 
         void OnMessage(websocketpp::connection_hdl hdl, websocketpp::server<websocketpp::config::asio>::message_ptr msg);
         void OnClose(websocketpp::connection_hdl hdl);
 
+        bool ConnectObserver(websocketpp::connection_hdl hdl);
+        static void CHAKRA_CALLBACK SendObserverResponseCallback(const char* response, void* callbackState);
+        void OnObserverMessage(Observer* observer, websocketpp::connection_hdl hdl, websocketpp::server<websocketpp::config::asio>::message_ptr msg);
+        void OnObserverClose(Observer* observer, websocketpp::connection_hdl hdl);
+
         bool m_connected;
         websocketpp::server<websocketpp::config::asio>* m_server;
         std::string m_id;
         JsDebugProtocolHandler m_protocolHandler;
         bool m_breakOnNextLine;
+        bool m_isReportedBusy;
 
         websocketpp::connection_hdl m_hdl;
+        std::list<std::unique_ptr<Observer>> m_observers;
     };
 }
@@ -8,6 +8,9 @@
 
 #include <ChakraDebugProtocolHandler.h>
 #include <ChakraCore.h>
+#include <JsHandleTable.h>
+
+#include <algorithm>
 
 class JsrtTestFixture
 {
@@ -89,6 +92,83 @@ void ValidateResponses(const std::vector<std::string>& expected, const std::vect
     }
 }
 
+TEST_CASE_METHOD(JsrtTestFixture, "JsHandleTable Release")
+{
+    std::atomic<uint32_t> counter(0);
+    JsDebug::JsHandleTable table(&counter);
+
+    JsValueRef first = JS_INVALID_REFERENCE;
+    JsValueRef second = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateObject(&first) == JsNoError);
+    REQUIRE(JsCreateObject(&second) == JsNoError);
+
+    JsDebug::JsHandleTable::Handle firstHandle = table.Add(first);
+    JsDebug::JsHandleTable::Handle secondHandle = table.Add(second);
+    REQUIRE(table.Get(firstHandle) == first);
+    REQUIRE(table.Get(secondHandle) == second);
+    REQUIRE(table.Size() == 2);
+    REQUIRE(counter == 2);
+
+    table.Remove(firstHandle);
+    REQUIRE(table.Get(firstHandle) == JS_INVALID_REFERENCE);
+    REQUIRE(table.Get(secondHandle) == second);
+    REQUIRE(table.Size() == 1);
+    REQUIRE(counter == 1);
+
+    table.Release();
+    REQUIRE(table.Get(secondHandle) == JS_INVALID_REFERENCE);
+    REQUIRE(table.Size() == 0);
+    REQUIRE(counter == 0);
+}
+
+TEST_CASE_METHOD(JsrtTestFixture, "JsHandleTable Reuse")
+{
+    JsDebug::JsHandleTable table;
+
+    JsValueRef first = JS_INVALID_REFERENCE;
+    JsValueRef second = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateObject(&first) == JsNoError);
+    REQUIRE(JsCreateObject(&second) == JsNoError);
+
+    // A freed slot is used again under a new generation.
+    JsDebug::JsHandleTable::Handle firstHandle = table.Add(first);
+    table.Remove(firstHandle);
+
+    JsDebug::JsHandleTable::Handle secondHandle = table.Add(second);
+    REQUIRE(secondHandle != firstHandle);
+    REQUIRE((secondHandle & 0xFFFFFFFF) == (firstHandle & 0xFFFFFFFF));
+    REQUIRE(table.Get(secondHandle) == second);
+
+    table.Release();
+
+    JsDebug::JsHandleTable::Handle thirdHandle = table.Add(first);
+    REQUIRE(thirdHandle != firstHandle);
+    REQUIRE(thirdHandle != secondHandle);
+    REQUIRE(table.Get(thirdHandle) == first);
+}
+
+TEST_CASE_METHOD(JsrtTestFixture, "JsHandleTable StaleHandles")
+{
+    JsDebug::JsHandleTable table;
+
+    JsValueRef value = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateObject(&value) == JsNoError);
+
+    REQUIRE(table.Add(JS_INVALID_REFERENCE) == JsDebug::JsHandleTable::InvalidHandle);
+    REQUIRE(table.Get(JsDebug::JsHandleTable::InvalidHandle) == JS_INVALID_REFERENCE);
+
+    JsDebug::JsHandleTable::Handle handle = table.Add(value);
+    REQUIRE(table.Get(handle + 1) == JS_INVALID_REFERENCE);
+
+    // Removing a handle twice doesn't touch the value now in its slot.
+    table.Remove(handle);
+    JsDebug::JsHandleTable::Handle reused = table.Add(value);
+    table.Remove(handle);
+    REQUIRE(table.Get(handle) == JS_INVALID_REFERENCE);
+    REQUIRE(table.Get(reused) == value);
+    REQUIRE(table.Size() == 1);
+}
+
 TEST_CASE_METHOD(JsrtTestFixture, "JsDebugProtocolHandler Create")
 {
     CHECK(JsDebugProtocolHandlerCreate(this->GetRuntime(), nullptr) == JsErrorInvalidArgument);
@@ -132,7 +212,7 @@ TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler SendMessage")
         "{\"error\":{\"code\":-32600,\"message\":\"Message must have integer 'id' property\"}}",
         "{\"error\":{\"code\":-32600,\"message\":\"Message must have string 'method' property\"},\"id\":0}",
         "{\"error\":{\"code\":-32601,\"message\":\"'Foo.bar' wasn't found\"},\"id\":1}",
-        "{\"id\":2,\"result\":{\"domains\":[{\"name\":\"Console\",\"version\":\"1.2\"},{\"name\":\"Debugger\",\"version\":\"1.2\"},{\"name\":\"Runtime\",\"version\":\"1.2\"}]}}",
+        "{\"id\":2,\"result\":{\"domains\":[{\"name\":\"Console\",\"version\":\"1.2\"},{\"name\":\"Debugger\",\"version\":\"1.2\"},{\"name\":\"HeapProfiler\",\"version\":\"1.2\"},{\"name\":\"Performance\",\"version\":\"1.2\"},{\"name\":\"Profiler\",\"version\":\"1.2\"},{\"name\":\"Runtime\",\"version\":\"1.2\"},{\"name\":\"Session\",\"version\":\"1.2\"},{\"name\":\"TimeTravel\",\"version\":\"1.2\"}]}}",
         "{\"method\":\"Debugger.scriptParsed\",\"params\":{\"scriptId\":\"1\",\"url\":\"test.js\",\"startLine\":0,\"startColumn\":0,\"endLine\":1,\"endColumn\":0,\"executionContextId\":0,\"hash\":\"\",\"isLiveEdit\":false,\"sourceMapURL\":\"\",\"hasSourceURL\":false}}",
         "{\"id\":3,\"result\":{}}",
         "{\"method\":\"Debugger.scriptParsed\",\"params\":{\"scriptId\":\"1\",\"url\":\"test.js\",\"startLine\":0,\"startColumn\":0,\"endLine\":1,\"endColumn\":0,\"executionContextId\":0,\"hash\":\"\",\"isLiveEdit\":false,\"sourceMapURL\":\"\",\"hasSourceURL\":false}}",
@@ -240,3 +320,1273 @@ TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Connect/Disconnec
     REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
     REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
 }
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler CompileScript/RunScript")
+{
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    auto sendCommand = [this, &actualResponses](const std::string& command)
+    {
+        actualResponses.clear();
+        REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), command.c_str()) == JsNoError);
+        REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+        REQUIRE(!actualResponses.empty());
+        return actualResponses.back();
+    };
+
+    // The id of the script the engine reported in Debugger.scriptParsed.
+    auto getParsedScriptId = [&actualResponses](const std::string& url)
+    {
+        const std::string idKey = "\"scriptId\":\"";
+
+        for (const std::string& response : actualResponses)
+        {
+            if (response.rfind("{\"method\":\"Debugger.scriptParsed\"", 0) == 0 &&
+                response.find("\"url\":\"" + url + "\"") != std::string::npos)
+            {
+                size_t start = response.find(idKey) + idKey.length();
+                return response.substr(start, response.find('"', start) - start);
+            }
+        }
+
+        return std::string();
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(sendCommand("{\"id\":1,\"method\":\"Debugger.enable\"}") == "{\"id\":1,\"result\":{}}");
+
+    REQUIRE(sendCommand("{\"id\":2,\"method\":\"Runtime.compileScript\",\"params\":{\"expression\":\"1 + 2\",\"sourceURL\":\"\",\"persistScript\":false}}") == "{\"id\":2,\"result\":{}}");
+
+    // A persisted script is known by the same id the Debugger domain reports
+    // for it, so the two can't refer to different scripts.
+    std::string compiled = sendCommand("{\"id\":3,\"method\":\"Runtime.compileScript\",\"params\":{\"expression\":\"1 + 2\",\"sourceURL\":\"compiled.js\",\"persistScript\":true}}");
+    std::string scriptId = getParsedScriptId("compiled.js");
+    REQUIRE(!scriptId.empty());
+    REQUIRE(compiled == "{\"id\":3,\"result\":{\"scriptId\":\"" + scriptId + "\"}}");
+
+    REQUIRE(sendCommand("{\"id\":4,\"method\":\"Runtime.runScript\",\"params\":{\"scriptId\":\"compiled-42\"}}") == "{\"error\":{\"code\":-32000,\"message\":\"Invalid script ID\"},\"id\":4}");
+
+    // Releasing the empty group doesn't drop scripts that were never run under one.
+    REQUIRE(sendCommand("{\"id\":5,\"method\":\"Runtime.releaseObjectGroup\",\"params\":{\"objectGroup\":\"\"}}") == "{\"id\":5,\"result\":{}}");
+    REQUIRE(sendCommand("{\"id\":6,\"method\":\"Runtime.runScript\",\"params\":{\"scriptId\":\"" + scriptId + "\",\"objectGroup\":\"console\"}}").rfind("{\"id\":6,\"result\":{\"result\":{\"type\":\"number\",\"value\":3", 0) == 0);
+
+    // Releasing the group it was run under does.
+    REQUIRE(sendCommand("{\"id\":7,\"method\":\"Runtime.releaseObjectGroup\",\"params\":{\"objectGroup\":\"console\"}}") == "{\"id\":7,\"result\":{}}");
+    REQUIRE(sendCommand("{\"id\":8,\"method\":\"Runtime.runScript\",\"params\":{\"scriptId\":\"" + scriptId + "\"}}") == "{\"error\":{\"code\":-32000,\"message\":\"Invalid script ID\"},\"id\":8}");
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Profiler")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Profiler is not enabled\"},\"id\":1}",
+        "{\"id\":2,\"result\":{}}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Sampling interval must be positive\"},\"id\":3}",
+        "{\"id\":4,\"result\":{}}",
+        "{\"error\":{\"code\":-32000,\"message\":\"No recording profiles found\"},\"id\":5}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Hit limit must be positive\"},\"id\":6}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Invalid script ID\"},\"id\":7}",
+        "{\"id\":8,\"result\":{\"lines\":[]}}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Precise coverage has not been started\"},\"id\":9}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Profiler.start\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Profiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Profiler.setSamplingInterval\",\"params\":{\"interval\":0}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"Profiler.setSamplingInterval\",\"params\":{\"interval\":100}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":5,\"method\":\"Profiler.stop\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":6,\"method\":\"Profiler.startHotLines\",\"params\":{\"maxHits\":0}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":7,\"method\":\"Profiler.startHotLines\",\"params\":{\"scriptId\":\"42\"}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":8,\"method\":\"Profiler.getHotLines\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":9,\"method\":\"Profiler.takePreciseCoverage\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Profiler HotLines")
+{
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    // Lines are counted in scripts loaded when counting starts.
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("hot.js",
+        "function hot() {\n"
+        "  var x = 0;\n"
+        "  for (var i = 0; i < 10; ++i) {\n"
+        "    x += i;\n"
+        "  }\n"
+        "  return x;\n"
+        "}", &result) == JsNoError);
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Profiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Profiler.startHotLines\",\"params\":{\"maxHits\":5}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    auto getHotLines = [this, &actualResponses](int id)
+    {
+        std::string command = "{\"id\":" + std::to_string(id) + ",\"method\":\"Profiler.getHotLines\"}";
+        REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), command.c_str()) == JsNoError);
+        REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+        std::string prefix = "{\"id\":" + std::to_string(id) + ",";
+        auto response = std::find_if(actualResponses.begin(), actualResponses.end(), [&prefix](const std::string& item)
+        {
+            return item.rfind(prefix, 0) == 0;
+        });
+
+        REQUIRE(response != actualResponses.end());
+        return *response;
+    };
+
+    // Each line's count, in the order reported.
+    auto getCounts = [](const std::string& response)
+    {
+        std::vector<std::pair<int, int>> counts;
+        const std::string lineKey = "\"lineNumber\":";
+        const std::string hitKey = "\"hitCount\":";
+
+        for (size_t start = response.find(lineKey); start != std::string::npos; start = response.find(lineKey, start + 1))
+        {
+            size_t hit = response.find(hitKey, start);
+            REQUIRE(hit != std::string::npos);
+
+            counts.emplace_back(
+                std::stoi(response.substr(start + lineKey.length())),
+                std::stoi(response.substr(hit + hitKey.length())));
+        }
+
+        return counts;
+    };
+
+    REQUIRE(RunScript("run.js", "hot();", &result) == JsNoError);
+
+    // Most frequently hit first, and the loop body stops counting at the limit
+    // although it ran ten times.
+    auto counts = getCounts(getHotLines(3));
+    REQUIRE(!counts.empty());
+    REQUIRE(std::is_sorted(counts.begin(), counts.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b)
+    {
+        return a.second > b.second;
+    }));
+
+    auto body = std::find_if(counts.begin(), counts.end(), [](const std::pair<int, int>& count) { return count.first == 3; });
+    REQUIRE(body != counts.end());
+    REQUIRE(body->second == 5);
+    REQUIRE(counts.front().second == 5);
+
+    auto entry = std::find_if(counts.begin(), counts.end(), [](const std::pair<int, int>& count) { return count.first == 1; });
+    REQUIRE(entry != counts.end());
+    REQUIRE(entry->second == 1);
+
+    // The body's breakpoint was removed at the limit, so running again only
+    // counts the lines still below it.
+    REQUIRE(RunScript("run.js", "hot();", &result) == JsNoError);
+
+    counts = getCounts(getHotLines(4));
+    body = std::find_if(counts.begin(), counts.end(), [](const std::pair<int, int>& count) { return count.first == 3; });
+    REQUIRE(body != counts.end());
+    REQUIRE(body->second == 5);
+
+    entry = std::find_if(counts.begin(), counts.end(), [](const std::pair<int, int>& count) { return count.first == 1; });
+    REQUIRE(entry != counts.end());
+    REQUIRE(entry->second == 2);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Profiler Coverage")
+{
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    // Neither function body has run when coverage starts.
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("cov.js",
+        "function used() { return 1; }\n"
+        "function unused() { return 2; }\n", &result) == JsNoError);
+
+    const int usedOffset = 18;
+    const int unusedOffset = 50;
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Profiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Profiler.startPreciseCoverage\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    auto takeCoverage = [this, &actualResponses](int id)
+    {
+        std::string command = "{\"id\":" + std::to_string(id) + ",\"method\":\"Profiler.takePreciseCoverage\"}";
+        REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), command.c_str()) == JsNoError);
+        REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+        std::string prefix = "{\"id\":" + std::to_string(id) + ",\"result\":";
+        auto response = std::find_if(actualResponses.begin(), actualResponses.end(), [&prefix](const std::string& item)
+        {
+            return item.rfind(prefix, 0) == 0;
+        });
+
+        REQUIRE(response != actualResponses.end());
+
+        // Only the ranges of the script under test.
+        size_t start = response->find("\"url\":\"cov.js\"");
+        REQUIRE(start != std::string::npos);
+        return response->substr(start, response->find("\"url\":", start + 1) - start);
+    };
+
+    // The count of the range starting at the given offset.
+    auto getCount = [](const std::string& coverage, int offset)
+    {
+        const std::string countKey = "\"count\":";
+
+        size_t start = coverage.find("\"startOffset\":" + std::to_string(offset) + ",");
+        REQUIRE(start != std::string::npos);
+
+        size_t count = coverage.find(countKey, start);
+        REQUIRE(count != std::string::npos);
+        return std::stoi(coverage.substr(count + countKey.length()));
+    };
+
+    REQUIRE(RunScript("run.js", "used();", &result) == JsNoError);
+
+    std::string coverage = takeCoverage(3);
+    REQUIRE(getCount(coverage, usedOffset) == 1);
+    REQUIRE(getCount(coverage, unusedOffset) == 0);
+
+    // Taking coverage re-arms the statements that were hit, so they are only
+    // reported again once run again.
+    coverage = takeCoverage(4);
+    REQUIRE(getCount(coverage, usedOffset) == 0);
+    REQUIRE(getCount(coverage, unusedOffset) == 0);
+
+    REQUIRE(RunScript("run.js", "used(); unused();", &result) == JsNoError);
+
+    coverage = takeCoverage(5);
+    REQUIRE(getCount(coverage, usedOffset) == 1);
+    REQUIRE(getCount(coverage, unusedOffset) == 1);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Profiler Coverage StepOver")
+{
+    struct Session
+    {
+        JsDebugProtocolHandler protocolHandler;
+        std::vector<std::string> responses;
+        std::vector<int> pausedLines;
+    } session { this->GetProtocolHandler() };
+
+    // Every statement not yet run has a coverage breakpoint, which the engine
+    // reports in place of the step. Each step over still stops at the next
+    // line, including over a call whose statements are covered on the way.
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto session = static_cast<Session*>(callbackState);
+        session->responses.emplace_back(response);
+
+        const std::string& last = session->responses.back();
+        if (last.rfind("{\"method\":\"Debugger.paused\"", 0) != 0)
+        {
+            return;
+        }
+
+        const std::string lineKey = "\"lineNumber\":";
+        size_t line = last.find(lineKey, last.find("\"location\":"));
+        session->pausedLines.push_back(line != std::string::npos ? std::stoi(last.substr(line + lineKey.length())) : -1);
+
+        const char* command = session->pausedLines.size() < 3
+            ? "{\"id\":10,\"method\":\"Debugger.stepOver\"}"
+            : "{\"id\":11,\"method\":\"Debugger.resume\"}";
+        JsDebugProtocolHandlerSendCommand(session->protocolHandler, command);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &session) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Profiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Profiler.startPreciseCoverage\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("step.js",
+        "function f() {\n"
+        "  var a = 1;\n"
+        "  return a + 1;\n"
+        "}\n"
+        "debugger;\n"
+        "f();\n"
+        "var c = 3;", &result) == JsNoError);
+
+    REQUIRE(session.pausedLines == std::vector<int>({ 4, 5, 6 }));
+
+    // The stops came from steps, not from breakpoints the client set.
+    for (const std::string& response : session.responses)
+    {
+        if (response.rfind("{\"method\":\"Debugger.paused\"", 0) == 0)
+        {
+            REQUIRE(response.find("\"hitBreakpoints\":[]") != std::string::npos);
+        }
+    }
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Profiler Samples")
+{
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Profiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Profiler.setSamplingInterval\",\"params\":{\"interval\":100}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Profiler.start\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    // Keep the script busy long enough for the sampler to break in many
+    // times, almost always inside the same function.
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("hot.js",
+        "function hot() { var x = 0; for (var i = 0; i < 1000; ++i) { x += i; } return x; }\n"
+        "var end = Date.now() + 50;\n"
+        "while (Date.now() < end) { hot(); }", &result) == JsNoError);
+
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"Profiler.stop\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    auto profile = std::find_if(actualResponses.begin(), actualResponses.end(), [](const std::string& response)
+    {
+        return response.rfind("{\"id\":4,", 0) == 0;
+    });
+
+    REQUIRE(profile != actualResponses.end());
+
+    // The first node is the root, and the hot function appears once however
+    // many times it was sampled.
+    REQUIRE(profile->rfind("{\"id\":4,\"result\":{\"profile\":{\"nodes\":[{\"id\":1,\"callFrame\":{\"functionName\":\"(root)\"", 0) == 0);
+
+    size_t hot = profile->find("\"functionName\":\"hot\"");
+    REQUIRE(hot != std::string::npos);
+    REQUIRE(profile->find("\"functionName\":\"hot\"", hot + 1) == std::string::npos);
+
+    // Every sample has a time delta.
+    auto countItems = [&profile](const std::string& name)
+    {
+        size_t start = profile->find(name);
+        REQUIRE(start != std::string::npos);
+
+        start += name.length();
+        std::string items = profile->substr(start, profile->find(']', start) - start);
+        return items.empty() ? 0 : std::count(items.begin(), items.end(), ',') + 1;
+    };
+
+    auto sampleCount = countItems("\"samples\":[");
+    REQUIRE(sampleCount > 0);
+    REQUIRE(sampleCount == countItems("\"timeDeltas\":["));
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler HeapProfiler Sampling")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Sampling heap profiler is not started\"},\"id\":1}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Sampling interval must be positive\"},\"id\":2}",
+        "{\"id\":3,\"result\":{}}",
+        "{\"id\":4,\"result\":{}}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Sampling heap profiler is not started\"},\"id\":5}",
+        "{\"error\":{\"code\":-32000,\"message\":\"No script is running or paused to take a snapshot of\"},\"id\":6}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"HeapProfiler.getSamplingProfile\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"HeapProfiler.startSampling\",\"params\":{\"samplingInterval\":0}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"HeapProfiler.startSampling\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"HeapProfiler.disable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":5,\"method\":\"HeapProfiler.stopSampling\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":6,\"method\":\"HeapProfiler.takeHeapSnapshot\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler HeapProfiler TakeHeapSnapshot")
+{
+    struct Session
+    {
+        JsDebugProtocolHandler protocolHandler;
+        std::vector<std::string> responses;
+        std::string snapshot;
+    } session { this->GetProtocolHandler() };
+
+    // The snapshot is taken at the pause, then the script resumes once the
+    // response for it arrives.
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto session = static_cast<Session*>(callbackState);
+        session->responses.emplace_back(response);
+
+        const std::string& last = session->responses.back();
+        const std::string chunkPrefix = "{\"method\":\"HeapProfiler.addHeapSnapshotChunk\",\"params\":{\"chunk\":\"";
+
+        if (last.rfind(chunkPrefix, 0) == 0)
+        {
+            // Undo the string escaping of the chunk, the snapshot itself only
+            // escapes quotes, backslashes and line breaks.
+            size_t end = last.rfind("\"}}");
+            REQUIRE(end != std::string::npos);
+
+            for (size_t index = chunkPrefix.length(); index < end; ++index)
+            {
+                char ch = last[index];
+                if (ch == '\\')
+                {
+                    ch = last[++index];
+                    if (ch == 'n')
+                    {
+                        ch = '\n';
+                    }
+                    else if (ch == 'u')
+                    {
+                        ch = '?';
+                        index += 4;
+                    }
+                }
+
+                session->snapshot.push_back(ch);
+            }
+        }
+        else if (last.rfind("{\"method\":\"Debugger.paused\"", 0) == 0)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":3,\"method\":\"HeapProfiler.takeHeapSnapshot\"}");
+        }
+        else if (last.rfind("{\"id\":3,", 0) == 0 || last.find("\"id\":3}") != std::string::npos)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":4,\"method\":\"Debugger.resume\"}");
+        }
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &session) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"HeapProfiler.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("heap.js",
+        "var retained = { name: 'retained', items: [1, 2, 3] };\n"
+        "debugger;\n", &result) == JsNoError);
+
+    REQUIRE(std::find(session.responses.begin(), session.responses.end(), "{\"id\":3,\"result\":{}}") != session.responses.end());
+
+    // The joined chunks are one .heapsnapshot document.
+    const std::string& snapshot = session.snapshot;
+    REQUIRE(snapshot.rfind("{\"snapshot\":{\"meta\":{", 0) == 0);
+    REQUIRE(snapshot.length() > 2);
+    REQUIRE(snapshot.compare(snapshot.length() - 2, 2, "]}") == 0);
+
+    const std::string nodeCountKey = "\"node_count\":";
+    size_t nodeCount = snapshot.find(nodeCountKey);
+    REQUIRE(nodeCount != std::string::npos);
+    const int nodeCountValue = std::stoi(snapshot.substr(nodeCount + nodeCountKey.length()));
+    REQUIRE(nodeCountValue > 0);
+
+    // Each node is one line of six fields in the nodes array.
+    size_t nodes = snapshot.find("\"nodes\":[");
+    REQUIRE(nodes != std::string::npos);
+    size_t nodesEnd = snapshot.find(']', nodes);
+    REQUIRE(nodesEnd != std::string::npos);
+    REQUIRE(std::count(snapshot.begin() + nodes, snapshot.begin() + nodesEnd, ',') + 1 == nodeCountValue * 6);
+
+    REQUIRE(snapshot.find("\"edges\":[") != std::string::npos);
+    REQUIRE(snapshot.find("\"strings\":[") != std::string::npos);
+    REQUIRE(snapshot.find("\"retained\"") != std::string::npos);
+
+    // With the script finished, nothing remains to be paused.
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":5,\"method\":\"HeapProfiler.takeHeapSnapshot\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(session.responses.back() == "{\"error\":{\"code\":-32000,\"message\":\"No script is running or paused to take a snapshot of\"},\"id\":5}");
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Performance")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Performance is not enabled\"},\"id\":1}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Sampling interval must be positive\"},\"id\":2}",
+        "{\"id\":3,\"result\":{}}",
+        "{\"id\":4,\"result\":{}}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Performance.getMetrics\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Performance.enable\",\"params\":{\"samplingInterval\":0}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Performance.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"Performance.disable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler RuntimeMemoryCallbacks")
+{
+    struct Counts
+    {
+        size_t allocations;
+        size_t collections;
+    } counts { 0, 0 };
+
+    auto allocationCallback = [](void* callbackState, JsMemoryEventType allocationEvent, size_t /*allocationSize*/) -> bool
+    {
+        if (allocationEvent == JsMemoryAllocate)
+        {
+            static_cast<Counts*>(callbackState)->allocations++;
+        }
+
+        return true;
+    };
+
+    auto beforeCollectCallback = [](void* callbackState)
+    {
+        static_cast<Counts*>(callbackState)->collections++;
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    // The host's callbacks are called whether or not the handler is using
+    // the runtime's slots, and are back in them once it stops.
+    auto allocate = [this, &counts]()
+    {
+        counts = Counts { 0, 0 };
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(RunScript("allocate.js", "var a = []; for (var i = 0; i < 100000; ++i) { a.push({ i: i }); }", &result) == JsNoError);
+        REQUIRE(JsCollectGarbage(this->GetRuntime()) == JsNoError);
+
+        REQUIRE(counts.allocations > 0);
+        REQUIRE(counts.collections > 0);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerSetRuntimeMemoryCallbacks(this->GetProtocolHandler(), allocationCallback, beforeCollectCallback, &counts) == JsNoError);
+    allocate();
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Performance.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+    allocate();
+
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Performance.disable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+    allocate();
+
+    REQUIRE(JsDebugProtocolHandlerSetRuntimeMemoryCallbacks(this->GetProtocolHandler(), nullptr, nullptr, nullptr) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler TimeTravel")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"A log location must be specified\"},\"id\":1}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Can only perform operation while paused\"},\"id\":2}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Can only perform operation while paused\"},\"id\":3}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Cannot write the log while script is running; pause first\"},\"id\":4}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"TimeTravel.writeTTDLog\",\"params\":{\"uri\":\"\"}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"TimeTravel.stepBack\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"TimeTravel.reverse\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    // A command that arrives while script runs is answered at the next
+    // statement rather than held until a pause that may never come.
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"TimeTravel.writeTTDLog\",\"params\":{\"uri\":\"log\"}}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var i = 0;", &result) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+namespace
+{
+    size_t s_timeTravelBytesWritten = 0;
+    int s_timeTravelStream = 0;
+
+    JsTTDStreamHandle CHAKRA_CALLBACK OpenTimeTravelStream(size_t, const char*, size_t, const char*, bool read, bool write)
+    {
+        return (!read && write) ? &s_timeTravelStream : nullptr;
+    }
+
+    bool CHAKRA_CALLBACK WriteTimeTravelBytes(JsTTDStreamHandle, const byte*, size_t size, size_t* bytesWritten)
+    {
+        s_timeTravelBytesWritten += size;
+        *bytesWritten = size;
+        return true;
+    }
+
+    void CHAKRA_CALLBACK FlushAndCloseTimeTravelStream(JsTTDStreamHandle, bool, bool)
+    {
+    }
+}
+
+TEST_CASE("JsDebugProtocolHandler TimeTravel WriteLog")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"id\":1,\"result\":{}}",
+    };
+
+    JsRuntimeHandle runtime = nullptr;
+    REQUIRE(JsTTDCreateRecordRuntime(
+        JsRuntimeAttributeNone,
+        true,
+        1000,
+        2,
+        &OpenTimeTravelStream,
+        &WriteTimeTravelBytes,
+        &FlushAndCloseTimeTravelStream,
+        nullptr,
+        &runtime) == JsNoError);
+
+    JsContextRef context = JS_INVALID_REFERENCE;
+    REQUIRE(JsTTDCreateContext(runtime, true, &context) == JsNoError);
+    REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+    JsDebugProtocolHandler protocolHandler = nullptr;
+    REQUIRE(JsDebugProtocolHandlerCreate(runtime, &protocolHandler) == JsNoError);
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(protocolHandler, false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsTTDStart() == JsNoError);
+
+    std::string script("var i = 0;");
+    JsValueRef scriptValue = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateString(script.c_str(), script.length(), &scriptValue) == JsNoError);
+
+    JsValueRef scriptName = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateString("test.js", 7, &scriptName) == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(JsRun(scriptValue, 0, scriptName, JsParseScriptAttributeNone, &result) == JsNoError);
+
+    // Between scripts the log is consistent, so it is written straight away.
+    s_timeTravelBytesWritten = 0;
+    REQUIRE(JsDebugProtocolHandlerSendCommand(protocolHandler, "{\"id\":1,\"method\":\"TimeTravel.writeTTDLog\",\"params\":{\"uri\":\"log\"}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(protocolHandler) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+    REQUIRE(s_timeTravelBytesWritten > 0);
+
+    REQUIRE(JsTTDStop() == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerDisconnect(protocolHandler) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerDestroy(protocolHandler) == JsNoError);
+    REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+    REQUIRE(JsDisposeRuntime(runtime) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler AsyncTasks")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Depth must be non-negative\"},\"id\":1}",
+        "{\"id\":2,\"result\":{}}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.setAsyncCallStackDepth\",\"params\":{\"maxDepth\":-1}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Debugger.setAsyncCallStackDepth\",\"params\":{\"maxDepth\":8}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    JsValueRef task = JS_INVALID_REFERENCE;
+    REQUIRE(RunScript("asyncTask.js", "(function task() {})", &task) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerAsyncTaskScheduled(this->GetProtocolHandler(), task) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerAsyncTaskStarted(this->GetProtocolHandler(), task) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerAsyncTaskFinished(this->GetProtocolHandler(), task) == JsNoError);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler ConsoleAPIEvent")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"method\":\"Runtime.executionContextCreated\",\"params\":{\"context\":{\"id\":1,\"origin\":\"default\",\"name\":\"default\"}}}",
+        "{\"id\":1,\"result\":{}}",
+        "{\"method\":\"Runtime.consoleAPICalled\",\"params\":{\"type\":\"count\",\"args\":[{\"type\":\"string\",\"value\":\"a: 3\"}],\"executionContextId\":0,\"timestamp\":0}}",
+        "{\"method\":\"Runtime.consoleAPICalled\",\"params\":{\"type\":\"log\",\"args\":[{\"type\":\"string\",\"value\":\"a\"},{\"type\":\"number\",\"value\":1.5,\"description\":\"1.5\"}],\"executionContextId\":0,\"timestamp\":0}}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Runtime.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    JsValueRef args[2] = { JS_INVALID_REFERENCE, JS_INVALID_REFERENCE };
+    REQUIRE(JsCreateString("a", 1, &args[0]) == JsNoError);
+    REQUIRE(JsDoubleToNumber(1.5, &args[1]) == JsNoError);
+
+    // Repeated counts are aggregated, and messages are buffered until the queue is processed.
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(JsDebugConsoleAPIEvent(this->GetProtocolHandler(), "count", args, 1) == JsNoError);
+    }
+
+    REQUIRE(JsDebugConsoleAPIEvent(this->GetProtocolHandler(), "log", args, 2) == JsNoError);
+    REQUIRE(actualResponses.size() == 2);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler ConsoleAPIEvent CounterLimit")
+{
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Runtime.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    JsDebugProtocolHandlerStatistics statistics = {};
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    uint64_t retainedBytes = statistics.retainedBytes;
+
+    // Every label is a new counter, until the cap is reached.
+    for (int i = 0; i <= 1000; ++i)
+    {
+        std::string label = "c" + std::to_string(i);
+        JsValueRef arg = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(label.c_str(), label.length(), &arg) == JsNoError);
+        REQUIRE(JsDebugConsoleAPIEvent(this->GetProtocolHandler(), "count", &arg, 1) == JsNoError);
+    }
+
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    auto hasResponse = [&actualResponses](const std::string& text)
+    {
+        return std::any_of(actualResponses.begin(), actualResponses.end(), [&text](const std::string& response)
+        {
+            return response.find(text) != std::string::npos;
+        });
+    };
+
+    REQUIRE(hasResponse("\"value\":\"c999: 1\""));
+    REQUIRE_FALSE(hasResponse("\"value\":\"c1000: 1\""));
+    REQUIRE(hasResponse("\"type\":\"warning\",\"args\":[{\"type\":\"string\",\"value\":\"Too many counters; 'c1000' is not counted\"}]"));
+
+    // The labels are held on behalf of the session until it reconnects.
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.retainedBytes > retainedBytes);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Session EventMask")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Event cannot be masked: Debugger.paused\"},\"id\":1}",
+        "{\"id\":2,\"result\":{}}",
+        "{\"method\":\"Runtime.executionContextCreated\",\"params\":{\"context\":{\"id\":1,\"origin\":\"default\",\"name\":\"default\"}}}",
+        "{\"id\":3,\"result\":{}}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Session.setEventMask\",\"params\":{\"events\":[\"Debugger.paused\"]}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Session.setEventMask\",\"params\":{\"events\":[\"Debugger.breakpointResolved\"]}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Runtime.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    // Masked console calls are not sent.
+    JsValueRef arg = JS_INVALID_REFERENCE;
+    REQUIRE(JsCreateString("a", 1, &arg) == JsNoError);
+    REQUIRE(JsDebugConsoleAPIEvent(this->GetProtocolHandler(), "log", &arg, 1) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Observers")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"method\":\"Runtime.executionContextCreated\",\"params\":{\"context\":{\"id\":1,\"origin\":\"default\",\"name\":\"default\"}}}",
+        "{\"id\":1,\"result\":{}}",
+    };
+
+    std::vector<std::string> expectedObserverResponses
+    {
+        "{\"error\":{\"code\":-32000,\"message\":\"Observers can only inspect state\"},\"id\":1}",
+        "{\"method\":\"Runtime.executionContextCreated\",\"params\":{\"context\":{\"id\":1,\"origin\":\"default\",\"name\":\"default\"}}}",
+    };
+
+    std::vector<std::string> actualResponses;
+    std::vector<std::string> actualObserverResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    unsigned int sessionId = 0;
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerConnectObserver(this->GetProtocolHandler(), callback, &actualObserverResponses, &sessionId) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendObserverCommand(this->GetProtocolHandler(), sessionId, "{\"id\":1,\"method\":\"Runtime.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Runtime.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+    ValidateResponses(expectedObserverResponses, actualObserverResponses);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnectObserver(this->GetProtocolHandler(), sessionId) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerDisconnectObserver(this->GetProtocolHandler(), sessionId) == JsErrorInvalidArgument);
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler Statistics")
+{
+    const char command[] = "{\"id\":1,\"method\":\"Debugger.enable\"}";
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    JsDebugProtocolHandlerStatistics statistics = {};
+
+    // Parameter validation
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(nullptr, &statistics) == JsErrorInvalidArgument);
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), nullptr) == JsErrorInvalidArgument);
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), command) == JsNoError);
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.queuedCommands > 0);
+    REQUIRE(statistics.isBreakPending);
+    REQUIRE(statistics.bytesReceived == strlen(command));
+    REQUIRE(statistics.bytesSent == 0);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var i = 0;", &result) == JsNoError);
+
+    uint64_t bytesSent = 0;
+    for (const std::string& response : actualResponses)
+    {
+        bytesSent += response.size();
+    }
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.queuedCommands == 0);
+    REQUIRE_FALSE(statistics.isBreakPending);
+    REQUIRE_FALSE(statistics.isPaused);
+    REQUIRE(statistics.scriptCount == 1);
+    REQUIRE(statistics.breakpointCount == 0);
+    REQUIRE(statistics.bytesSent == bytesSent);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.scriptCount == 0);
+    REQUIRE(statistics.retainedValueCount == 0);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler MemoryBudget")
+{
+    std::vector<std::string> expectedResponses
+    {
+        "{\"id\":1,\"result\":{}}",
+        "{\"method\":\"Debugger.scriptParsed\",\"params\":{\"scriptId\":\"1\",\"url\":\"test.js\",\"startLine\":0,\"startColumn\":0,\"endLine\":1,\"endColumn\":0,\"executionContextId\":0,\"hash\":\"\",\"isLiveEdit\":false,\"sourceMapURL\":\"\",\"hasSourceURL\":false}}",
+        "{\"id\":2,\"result\":{\"scriptSource\":\"var i = 0;\"}}",
+        "{\"id\":3,\"result\":{\"scriptId\":\"1\"}}",
+        "{\"method\":\"Inspector.detached\",\"params\":{\"reason\":\"Debugging session exceeded its memory budget\"}}",
+        "{\"error\":{\"code\":-32000,\"message\":\"Debugging session was closed\"},\"id\":4}",
+    };
+
+    std::vector<std::string> actualResponses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    // Parameter validation
+    REQUIRE(JsDebugProtocolHandlerSetMemoryBudget(nullptr, 1) == JsErrorInvalidArgument);
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var i = 0;", &result) == JsNoError);
+
+    JsDebugProtocolHandlerStatistics statistics = {};
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.retainedBytes > 0);
+
+    // Evicting the script source is enough, and the session carries on.
+    REQUIRE(JsDebugProtocolHandlerSetMemoryBudget(this->GetProtocolHandler(), 1) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.retainedBytes == 0);
+
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Debugger.getScriptSource\",\"params\":{\"scriptId\":\"1\"}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    // A persisted script can't be given up, so the session is detached.
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":3,\"method\":\"Runtime.compileScript\",\"params\":{\"expression\":\"i + 1\",\"sourceURL\":\"\",\"persistScript\":true}}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":4,\"method\":\"Debugger.enable\"}") == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+
+    ValidateResponses(expectedResponses, actualResponses);
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.retainedBytes == 0);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler GetBusyStatus")
+{
+    const char busyPrefix[] = "{\"method\":\"Session.targetBusy\",\"params\":{\"busyTime\":";
+
+    std::vector<std::string> actualResponses;
+    std::vector<std::string> busyStatuses;
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto responses = static_cast<std::vector<std::string>*>(callbackState);
+        responses->emplace_back(response);
+    };
+
+    // Parameter validation
+    REQUIRE(JsDebugProtocolHandlerEnableBusyStatus(nullptr, true) == JsErrorInvalidArgument);
+    REQUIRE(JsDebugProtocolHandlerGetBusyStatus(nullptr, callback, &busyStatuses) == JsErrorInvalidArgument);
+    REQUIRE(JsDebugProtocolHandlerGetBusyStatus(this->GetProtocolHandler(), nullptr, nullptr) == JsErrorInvalidArgument);
+
+    REQUIRE(JsDebugProtocolHandlerEnableBusyStatus(this->GetProtocolHandler(), true) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &actualResponses) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var i = 0;", &result) == JsNoError);
+    REQUIRE(actualResponses.size() == 2);
+
+    // Nothing is waiting, so there is nothing to report.
+    REQUIRE(JsDebugProtocolHandlerGetBusyStatus(this->GetProtocolHandler(), callback, &busyStatuses) == JsNoError);
+    REQUIRE(busyStatuses.empty());
+
+    // A command the script thread hasn't taken makes the runtime busy, and the
+    // status carries the script already reported. It goes to the caller only,
+    // not to the session.
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":2,\"method\":\"Runtime.enable\"}") == JsNoError);
+
+    JsDebugProtocolHandlerStatistics statistics = {};
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.queuedCommands == 1);
+    uint64_t bytesSent = statistics.bytesSent;
+    uint64_t retainedBytes = statistics.retainedBytes;
+
+    REQUIRE(JsDebugProtocolHandlerGetBusyStatus(this->GetProtocolHandler(), callback, &busyStatuses) == JsNoError);
+    REQUIRE(busyStatuses.size() == 1);
+    REQUIRE(busyStatuses[0].compare(0, strlen(busyPrefix), busyPrefix) == 0);
+    REQUIRE(busyStatuses[0].find("\"queuedCommands\":1") != std::string::npos);
+    REQUIRE(busyStatuses[0].find(actualResponses[1]) != std::string::npos);
+    REQUIRE(actualResponses.size() == 2);
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.bytesSent == bytesSent);
+
+    // The kept notifications are charged to the budget until disabled, after
+    // which the status carries only the wait.
+    REQUIRE(JsDebugProtocolHandlerEnableBusyStatus(this->GetProtocolHandler(), false) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.retainedBytes + actualResponses[1].size() <= retainedBytes);
+
+    REQUIRE(JsDebugProtocolHandlerGetBusyStatus(this->GetProtocolHandler(), callback, &busyStatuses) == JsNoError);
+    REQUIRE(busyStatuses.size() == 2);
+    REQUIRE(busyStatuses[1].find("\"events\":[]") != std::string::npos);
+
+    // The queued command is still answered once the script thread gets to it.
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(actualResponses.size() > 2);
+    REQUIRE(actualResponses.back() == "{\"id\":2,\"result\":{}}");
+
+    REQUIRE(JsDebugProtocolHandlerGetStatistics(this->GetProtocolHandler(), &statistics) == JsNoError);
+    REQUIRE(statistics.busyMicroseconds == 0);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler EvaluateBatchOnCallFrame")
+{
+    struct Session
+    {
+        JsDebugProtocolHandler protocolHandler;
+        std::vector<std::string> responses;
+    } session { this->GetProtocolHandler() };
+
+    // The watches are evaluated while the script is stopped at its debugger
+    // statement. Resuming would jump ahead of them in the queue, so it waits
+    // for the last one to be answered.
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto session = static_cast<Session*>(callbackState);
+        session->responses.emplace_back(response);
+
+        if (session->responses.back().rfind("{\"method\":\"Debugger.paused\"", 0) == 0)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":2,\"method\":\"Debugger.evaluateBatchOnCallFrame\",\"params\":{\"callFrameId\":\"{\\\"ordinal\\\":0}\",\"expressions\":[\"a + 1\",\"missing\",\"'x'\"]}}");
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":3,\"method\":\"Debugger.evaluateBatchOnCallFrame\",\"params\":{\"callFrameId\":\"{\\\"ordinal\\\":0}\",\"expressions\":[\"a\"],\"objectGroup\":\"watch\"}}");
+        }
+        else if (session->responses.back().rfind("{\"id\":3,", 0) == 0 || session->responses.back().find("\"id\":3}") != std::string::npos)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":4,\"method\":\"Debugger.resume\"}");
+        }
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &session) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var a = 1;\ndebugger;", &result) == JsNoError);
+
+    auto findResponse = [&session](const std::string& prefix)
+    {
+        return std::find_if(session.responses.begin(), session.responses.end(),
+            [&prefix](const std::string& response) { return response.rfind(prefix, 0) == 0; });
+    };
+
+    // One response for the whole batch, with each expression's outcome in order.
+    auto batch = findResponse("{\"id\":2,");
+    REQUIRE(batch != session.responses.end());
+    REQUIRE(batch->rfind("{\"id\":2,\"result\":{\"results\":[{\"result\":{\"type\":\"number\",\"value\":2,", 0) == 0);
+    REQUIRE(batch->find("\"exceptionDetails\"") != std::string::npos);
+    REQUIRE(batch->find("\"value\":\"x\"") != std::string::npos);
+
+    // The object group is accepted and ignored, as for evaluateOnCallFrame.
+    auto grouped = findResponse("{\"id\":3,");
+    REQUIRE(grouped != session.responses.end());
+    REQUIRE(grouped->rfind("{\"id\":3,\"result\":{\"results\":[{\"result\":{\"type\":\"number\",\"value\":1,", 0) == 0);
+    REQUIRE(findResponse("{\"error\":") == session.responses.end());
+
+    REQUIRE(findResponse("{\"id\":4,\"result\":{}}") != session.responses.end());
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler StaleRequest")
+{
+    struct Session
+    {
+        JsDebugProtocolHandler protocolHandler;
+        std::vector<std::string> responses;
+    } session { this->GetProtocolHandler() };
+
+    // The resume jumps ahead of the property request, which then refers to a
+    // pause that is over. The evaluation only quotes the envelope fields in a
+    // string, so it is neither a control command nor stale.
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto session = static_cast<Session*>(callbackState);
+        session->responses.emplace_back(response);
+
+        if (session->responses.back().rfind("{\"method\":\"Debugger.paused\"", 0) == 0)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":2,\"method\":\"Runtime.getProperties\",\"params\":{\"objectId\":\"{\\\"handle\\\":1}\"}}");
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":3,\"method\":\"Debugger.resume\"}");
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":4,\"params\":{\"expression\":\"'\\\"method\\\":\\\"Debugger.pause\\\",\\\"callFrameId\\\"'\"},\"method\":\"Runtime.evaluate\"}");
+        }
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &session) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var a = { b: 1 };\ndebugger;", &result) == JsNoError);
+
+    auto findResponse = [&session](const std::string& text)
+    {
+        return std::find_if(session.responses.begin(), session.responses.end(),
+            [&text](const std::string& response) { return response.find(text) != std::string::npos; });
+    };
+
+    auto resumed = findResponse("{\"id\":3,\"result\":{}}");
+    auto stale = findResponse("\"id\":2}");
+    auto evaluated = findResponse("{\"id\":4,\"result\":");
+
+    REQUIRE(resumed != session.responses.end());
+    REQUIRE(stale != session.responses.end());
+    REQUIRE(evaluated != session.responses.end());
+
+    REQUIRE(resumed < stale);
+    REQUIRE(*stale == "{\"error\":{\"code\":-32000,\"message\":\"Request refers to a previous pause and was cancelled\"},\"id\":2}");
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}
+
+TEST_CASE_METHOD(JsrtDebugTestFixture, "JsDebugProtocolHandler NestedDebugEvent")
+{
+    struct Session
+    {
+        JsDebugProtocolHandler protocolHandler;
+        std::vector<std::string> responses;
+    } session { this->GetProtocolHandler() };
+
+    // Compiling a script during the pause raises a debug event of its own,
+    // which must not end the pause the evaluation that follows refers to.
+    auto callback = [](const char* response, void* callbackState)
+    {
+        auto session = static_cast<Session*>(callbackState);
+        session->responses.emplace_back(response);
+
+        if (session->responses.back().rfind("{\"method\":\"Debugger.paused\"", 0) == 0)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":2,\"method\":\"Runtime.compileScript\",\"params\":{\"expression\":\"1 + 2\",\"sourceURL\":\"nested.js\",\"persistScript\":false}}");
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":3,\"method\":\"Debugger.evaluateOnCallFrame\",\"params\":{\"callFrameId\":\"{\\\"ordinal\\\":0}\",\"expression\":\"a.b\"}}");
+        }
+        else if (session->responses.back().rfind("{\"id\":3,", 0) == 0 || session->responses.back().find("\"id\":3}") != std::string::npos)
+        {
+            JsDebugProtocolHandlerSendCommand(session->protocolHandler, "{\"id\":4,\"method\":\"Debugger.resume\"}");
+        }
+    };
+
+    REQUIRE(JsDebugProtocolHandlerConnect(this->GetProtocolHandler(), false, callback, &session) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerSendCommand(this->GetProtocolHandler(), "{\"id\":1,\"method\":\"Debugger.enable\"}") == JsNoError);
+
+    JsValueRef result = JS_INVALID_REFERENCE;
+    REQUIRE(this->RunScript("test.js", "var a = { b: 1 };\ndebugger;", &result) == JsNoError);
+
+    auto evaluated = std::find_if(session.responses.begin(), session.responses.end(),
+        [](const std::string& response) { return response.rfind("{\"id\":3,", 0) == 0; });
+
+    // Had the nested event ended the pause, this would be the stale error.
+    REQUIRE(evaluated != session.responses.end());
+    REQUIRE(evaluated->rfind("{\"id\":3,\"result\":{\"result\":{\"type\":\"number\",\"value\":1,", 0) == 0);
+
+    REQUIRE(JsDebugProtocolHandlerDisconnect(this->GetProtocolHandler()) == JsNoError);
+    REQUIRE(JsDebugProtocolHandlerProcessCommandQueue(this->GetProtocolHandler()) == JsNoError);
+}